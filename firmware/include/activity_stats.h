@@ -6,6 +6,7 @@
 // Buffer sizes
 #define MOTION_WAKE_MAX_COUNT     100
 #define BACKPACK_SESSION_MAX_COUNT 20
+#define DISPLAY_REFRESH_DAY_COUNT  7
 
 // Wake reasons
 enum WakeReason : uint8_t {
@@ -51,7 +52,15 @@ struct __attribute__((packed)) BackpackSession {
     uint8_t  flags;            // Reserved for future use
 };
 
-// RTC memory buffer structure (~1,060 bytes)
+// E-paper refreshes for one local day (10 bytes)
+struct __attribute__((packed)) DisplayRefreshDay {
+    uint32_t day_start;          // Local Unix time of midnight
+    uint16_t full_refreshes;     // Full (flashing) refreshes, any screen
+    uint16_t partial_refreshes;  // Main-screen partial refreshes
+    uint16_t deferred;           // Changes held back by the refresh governor
+};
+
+// RTC memory buffer structure (~1,130 bytes)
 struct __attribute__((packed)) ActivityBuffer {
     uint32_t magic;            // 0x41435456 ("ACTV") for validation
 
@@ -69,6 +78,11 @@ struct __attribute__((packed)) ActivityBuffer {
     uint32_t current_session_start;      // 0 if not in backpack mode
     uint16_t current_timer_wake_count;   // Accumulates during backpack mode
     uint16_t _reserved;
+
+    // Display refreshes per day circular buffer (newest at display_day_index - 1)
+    uint8_t  display_day_index;
+    uint8_t  display_day_count;
+    DisplayRefreshDay display_days[DISPLAY_REFRESH_DAY_COUNT];  // 70 bytes
 };
 
 // Current wake session tracking (RAM only, not in RTC)
@@ -101,6 +115,9 @@ void activityStatsRecordExtendedSleep();
 // Record a timer wake during backpack mode (just increments counter)
 void activityStatsRecordTimerWake();
 
+// Add timer wakes handled by the deep-sleep wake stub (no boot, counted in RTC)
+void activityStatsAddTimerWakes(uint16_t count);
+
 // Finalize backpack session when exiting backpack mode
 void activityStatsFinalizeBackpackSession(BackpackExitReason reason);
 
@@ -110,6 +127,15 @@ uint8_t activityStatsGetMotionEvents(MotionWakeEvent* buffer, uint8_t max_count)
 // Get backpack sessions (returns count, fills buffer up to max_count)
 uint8_t activityStatsGetBackpackSessions(BackpackSession* buffer, uint8_t max_count);
 
+// Count an e-paper refresh that reached the panel (any task)
+void activityStatsRecordDisplayRefresh(bool partial);
+
+// Count a display change held back by the refresh governor
+void activityStatsRecordDisplayDeferred();
+
+// Get per-day display refresh counts (returns count, oldest first)
+uint8_t activityStatsGetDisplayDays(DisplayRefreshDay* buffer, uint8_t max_count);
+
 // Get counts
 uint8_t activityStatsGetMotionEventCount();
 uint8_t activityStatsGetBackpackSessionCount();
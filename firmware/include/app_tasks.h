@@ -0,0 +1,81 @@
+// app_tasks.h - FreeRTOS task layout (sensor acquisition, storage writer)
+// Part of the Aquavate smart water bottle firmware
+//
+// Task map (see "Task Layout" in config.h):
+//   sensor   - core 1, SENSOR_TASK_PRIORITY: samples NAU7802 + ADXL343 every
+//              SENSOR_TASK_INTERVAL_MS via sensor_sampler, publishes the latest
+//              sample and posts it to a depth-1 mailbox for the logic task
+//   loopTask - core 1, priority 1 (Arduino loop): detection/logic, display and
+//              serial commands; paced by the sensor mailbox instead of delay()
+//   storage  - core 0, STORAGE_TASK_PRIORITY: runs deferred flash writes queued
+//              by other modules (bounded queue) so the logic path never waits
+//              on a LittleFS block write
+//   display  - core 0, DISPLAY_TASK_PRIORITY: main-screen render + e-paper
+//              refresh posted by the loop (display.cpp)
+//   i2c_bus  - bus worker (i2c_bus.h), NimBLE host - BLE (ble_service.cpp)
+//
+// Sensing outranks everything on core 1, and the multi-second e-paper refresh
+// runs on the display task, so neither sampling nor the loop stalls on it.
+
+#ifndef APP_TASKS_H
+#define APP_TASKS_H
+
+#include <Arduino.h>
+#include "sensor_sampler.h"
+
+// One sample as published by the sensor task
+struct PublishedSample {
+    SensorSample sample;
+    uint32_t timestamp;     // millis() when the sample completed
+    uint32_t sequence;      // Increments per published sample
+};
+
+// Deferred storage job (runs on the storage task)
+typedef void (*StorageJobFn)(void* arg);
+
+// Start the sensor and storage tasks. Call after sensorSamplerInit().
+// Returns false if a task could not be created (callers fall back to
+// sampling inline and writing synchronously).
+bool appTasksInit();
+
+// True if the sensor task is running
+bool appTasksSensorRunning();
+
+// Wait for the next sample from the sensor task (logic task pacing).
+// Returns false on timeout or if the sensor task is not running.
+bool appTasksWaitSample(PublishedSample& out, uint32_t timeout_ms);
+
+// Copy the latest published sample (any task). False if none yet.
+bool appTasksGetLatestSample(PublishedSample& out);
+
+// Samples overwritten before the logic task consumed them
+uint32_t appTasksGetDroppedSamples();
+
+// Hold the sensor task off the sensors for direct NAU7802 access (calibration
+// measurements, tare, one-off reads) so the two readers don't split the ADC's
+// conversion stream. Pause waits for the sample in progress; calls nest.
+// No-ops when the sensor task isn't running.
+void appTasksSensorPause();
+void appTasksSensorResume();
+
+// Scoped sensor pause - resumes the sensor task when the scope ends
+class SensorPauseScope {
+public:
+    SensorPauseScope() { appTasksSensorPause(); }
+    ~SensorPauseScope() { appTasksSensorResume(); }
+
+    SensorPauseScope(const SensorPauseScope&) = delete;
+    SensorPauseScope& operator=(const SensorPauseScope&) = delete;
+};
+
+// Queue a deferred flash write. Returns false if the storage task is not
+// running or the queue is full - the caller should then write synchronously.
+bool appTasksQueueStorageJob(StorageJobFn fn, void* arg);
+
+// True while queued storage jobs have not finished
+bool appTasksStorageBusy();
+
+// Wait until all queued storage jobs have finished (before reads/sleep)
+bool appTasksStorageSync(uint32_t timeout_ms);
+
+#endif // APP_TASKS_H
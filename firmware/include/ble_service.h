@@ -40,6 +40,10 @@
 // BLE MTU configuration
 #define BLE_MTU_SIZE                    247     // Maximum MTU for iOS
 
+// Command queue (GATT writes -> loop task, see bleUpdate())
+#define BLE_CMD_QUEUE_DEPTH             16      // Power of two (lock-free ring)
+#define BLE_CMD_DRAIN_MAX               16      // Max messages handled per bleUpdate()
+
 // Current State Characteristic (14 bytes)
 struct __attribute__((packed)) BLE_CurrentState {
     uint32_t timestamp;          // Unix time (seconds)
@@ -114,6 +118,18 @@ struct __attribute__((packed)) BLE_Command {
 #define BLE_CMD_GET_MOTION_CHUNK        0x31  // Request motion event chunk (param1 = chunk index)
 #define BLE_CMD_GET_BACKPACK_CHUNK      0x32  // Request backpack session chunk (param1 = chunk index)
 
+// Sensor Trace Commands (responses notified on Activity Stats characteristic)
+#define BLE_CMD_GET_TRACE_INFO          0x33  // Request trace info (BLE_TraceInfo)
+#define BLE_CMD_GET_TRACE_CHUNK         0x34  // Request trace frame chunk (param2 = chunk index)
+#define BLE_CMD_SET_TRACE_ENABLED       0x35  // Enable/disable trace recording (param1: 0=off, 1=on)
+
+// Boot Profile Commands (responses notified on Activity Stats characteristic)
+#define BLE_CMD_GET_BOOT_PROFILE        0x36  // Per-phase stats (param1: WakeReason filter, 0xFF = all)
+#define BLE_CMD_GET_BOOT_PROFILE_ENTRY  0x37  // One stored profile (param1: index, 0 = newest)
+
+// Energy Ledger Commands (responses notified on Activity Stats characteristic)
+#define BLE_CMD_GET_ENERGY_SUMMARY      0x38  // Request energy summary (BLE_EnergySummary)
+
 // Current State flags (BLE_CurrentState.flags)
 #define BLE_FLAG_TIME_VALID             0x01  // Bit 0: RTC time has been set
 #define BLE_FLAG_CALIBRATED             0x02  // Bit 1: Load cell calibrated
@@ -186,6 +202,54 @@ struct __attribute__((packed)) BLE_BackpackSessionChunk {
     BLE_BackpackSession sessions[BACKPACK_SESSIONS_PER_CHUNK];
 };
 
+// Sensor Trace Info (8 bytes) - response to GET_TRACE_INFO / SET_TRACE_ENABLED
+struct __attribute__((packed)) BLE_TraceInfo {
+    uint32_t frame_count;      // Frames stored (oldest first)
+    uint8_t  enabled;          // 1 if recording
+    uint8_t  frame_size;       // Bytes per frame (TraceFrame)
+    uint8_t  frames_per_chunk; // Frames per GET_TRACE_CHUNK response
+    uint8_t  version;          // Trace format version
+};
+
+// Sensor Trace Chunk (max 204 bytes = 4 + 10*20) - raw TraceFrame records
+#define TRACE_FRAMES_PER_CHUNK 10
+struct __attribute__((packed)) BLE_TraceChunk {
+    uint16_t chunk_index;      // Chunk index (frame offset = chunk_index * TRACE_FRAMES_PER_CHUNK)
+    uint8_t  frame_count;      // Frames in this chunk (0-10, 0 = past end)
+    uint8_t  _reserved;
+    uint8_t  frames[TRACE_FRAMES_PER_CHUNK * 20];
+};
+
+// Boot phase stats (12 bytes) - times are microseconds since boot
+struct __attribute__((packed)) BLE_BootPhaseStats {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;           // 0 = phase not reached on any stored wake
+};
+
+// Boot Profile Stats (max 4 + 16*12 bytes) - response to GET_BOOT_PROFILE
+#define BLE_BOOT_PROFILE_MAX_PHASES 16
+struct __attribute__((packed)) BLE_BootProfileStats {
+    uint8_t  profile_count;    // Stored profiles included in the stats
+    uint8_t  phase_count;      // Entries in phases[] (BootPhase order)
+    uint8_t  wake_reason;      // Filter applied (0xFF = all)
+    uint8_t  _reserved;
+    BLE_BootPhaseStats phases[BLE_BOOT_PROFILE_MAX_PHASES];
+};
+
+// Energy Summary (52 bytes) - response to GET_ENERGY_SUMMARY
+// Buckets: 6 base states (EnergyState) then 3 overlays (EnergyOverlay)
+#define BLE_ENERGY_BUCKETS 9
+#define BLE_ENERGY_FLAG_COMPLETE        0x01  // Bit 0: at least one full day accounted
+struct __attribute__((packed)) BLE_EnergySummary {
+    uint32_t uah_per_day;      // Rolling consumption estimate (uAh/day)
+    uint16_t days_remaining_x10; // Predicted battery life (0.1 day units)
+    uint8_t  battery_percent;  // Level used for the prediction
+    uint8_t  flags;            // BLE_ENERGY_FLAG_*
+    uint32_t window_sec;       // Time covered by the current window
+    uint32_t charge_uah[BLE_ENERGY_BUCKETS]; // Current window, per bucket
+};
+
 // Calibration State Notification (12 bytes) - Plan 060
 // Bottle broadcasts this when calibration state changes
 struct __attribute__((packed)) BLE_CalibrationState {
@@ -207,7 +271,7 @@ bool bleInit();
 
 /**
  * Update BLE service (call from main loop)
- * Handles periodic tasks, connection management
+ * Handles periodic tasks, connection management and queued GATT writes
  */
 void bleUpdate();
 
@@ -217,6 +281,18 @@ void bleUpdate();
  */
 bool bleIsConnected();
 
+/**
+ * Check if BLE is advertising
+ * @return true between bleStartAdvertising() and a connection / bleStopAdvertising()
+ */
+bool bleIsAdvertising();
+
+/**
+ * Check if a drink record sync is in progress
+ * @return true while sync chunks are being streamed
+ */
+bool bleIsSyncing();
+
 /**
  * Start BLE advertising
  * Advertising continues until bleStopAdvertising() is called (at sleep)
@@ -266,6 +342,12 @@ bool bleCheckClearHistoryRequested();
 bool bleCheckSetDailyTotalRequested(uint16_t& value);
 bool bleCheckForceDisplayRefresh();
 
+/**
+ * Reload the Bottle Config characteristic from NVS (loop task only).
+ * Call after saving the calibration or daily goal - reads serve this cache.
+ */
+void bleLoadBottleConfig();
+
 /**
  * Get daily hydration goal from bottle config
  * @return Daily goal in ml (default 2500)
@@ -0,0 +1,115 @@
+// boot_profile.h - Boot and wake phase profiler (RTC ring of recent wakes)
+// Part of the Aquavate smart water bottle firmware
+//
+// setup() and the first BOOT_PROFILE_LOOP_ITERATIONS loop() iterations drop
+// named esp_timer_get_time() checkpoints. Each wake's checkpoints are kept in
+// an RTC memory ring of the last BOOT_PROFILE_HISTORY wakes, tagged with the
+// wake reason, so boot time can be compared across wakes and regressions show
+// up without a scope. Read via the BOOT PROFILE serial command or the
+// GET_BOOT_PROFILE BLE command.
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if ENABLE_BOOT_PROFILE
+
+// Checkpoints (roughly in boot order - some complete on other tasks)
+enum BootPhase : uint8_t {
+    BOOT_PHASE_I2C_UP = 0,          // Wire + async I2C bus worker started
+    BOOT_PHASE_SERIAL_UP,           // Serial console ready (after attach delay)
+    BOOT_PHASE_NAU_READY,           // NAU7802 powered up and configured
+    BOOT_PHASE_ADXL_CONFIGURED,     // ADXL343 interrupts configured
+    BOOT_PHASE_NVS_LOADED,          // Calibration and settings loaded from NVS
+    BOOT_PHASE_LITTLEFS_MOUNTED,    // Drink record filesystem mounted
+    BOOT_PHASE_DRINKS_INIT,         // drinksInit() done
+    BOOT_PHASE_BLE_ADVERTISING,     // BLE up (advertising unless timer wake)
+    BOOT_PHASE_DISPLAY_RESTORED,    // Display/drink/activity state restored
+    BOOT_PHASE_SETUP_DONE,          // End of setup()
+    BOOT_PHASE_FIRST_WEIGHT,        // First fresh load cell sample in loop()
+    BOOT_PHASE_LOOP_N,              // BOOT_PROFILE_LOOP_ITERATIONS loops done
+    BOOT_PHASE_COUNT
+};
+
+// One wake's checkpoints (52 bytes)
+struct __attribute__((packed)) BootProfile {
+    uint8_t  wake_reason;                   // WakeReason (activity_stats.h)
+    uint8_t  phase_count;                   // BOOT_PHASE_COUNT when recorded
+    uint16_t _reserved;
+    uint32_t phase_us[BOOT_PHASE_COUNT];    // Time since boot, 0 = not reached
+};
+
+// Per-phase statistics across the stored profiles
+struct BootPhaseStats {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint8_t  samples;                       // Profiles that reached this phase
+};
+
+/**
+ * Start profiling this boot (call first thing in setup())
+ * @param wake_reason WakeReason for this boot
+ */
+void bootProfileBegin(uint8_t wake_reason);
+
+/**
+ * Record a checkpoint (first call per phase wins; safe from any task)
+ */
+void bootProfileMark(BootPhase phase);
+
+/**
+ * Count a loop() iteration - marks BOOT_PHASE_LOOP_N and commits the profile
+ * after BOOT_PROFILE_LOOP_ITERATIONS iterations
+ */
+void bootProfileLoopTick();
+
+/**
+ * Store the current profile in the RTC ring (no-op if already stored)
+ * Called automatically from bootProfileLoopTick(); call before deep sleep so
+ * short wakes are recorded too.
+ */
+void bootProfileCommit();
+
+/**
+ * Number of profiles stored in the RTC ring (0 to BOOT_PROFILE_HISTORY)
+ */
+uint8_t bootProfileGetCount();
+
+/**
+ * Get a stored profile
+ * @param index 0 = most recent
+ * @return false if index out of range
+ */
+bool bootProfileGet(uint8_t index, BootProfile& out);
+
+/**
+ * Min/avg/max of one phase across stored profiles
+ * @param wake_reason Only include profiles with this WakeReason, or -1 for all
+ * @return false if no stored profile reached the phase
+ */
+bool bootProfileGetStats(BootPhase phase, int wake_reason, BootPhaseStats& out);
+
+/**
+ * Short display name for a phase
+ */
+const char* bootProfilePhaseName(BootPhase phase);
+
+/**
+ * Print per-phase min/avg/max and the most recent profiles to Serial
+ */
+void bootProfilePrint();
+
+#else
+
+// Profiling compiled out - checkpoints cost nothing
+#define bootProfileBegin(wake_reason)   ((void)0)
+#define bootProfileMark(phase)          ((void)0)
+#define bootProfileLoopTick()           ((void)0)
+#define bootProfileCommit()             ((void)0)
+
+#endif // ENABLE_BOOT_PROFILE
+
+#endif // BOOT_PROFILE_H
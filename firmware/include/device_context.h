@@ -0,0 +1,49 @@
+// device_context.h - Cached battery level and local time for the main loop
+// Part of the Aquavate smart water bottle firmware
+//
+// Battery: VBAT is sampled every CONTEXT_BATTERY_SAMPLE_MS from loop(), each
+// sample averaging CONTEXT_BATTERY_OVERSAMPLE ADC reads, then smoothed with a
+// first-order IIR filter so ADC noise can't flip the quantised battery icon.
+// The filter state is kept in RTC memory across deep sleep; the first read after
+// a power cycle primes it directly.
+//
+// Time: the broken-down local time (g_timezone_offset applied) is cached and
+// only re-derived with gmtime_r() when the local minute changes; setting the
+// clock or timezone moves the minute key and refreshes it on the next read.
+
+#ifndef DEVICE_CONTEXT_H
+#define DEVICE_CONTEXT_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "config.h"
+
+/**
+ * Take a battery sample if CONTEXT_BATTERY_SAMPLE_MS has elapsed (call every loop)
+ */
+void deviceContextUpdate();
+
+/**
+ * Filtered battery voltage in volts (samples now if the filter isn't primed)
+ */
+float deviceContextBatteryVoltage();
+
+/**
+ * Battery percent (0-100) from the filtered voltage
+ */
+uint8_t deviceContextBatteryPercent();
+
+/**
+ * Cached local calendar time
+ * @param out Local time (tm_sec is kept current; the rest changes once a minute)
+ * @return false if time is not set (out untouched)
+ */
+bool deviceContextLocalTime(struct tm& out);
+
+/**
+ * Local hour and minute (convenience for display updates)
+ * @return false if time is not set (hour/minute untouched)
+ */
+bool deviceContextHourMinute(uint8_t& hour, uint8_t& minute);
+
+#endif // DEVICE_CONTEXT_H
@@ -3,6 +3,53 @@
 
 #include <Adafruit_ThinkInk.h>
 #include <Arduino.h>
+#include "raster.h"
+
+// Screen rectangle in drawing (rotated) coordinates
+struct DisplayRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+// GDEY0213B74 panel driver with a partial-refresh path for the main screen.
+// The Adafruit driver only runs the full (flashing) waveform; the SSD1680 can also
+// run a differential waveform that drives only pixels that differ between its
+// old-image RAM (0x26) and new-image RAM (0x24). With an internal-RAM frame buffer
+// (EPD_FRAMEBUFFER_INTERNAL) each plane goes to the panel in one SPI burst.
+class AquavateDisplay : public ThinkInk_213_Mono_GDEY0213B74 {
+public:
+    using ThinkInk_213_Mono_GDEY0213B74::ThinkInk_213_Mono_GDEY0213B74;
+
+    // Configure the controller for a differential update (powers it up first unless
+    // it is already running from an earlier partial this boot)
+    void partialBegin(bool controller_ready);
+
+    // Write the frame buffer to the controller's old-image (previous=true) or new-image
+    // RAM. With an area, only the panel gate rows covering it are sent.
+    void partialWriteFrame(bool previous, const DisplayRect* area = nullptr);
+
+    // Run the differential waveform (BUSY line if wired, else a fixed wait)
+    void partialRefresh();
+
+    // Work out the frame buffer's pixel-to-bit mapping by drawing probe pixels
+    // (clears the buffer). False for an SPI SRAM frame buffer or an unexpected layout.
+    bool rasterProbe(RasterTarget& target);
+
+    // FNV-1a hash of the frame buffer - identifies the image without keeping a copy.
+    // False for an SPI SRAM frame buffer.
+    bool frameBufferHash(uint32_t& hash);
+
+protected:
+    // Internal-RAM frame buffer: one bulk SPI write instead of a transaction per byte
+    void writeRAMFramebufferToEPD(uint8_t* buffer, uint32_t buffer_size,
+                                  uint8_t location, bool invertdata = false);
+
+private:
+    // Panel gate rows (frame buffer rows) covered by a rectangle at the current rotation
+    void gateRowsFor(const DisplayRect& area, uint16_t& first_row, uint16_t& last_row);
+};
 
 // Water drop bitmap for welcome screen (exported from display.cpp)
 extern const unsigned char water_drop_bitmap[] PROGMEM;
@@ -21,7 +68,7 @@ struct DisplayState {
 };
 
 // Public API
-void displayInit(ThinkInk_213_Mono_GDEY0213B74& display_ref);
+void displayInit(AquavateDisplay& display_ref);
 void displaySetDailyGoal(uint16_t goal_ml);
 bool displayCheckGoalChanged();  // Returns true if goal changed, clears flag
 bool displayNeedsUpdate(float current_water_ml,
@@ -35,11 +82,40 @@ void displayForceUpdate(float water_ml, uint16_t daily_total_ml,
                        uint8_t hour, uint8_t minute,
                        uint8_t battery_percent, bool sleeping);
 DisplayState displayGetState();
+
+// Deferred render (ENABLE_DEFERRED_RENDER): take a sensor-driven main-screen change
+// without refreshing. Held changes render once - after DISPLAY_DEFER_QUIET_MS with no
+// further change (displayDeferredDue) or at sleep entry (displayFlushDeferred). The
+// first draw after boot renders at once; without the mode this is displayUpdate().
+void displayDeferUpdate(float water_ml, uint16_t daily_total_ml,
+                        uint8_t hour, uint8_t minute, uint8_t battery_percent);
+bool displayDeferredDue();
+void displayFlushDeferred();    // Render held changes now (no-op if none)
+
+// Print the refresh governor state and per-day refresh counts (GET REFRESHES command)
+void displayRefreshStatsPrint();
+
+// Render the main screen from the current state. With the display task running this
+// posts the frame and returns at once (a frame still waiting is replaced by the newer
+// one); the render + refresh then happen on the task.
 void drawMainScreen();
+
+// True while a posted main-screen frame has not reached the panel yet
+bool displayBusy();
+
+// Wait for the display task to finish (other screens, sleep entry). False on timeout.
+bool displayWaitIdle(uint32_t timeout_ms);
+
 void displayBackpackMode();      // Show backpack mode screen with wake instructions (Issue #38)
 void displayLowBattery();        // Show full-screen "charge me" lockout screen (Issue #68)
 void displayTapWakeFeedback();   // Show immediate feedback when waking from tap (blank screen)
-void displayNVSWarning();        // Show storage error warning (3 seconds) when NVS write fails
+void displayNVSWarning();        // Show storage error warning (held INFO_SCREEN_DISPLAY_MS) when NVS write fails
+
+// Push the frame buffer to the panel with a full refresh (holds the display PM lock for
+// the transfer + refresh). The next main screen after another screen is always a full refresh.
+// Returns false (nothing sent) when the panel already shows this exact frame - the hash of
+// the last pushed frame is kept in RTC memory, so this holds across deep sleep.
+bool displayPushBuffer(AquavateDisplay& display_ref);
 
 // Mark display as initialized (used when waking from deep sleep - display image preserved)
 void displayMarkInitialized();
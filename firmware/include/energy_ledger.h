@@ -0,0 +1,99 @@
+// energy_ledger.h - Per-power-state energy accounting and battery-life estimate
+// Part of the Aquavate smart water bottle firmware
+//
+// Adds up the time spent in each power state and multiplies it by the per-state
+// current constants in config.h (ENERGY_CURRENT_*). Base states are mutually
+// exclusive (deep sleep, awake idle, advertising, connected, syncing); overlay
+// loads (e-paper refresh, flash write, NAU7802 conversion) are added on top for
+// their measured duration. Totals live in RTC memory so sleep time is counted
+// across wakes; a rolling mAh/day estimate gives a single number to compare
+// firmware changes and a predicted days-remaining for the app.
+
+#ifndef ENERGY_LEDGER_H
+#define ENERGY_LEDGER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if ENABLE_ENERGY_LEDGER
+
+// Base power states (exactly one at a time)
+enum EnergyState : uint8_t {
+    ENERGY_STATE_SLEEP_NORMAL = 0,  // Deep sleep, motion/placement wake armed
+    ENERGY_STATE_SLEEP_EXTENDED,    // Deep sleep, backpack mode (tap + timer wake)
+    ENERGY_STATE_AWAKE_IDLE,        // Awake, BLE off (timer wake)
+    ENERGY_STATE_AWAKE_ADVERTISING, // Awake, BLE advertising
+    ENERGY_STATE_BLE_CONNECTED,     // Awake, BLE connected
+    ENERGY_STATE_BLE_SYNCING,       // Awake, drink record sync streaming
+    ENERGY_STATE_COUNT
+};
+
+// Overlay loads (added on top of the base state for their duration)
+enum EnergyOverlay : uint8_t {
+    ENERGY_OVERLAY_EPD_REFRESH = 0, // E-paper transfer + refresh
+    ENERGY_OVERLAY_FLASH_WRITE,     // LittleFS / NVS write
+    ENERGY_OVERLAY_NAU_ACTIVE,      // NAU7802 powered and converting
+    ENERGY_OVERLAY_COUNT
+};
+
+#define ENERGY_BUCKET_COUNT (ENERGY_STATE_COUNT + ENERGY_OVERLAY_COUNT)
+
+struct EnergySummary {
+    float    mah_per_day;           // Rolling estimate
+    float    days_remaining;        // At mah_per_day from the current battery level
+    uint32_t window_sec;            // Time covered by the current window
+    bool     estimate_complete;     // At least one full day accounted
+    uint32_t charge_uah[ENERGY_BUCKET_COUNT];  // Current window, per state then per overlay
+    uint32_t time_sec[ENERGY_BUCKET_COUNT];
+};
+
+/**
+ * Restore the ledger from RTC memory (resets on power cycle) and account the
+ * deep sleep that just ended. Call early in setup().
+ */
+void energyLedgerInit();
+
+/**
+ * Account awake time since the last call to the given base state (call every loop)
+ */
+void energyLedgerTick(EnergyState state);
+
+/**
+ * Add an overlay load for a measured duration (any task)
+ */
+void energyLedgerAddOverlay(EnergyOverlay overlay, uint32_t duration_us);
+
+/**
+ * Close the awake period and note which deep sleep follows (call at sleep entry)
+ * @param extended true for backpack-mode sleep
+ */
+void energyLedgerEnterSleep(bool extended);
+
+/**
+ * Current estimate
+ * @param battery_percent Current battery level for days_remaining
+ */
+void energyLedgerGetSummary(uint8_t battery_percent, EnergySummary& out);
+
+/**
+ * Print the summary and per-bucket breakdown to serial (GET ENERGY command)
+ */
+void energyLedgerPrint(uint8_t battery_percent);
+
+// Scoped overlay timer - adds the enclosed duration to an overlay bucket
+class EnergyOverlayScope {
+public:
+    explicit EnergyOverlayScope(EnergyOverlay overlay) : m_overlay(overlay), m_start_us(micros()) {}
+    ~EnergyOverlayScope() { energyLedgerAddOverlay(m_overlay, micros() - m_start_us); }
+
+    EnergyOverlayScope(const EnergyOverlayScope&) = delete;
+    EnergyOverlayScope& operator=(const EnergyOverlayScope&) = delete;
+
+private:
+    EnergyOverlay m_overlay;
+    uint32_t m_start_us;
+};
+
+#endif // ENABLE_ENERGY_LEDGER
+
+#endif // ENERGY_LEDGER_H
@@ -48,6 +48,10 @@ void gesturesInit(Adafruit_ADXL343& adxl, const GestureConfig& config);
 // weight_ml: current weight reading in ml (negative if bottle is in the air)
 GestureType gesturesUpdate(float weight_ml = 0.0f);
 
+// Update gesture detection from an accelerometer sample read elsewhere
+// (raw ADXL343 counts, e.g. from sensor_sampler) instead of polling the driver
+GestureType gesturesUpdateFromSample(int16_t x, int16_t y, int16_t z, float weight_ml = 0.0f);
+
 // Get current gesture config
 const GestureConfig& gesturesGetConfig();
 
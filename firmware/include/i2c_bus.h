@@ -0,0 +1,89 @@
+// i2c_bus.h - Asynchronous I2C bus manager
+// Part of the Aquavate smart water bottle firmware
+//
+// Owns the shared I2C peripheral (Wire / I2C_NUM_0) at I2C_BUS_CLOCK_HZ and
+// runs queued transactions on a worker task using ESP-IDF command links, so the
+// main loop can start a sensor read and keep working while it is on the wire.
+//
+// A transaction is a short list of register reads/writes, possibly to several
+// devices, executed back-to-back with repeated starts in a single command link.
+// Adjacent reads from the same device whose register ranges touch (or are at
+// most I2C_BUS_MERGE_GAP registers apart) are merged into one burst read.
+//
+// Transactions are owned by the caller and must stay alive until complete.
+// Completion callbacks run on the worker task - keep them short and hand
+// results back through the transaction buffers / flags.
+//
+// Driver-level configuration (nau.begin(), adxl.begin(), RTClib) still goes
+// through Wire; the ESP-IDF driver serialises those against the worker.
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#define I2C_BUS_MAX_SEGMENTS    6
+#define I2C_BUS_MAX_BURST       32  // Longest single read/write (bytes)
+
+struct I2CTransaction;
+
+// Completion callback (worker task context)
+typedef void (*I2CBusCallback)(I2CTransaction& txn, void* ctx);
+
+// One register access within a transaction
+struct I2CSegment {
+    uint8_t addr;       // 7-bit device address
+    uint8_t reg;        // First register
+    uint8_t len;        // Bytes to read/write
+    bool is_write;
+    uint8_t* data;      // Caller-owned buffer (len bytes)
+};
+
+struct I2CTransaction {
+    I2CSegment segments[I2C_BUS_MAX_SEGMENTS];
+    uint8_t segment_count;
+    I2CBusCallback callback;
+    void* ctx;
+    volatile bool done;         // Set by worker before callback
+    volatile int32_t result;    // esp_err_t (ESP_OK on success)
+    void* waiter;               // Task blocked in i2cBusWait() (internal)
+};
+
+// Bus statistics (for diagnostics)
+struct I2CBusStats {
+    uint32_t transactions;      // Completed transactions
+    uint32_t errors;            // Transactions that returned != ESP_OK
+    uint32_t merged_segments;   // Segments folded into a neighbouring burst
+    uint32_t queue_full;        // Submits rejected (queue full)
+    uint32_t bus_time_us;       // Total time spent in i2c_master_cmd_begin()
+};
+
+// Set the bus clock and start the worker task. Call after Wire.begin().
+// Returns false if the worker could not be started (callers fall back to Wire).
+bool i2cBusInit();
+
+// True once the worker is running
+bool i2cBusIsReady();
+
+// Reset a transaction before adding segments
+void i2cBusTransactionInit(I2CTransaction& txn, I2CBusCallback callback = nullptr, void* ctx = nullptr);
+
+// Append a register read/write (false if the transaction is full or len too long)
+bool i2cBusAddRead(I2CTransaction& txn, uint8_t addr, uint8_t reg, uint8_t* buf, uint8_t len);
+bool i2cBusAddWrite(I2CTransaction& txn, uint8_t addr, uint8_t reg, uint8_t* buf, uint8_t len);
+
+// Queue a transaction for the worker (returns immediately)
+bool i2cBusSubmit(I2CTransaction& txn);
+
+// Block until a submitted transaction completes. Returns true on ESP_OK.
+// Waits on the calling task's notification (pending notifications are cleared).
+bool i2cBusWait(I2CTransaction& txn, uint32_t timeout_ms);
+
+// Submit + wait
+bool i2cBusTransfer(I2CTransaction& txn, uint32_t timeout_ms);
+
+// Get bus statistics
+I2CBusStats i2cBusGetStats();
+
+#endif // I2C_BUS_H
@@ -0,0 +1,81 @@
+// loop_profiler.h - loop() stage timing and period jitter profiler
+// Part of the Aquavate smart water bottle firmware
+//
+// Scoped probes around each stage of loop() add the stage's execution time to
+// a log2 histogram (bucket n holds 2^n..2^(n+1)-1 us), with count/min/max/avg.
+// loopProfilerLoopTick() at the top of loop() tracks the loop period and its
+// deviation from SENSOR_TASK_INTERVAL_MS. Probes can nest (the BODY stage
+// includes all others), so stage times are inclusive. Read or reset with the
+// PROFILE serial command. With ENABLE_LOOP_PROFILER 0 the probes compile to
+// nothing.
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if ENABLE_LOOP_PROFILER
+
+// Timed stages of loop()
+enum LoopStage : uint8_t {
+    LOOP_STAGE_SAMPLE_WAIT = 0,     // Blocked waiting for the sensor task (idle)
+    LOOP_STAGE_BODY,                // Everything after the sample wait (busy time)
+    LOOP_STAGE_SERIAL,              // serialCommandsUpdate()
+    LOOP_STAGE_BLE,                 // bleUpdate() + BLE command flag handling
+    LOOP_STAGE_GESTURES,            // gesturesUpdateFromSample() + double-tap check
+    LOOP_STAGE_DRINKS,              // drinksUpdate()
+    LOOP_STAGE_DISPLAY,             // displayUpdate() / displayForceUpdate()
+    LOOP_STAGE_UNSYNCED_COUNT,      // storageGetUnsyncedCount()
+    LOOP_STAGE_DEBUG_PRINT,         // Status line / accelerometer debug output (when printed)
+    LOOP_STAGE_COUNT
+};
+
+/**
+ * Mark the start of a loop() iteration (records the period since the last call)
+ */
+void loopProfilerLoopTick();
+
+/**
+ * Add one execution time to a stage's histogram (called by LoopProfileScope)
+ */
+void loopProfilerRecord(LoopStage stage, uint32_t duration_us);
+
+/**
+ * Clear all histograms and period statistics
+ */
+void loopProfilerReset();
+
+/**
+ * Print per-stage histograms and loop period jitter to serial (PROFILE command)
+ */
+void loopProfilerPrint();
+
+// Scoped stage timer - records the enclosed duration on scope exit (early returns included)
+class LoopProfileScope {
+public:
+    explicit LoopProfileScope(LoopStage stage) : m_stage(stage), m_start_us(micros()) {}
+    ~LoopProfileScope() { loopProfilerRecord(m_stage, micros() - m_start_us); }
+
+    LoopProfileScope(const LoopProfileScope&) = delete;
+    LoopProfileScope& operator=(const LoopProfileScope&) = delete;
+
+private:
+    LoopStage m_stage;
+    uint32_t m_start_us;
+};
+
+#define LOOP_PROFILE_CONCAT_(a, b)      a##b
+#define LOOP_PROFILE_CONCAT(a, b)       LOOP_PROFILE_CONCAT_(a, b)
+#define LOOP_PROFILE_SCOPE(stage) \
+    LoopProfileScope LOOP_PROFILE_CONCAT(loop_profile_scope_, __LINE__)(stage)
+
+#else
+
+// Profiling compiled out - probes cost nothing
+#define LOOP_PROFILE_SCOPE(stage)       ((void)0)
+#define loopProfilerLoopTick()          ((void)0)
+
+#endif // ENABLE_LOOP_PROFILER
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,79 @@
+// mpsc_queue.h - Bounded lock-free multi-producer / single-consumer queue
+// Part of the Aquavate smart water bottle firmware
+//
+// Fixed-capacity ring (no allocation) where each slot carries a sequence
+// number (Vyukov bounded queue). Producers claim a slot with a CAS on the
+// enqueue position, so push() is safe from any task (NimBLE host, loop, ...)
+// and never blocks - it fails when the ring is full. pop() must only be called
+// from one consumer task. Capacity must be a power of two.
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() : m_enqueue_pos(0), m_dequeue_pos(0) {
+        for (size_t i = 0; i < Capacity; i++) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Any task. Returns false if the queue is full.
+    bool push(const T& item) {
+        size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[pos & (Capacity - 1)];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0) {
+                // Slot free for this position - try to claim it
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);  // Another producer won
+            }
+        }
+    }
+
+    // Consumer task only. Returns false if the queue is empty.
+    bool pop(T& out) {
+        size_t pos = m_dequeue_pos;
+        Slot& slot = m_slots[pos & (Capacity - 1)];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+            return false;  // Empty (or producer still writing this slot)
+        }
+
+        out = slot.item;
+        slot.sequence.store(pos + Capacity, std::memory_order_release);
+        m_dequeue_pos = pos + 1;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    Slot m_slots[Capacity];
+    std::atomic<size_t> m_enqueue_pos;
+    size_t m_dequeue_pos;   // Consumer-owned
+};
+
+#endif // MPSC_QUEUE_H
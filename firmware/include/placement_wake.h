@@ -0,0 +1,31 @@
+// placement_wake.h - ADXL343 placement wake for normal sleep
+// Part of the Aquavate smart water bottle firmware
+//
+// The ADXL343's linked activity/inactivity state machine wakes the CPU once the
+// bottle has been moved and then set down upright and still (ENABLE_PLACEMENT_WAKE).
+// Activity is routed to the unconnected INT2, inactivity to INT1 (wake pin).
+//
+// In link mode the chip searches for inactivity first. A bottle going to sleep
+// upright and still would therefore raise INT1 after PLACEMENT_INACT_TIME and
+// wake straight back up. Arming waits for that first inactivity event and clears
+// it, which leaves the state machine searching for activity (a pickup) - only the
+// inactivity after that pickup reaches the wake pin.
+//
+// Register access goes through writeAccelReg()/readAccelReg() (main.cpp), so the
+// sequence can be checked on the host against a simulated ADXL343 (wake/).
+
+#ifndef PLACEMENT_WAKE_H
+#define PLACEMENT_WAKE_H
+
+#include <Arduino.h>
+
+/**
+ * Configure the placement wake and wait out the initial inactivity event.
+ * Blocks for up to PLACEMENT_ARM_TIMEOUT_MS.
+ * @return true if the bottle was still and the chip now waits for a pickup;
+ *         false if it wasn't still in time (it then wakes on the next
+ *         placement, which is still correct)
+ */
+bool placementWakeArm();
+
+#endif // PLACEMENT_WAKE_H
@@ -0,0 +1,66 @@
+// power_mgmt.h - Awake-mode power management (DFS, automatic light sleep, PM locks)
+// Part of the Aquavate smart water bottle firmware
+//
+// While awake the firmware mostly waits - the loop blocks on the sensor task's
+// mailbox and the sensor task sleeps between samples. With ESP-IDF power
+// management the CPU drops to POWER_CPU_MIN_MHZ (and into light sleep when
+// every task is blocked) and only runs at full clock while a PM lock is held.
+// Code that must not be slowed down or slept through (I2C bursts, e-paper SPI
+// transfers, BLE sync) holds one of the locks below.
+//
+// Cores built without CONFIG_PM_ENABLE fall back to a fixed POWER_CPU_MIN_MHZ
+// clock; the lock calls are then no-ops.
+
+#ifndef POWER_MGMT_H
+#define POWER_MGMT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+enum PowerLock : uint8_t {
+    POWER_LOCK_I2C = 0,         // APB at max, no light sleep (I2C transaction)
+    POWER_LOCK_DISPLAY,         // APB at max, no light sleep (e-paper SPI + refresh)
+    POWER_LOCK_BLE_SYNC,        // CPU at max (drink record sync in progress)
+    POWER_LOCK_COUNT
+};
+
+/**
+ * Configure power management (call once, early in setup())
+ * @param allow_light_sleep false keeps the chip out of automatic light sleep
+ *        (e.g. while a USB serial console is attached)
+ * @return true if esp_pm DFS is active, false if using the fixed-clock fallback
+ */
+bool powerMgmtInit(bool allow_light_sleep);
+
+/**
+ * Take / give a PM lock (counted - nested acquires are fine)
+ */
+void powerMgmtAcquire(PowerLock lock);
+void powerMgmtRelease(PowerLock lock);
+
+/**
+ * Level-style hold for state that is polled rather than scoped (e.g. BLE sync):
+ * acquires on the first true, releases on the first false, ignores repeats.
+ */
+void powerMgmtSetHeld(PowerLock lock, bool held);
+
+/**
+ * True if esp_pm DFS / automatic light sleep were enabled by powerMgmtInit()
+ */
+bool powerMgmtDfsActive();
+bool powerMgmtLightSleepActive();
+
+// Scoped lock - held for the lifetime of the guard
+class PowerLockGuard {
+public:
+    explicit PowerLockGuard(PowerLock lock) : m_lock(lock) { powerMgmtAcquire(m_lock); }
+    ~PowerLockGuard() { powerMgmtRelease(m_lock); }
+
+    PowerLockGuard(const PowerLockGuard&) = delete;
+    PowerLockGuard& operator=(const PowerLockGuard&) = delete;
+
+private:
+    PowerLock m_lock;
+};
+
+#endif // POWER_MGMT_H
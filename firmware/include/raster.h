@@ -0,0 +1,73 @@
+// raster.h - Packed 1bpp drawing primitives for the e-paper frame buffer
+// Part of the Aquavate smart water bottle firmware
+//
+// Draws straight into the frame buffer bytes instead of one Adafruit_GFX
+// drawPixel() call per pixel. The SSD1680 buffer packs 8 vertically adjacent
+// screen pixels per byte (one buffer row per screen column at our rotation), so
+// everything is built on vertical runs: a run of h pixels touches at most
+// h/8 + 2 bytes. Coordinates are the rotated drawing coordinates display.cpp
+// uses; the pixel-to-bit mapping is probed from the driver at init
+// (AquavateDisplay::rasterProbe) rather than assumed, and callers fall back to
+// Adafruit_GFX when no target is available (SPI SRAM frame buffer).
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <Arduino.h>
+
+// Frame buffer geometry. Pixel (x, y) is linear bit origin_bit + x * x_step +
+// y * y_step, where linear bit n is bit (7 - n % 8) of byte n / 8.
+struct RasterTarget {
+    uint8_t* buf;               // Frame buffer (nullptr = unavailable)
+    uint32_t size_bytes;
+    int32_t origin_bit;         // Linear bit of pixel (0, 0)
+    int32_t x_step;             // Linear bits from (x, y) to (x + 1, y)
+    int8_t y_step;              // Linear bits from (x, y) to (x, y + 1): +1 or -1
+    bool ink_sets_bits;         // Black pixel = 1 bit (false: 0 bit, SSD1680 RAM polarity)
+    int16_t width;              // Drawing area after rotation
+    int16_t height;
+};
+
+// Column-major 1bpp sprite (1 = ink). Column c is column_bytes bytes at
+// data + c * column_bytes; row r is bit (7 - r % 8) of byte r / 8 (MSB = top).
+struct RasterSprite {
+    const uint8_t* data;
+    int16_t width;
+    int16_t height;             // At most RASTER_MAX_SPRITE_HEIGHT
+    uint8_t column_bytes;       // (height + 7) / 8
+};
+
+#define RASTER_MAX_SPRITE_HEIGHT    128
+
+/**
+ * Fill a vertical run of h pixels from (x, y) - clipped to the target
+ * @param ink true = black, false = white
+ */
+void rasterFillColumn(const RasterTarget& target, int16_t x, int16_t y, int16_t h, bool ink);
+
+/**
+ * Fill a rectangle (same pixels as Adafruit_GFX::fillRect)
+ */
+void rasterFillRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h, bool ink);
+
+/**
+ * Rectangle outline (same pixels as Adafruit_GFX::drawRect)
+ */
+void rasterDrawRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h, bool ink);
+
+/**
+ * Filled rounded rectangle (same pixels as Adafruit_GFX::fillRoundRect)
+ */
+void rasterFillRoundRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h,
+                         int16_t r, bool ink);
+
+/**
+ * Ink a sprite's set pixels at (x, y); clear pixels are left untouched.
+ * Rows from lower_from_row down are taken from 'lower' instead (same size), so
+ * an outline and a filled version composite in one pass.
+ * @param lower Optional second sprite (nullptr = draw 'sprite' only)
+ */
+void rasterBlitSprite(const RasterTarget& target, int16_t x, int16_t y, const RasterSprite& sprite,
+                      const RasterSprite* lower = nullptr, int16_t lower_from_row = 0);
+
+#endif // RASTER_H
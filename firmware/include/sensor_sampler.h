@@ -0,0 +1,38 @@
+// sensor_sampler.h - Per-loop sensor sample via the async I2C bus
+// Part of the Aquavate smart water bottle firmware
+//
+// Reads everything the main loop needs each iteration - NAU7802 cycle-ready
+// flag + ADC result, ADXL343 INT_SOURCE + X/Y/Z - as one i2c_bus transaction.
+// The ADXL343 reads (0x30, 0x32-0x37) are merged into a single 8-byte burst.
+// sensorSamplerRequest() starts the transfer at the top of the loop so it runs
+// while serial/BLE work is serviced; sensorSamplerGet() collects it. If the bus
+// worker is unavailable or the transfer fails, Get falls back to blocking
+// driver reads so callers always receive a sample.
+
+#ifndef SENSOR_SAMPLER_H
+#define SENSOR_SAMPLER_H
+
+#include <Arduino.h>
+#include <Adafruit_NAU7802.h>
+#include <Adafruit_ADXL343.h>
+
+struct SensorSample {
+    bool adc_fresh;         // NAU7802 had a new conversion (PU_CTRL.CR)
+    int32_t adc;            // Raw 24-bit ADC (sign-extended), valid if adc_fresh
+    int16_t accel_x;        // Raw ADXL343 counts (256 LSB/g)
+    int16_t accel_y;
+    int16_t accel_z;
+    uint8_t int_source;     // ADXL343 INT_SOURCE (reading clears the flags)
+};
+
+// Register the sensors that initialised OK (nullptr = not present)
+void sensorSamplerInit(Adafruit_NAU7802* nau, Adafruit_ADXL343* adxl);
+
+// Start an asynchronous sample (no-op if one is already in flight)
+void sensorSamplerRequest();
+
+// Collect the sample started by sensorSamplerRequest() (starts one if needed).
+// Returns false only if no sensors are registered.
+bool sensorSamplerGet(SensorSample& sample);
+
+#endif // SENSOR_SAMPLER_H
@@ -0,0 +1,84 @@
+// sleep_scheduler.h - Learned usage-pattern sleep scheduler
+// Part of the Aquavate smart water bottle firmware
+//
+// Keeps decayed per-hour-of-day counts of drinks, placement wakes, quick
+// re-pick-ups (a wake within SCHED_REPICKUP_WINDOW_SEC of going to sleep) and
+// phone connections, built from drink records and the MotionWakeEvent history.
+// The sleep timers ask it for the value to use in the current hour; until time
+// is valid and SCHED_MIN_DAYS of history exist it hands back the base values.
+// Counts live in RTC memory and are re-seeded from LittleFS drink records after
+// a power cycle.
+
+#ifndef SLEEP_SCHEDULER_H
+#define SLEEP_SCHEDULER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if ENABLE_SLEEP_SCHEDULER
+
+/**
+ * Restore the model from RTC (resets and queues a drink-record seed on power
+ * cycle) and apply the daily decay. Call in setup() after activity stats.
+ */
+void sleepSchedulerInit();
+
+/**
+ * Fold the MotionWakeEvents recorded since the last call into the model.
+ * Call at sleep entry, after activityStatsRecord*Sleep().
+ * @param sync_window_held true if this wake held the sync window open
+ */
+void sleepSchedulerRecordSleep(bool sync_window_held);
+
+/**
+ * A drink record was created (timestamp = local Unix time)
+ */
+void sleepSchedulerRecordDrink(uint32_t timestamp);
+
+/**
+ * A phone connected during this wake (counted once per wake)
+ */
+void sleepSchedulerRecordConnect();
+
+/**
+ * Activity timeout for the current hour
+ * @param base_ms g_sleep_timeout_ms (0 = sleep disabled, returned unchanged)
+ */
+uint32_t sleepSchedulerActivityTimeoutMs(uint32_t base_ms);
+
+/**
+ * Sync window (activity timeout while records wait to sync) for the current hour
+ * @param base_ms ACTIVITY_TIMEOUT_EXTENDED_MS
+ */
+uint32_t sleepSchedulerSyncTimeoutMs(uint32_t base_ms);
+
+/**
+ * Backpack-mode (time since stable) threshold for the current hour
+ * @param base_sec g_time_since_stable_threshold_sec
+ */
+uint32_t sleepSchedulerBackpackThresholdSec(uint32_t base_sec);
+
+/**
+ * Pick the backpack-mode timer wake. With records waiting, aims the wake at the
+ * next hour the phone usually connects if that comes before max_sec; that wake
+ * must fully boot and advertise (see sleepSchedulerTakeSyncWake()).
+ * @param max_sec Health-check interval (upper bound)
+ * @param unsynced_pending true if drink records are waiting to sync
+ * @param out_sec Timer interval to use
+ * @return true if the wake was aimed at a sync window
+ */
+bool sleepSchedulerPlanExtendedWake(uint32_t max_sec, bool unsynced_pending, uint32_t& out_sec);
+
+/**
+ * True (once) if this timer wake was aimed at a sync window
+ */
+bool sleepSchedulerTakeSyncWake();
+
+/**
+ * Print the per-hour model and current decisions (GET SCHEDULE command)
+ */
+void sleepSchedulerPrint();
+
+#endif // ENABLE_SLEEP_SCHEDULER
+
+#endif // SLEEP_SCHEDULER_H
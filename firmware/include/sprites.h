@@ -0,0 +1,31 @@
+// sprites.h - Pre-rendered main-screen sprites in flash
+// Part of the Aquavate smart water bottle firmware
+//
+// Column-major RasterSprites baked at build time by scripts/gen_sprites.py
+// (src/sprites_generated.cpp) with the same algorithms as the Adafruit_GFX calls
+// they replace, so the main screen renders by copying them into the frame buffer
+// (rasterBlitSprite) and looks identical. Only used when the frame buffer is in
+// internal RAM; the GFX drawing stays as the fallback.
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <Arduino.h>
+#include "raster.h"
+
+extern const RasterSprite SPRITE_BOTTLE;            // Bottle outline, no water (40x90)
+extern const RasterSprite SPRITE_FIGURE_OUTLINE;    // Human figure outline (54x90)
+extern const RasterSprite SPRITE_FIGURE_FILLED;     // Human figure filled (54x90)
+extern const RasterSprite SPRITE_GLASS_EMPTY;       // Tumbler outline (18x16)
+extern const RasterSprite SPRITE_GLASS_FULL;        // Tumbler outline + full fill (18x16)
+extern const RasterSprite SPRITE_TODAY;             // "today" at text size 2 (58x16)
+
+#define SPRITE_LARGE_ADVANCE    18                  // Text size 3 character pitch (px)
+
+/**
+ * Text size 3 glyph (15x24) for the intake number
+ * @return nullptr for characters other than '0'-'9', 'm', 'l'
+ */
+const RasterSprite* spriteLargeGlyph(char c);
+
+#endif // SPRITES_H
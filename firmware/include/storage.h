@@ -95,4 +95,10 @@ bool storageSaveLowBatteryThreshold(uint8_t percent);
 // Load low battery lockout threshold from NVS (default: 20%)
 uint8_t storageLoadLowBatteryThreshold();
 
+// Save sensor trace recorder enabled setting to NVS
+bool storageSaveTraceEnabled(bool enabled);
+
+// Load sensor trace recorder enabled setting from NVS (default: false = disabled)
+bool storageLoadTraceEnabled();
+
 #endif // STORAGE_H
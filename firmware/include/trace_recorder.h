@@ -0,0 +1,126 @@
+// trace_recorder.h - Binary sensor trace recorder (LittleFS ring file)
+// Part of the Aquavate smart water bottle firmware
+//
+// Records one compact frame per loop iteration (load cell ADC, accelerometer,
+// gesture, drink detector state) for offline tuning of GESTURE_* / DRINK_*
+// thresholds. Frames are batched in RAM and written to /trace.bin in whole
+// TRACE_BLOCK_SIZE blocks, so flash is touched once per block (or once per wake
+// when flushed at sleep entry). The file is a fixed ring of TRACE_RING_BLOCKS
+// slots; each block carries a sequence number so the ring order survives power
+// loss without a separate metadata file.
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "gestures.h"
+
+#if ENABLE_TRACE_RECORDER
+
+#define TRACE_FORMAT_VERSION    1
+#define TRACE_BLOCK_MAGIC       0x54524331  // "TRC1"
+
+// Frame flags (TraceFrame.flags)
+#define TRACE_FLAG_ADC_FRESH        0x01  // adc is a new NAU7802 sample this loop
+#define TRACE_FLAG_CALIBRATED       0x02  // Load cell calibration valid
+#define TRACE_FLAG_DRINK_CHECKED    0x04  // drinksUpdate() ran this loop
+#define TRACE_FLAG_DRINK_RECORDED   0x08  // drinksUpdate() recorded a drink/refill
+#define TRACE_FLAG_CANCEL_PENDING   0x10  // Shake-to-empty cancel pending
+#define TRACE_FLAG_CAL_ACTIVE       0x20  // Calibration state machine active
+#define TRACE_FLAG_STABLE           0x40  // gesturesIsStable() (low accel variance)
+#define TRACE_FLAG_SESSION_START    0x80  // First frame after boot/wake (millis() restarted)
+
+// One trace frame (20 bytes)
+struct __attribute__((packed)) TraceFrame {
+    uint32_t timestamp_ms;   // millis() at sample time (restarts each wake)
+    int32_t  adc;            // Raw NAU7802 reading (valid if TRACE_FLAG_ADC_FRESH)
+    int32_t  baseline_adc;   // Drink detector baseline (DailyState.last_recorded_adc)
+    int16_t  accel_x;        // Raw ADXL343 counts (256 LSB/g)
+    int16_t  accel_y;
+    int16_t  accel_z;
+    uint8_t  gesture;        // GestureType
+    uint8_t  flags;          // TRACE_FLAG_* bits
+};
+
+// Block header at the start of every ring slot (16 bytes)
+struct __attribute__((packed)) TraceBlockHeader {
+    uint32_t magic;          // TRACE_BLOCK_MAGIC
+    uint32_t sequence;       // Monotonic block sequence (orders the ring)
+    uint16_t frame_count;    // Valid frames in this block
+    uint8_t  frame_size;     // sizeof(TraceFrame)
+    uint8_t  version;        // TRACE_FORMAT_VERSION
+    uint32_t _reserved;
+};
+
+#define TRACE_FRAMES_PER_BLOCK  ((TRACE_BLOCK_SIZE - sizeof(TraceBlockHeader)) / sizeof(TraceFrame))
+#define TRACE_MAX_FRAMES        (TRACE_FRAMES_PER_BLOCK * TRACE_RING_BLOCKS)
+
+/**
+ * Initialize trace recorder
+ * Loads the enabled flag from NVS and scans the ring file for the newest block.
+ * Must be called after storageInit() and storageInitDrinkFS().
+ *
+ * @return true if the ring file is usable
+ */
+bool traceRecorderInit();
+
+/**
+ * Enable or disable recording (persisted to NVS)
+ * Disabling flushes any pending frames first.
+ */
+bool traceRecorderSetEnabled(bool enabled);
+bool traceRecorderIsEnabled();
+
+/**
+ * Note the outcome of a drinksUpdate() call
+ * Folded into the next recorded frame's flags.
+ *
+ * @param drink_recorded Return value of drinksUpdate()
+ */
+void traceRecorderNoteDrinkCheck(bool drink_recorded);
+
+/**
+ * Record one frame (call once per loop, after sensors and drink logic)
+ * Accelerometer and drink baseline are sampled internally.
+ * No-op when recording is disabled.
+ *
+ * @param timestamp_ms Sensor snapshot timestamp
+ * @param adc Load cell reading for this loop
+ * @param gesture Gesture for this loop
+ * @param flags Caller-owned TRACE_FLAG_* bits (ADC_FRESH, CALIBRATED, CANCEL_PENDING, CAL_ACTIVE)
+ */
+void traceRecorderRecord(uint32_t timestamp_ms, int32_t adc, GestureType gesture, uint8_t flags);
+
+/**
+ * Write the pending RAM block to flash (call before deep sleep)
+ * A partial block is rewritten in place and keeps filling on the next wake.
+ *
+ * @return true if nothing was pending or the write succeeded (false if a
+ *         deferred block write didn't finish in time - nothing is written)
+ */
+bool traceRecorderFlush();
+
+/**
+ * Erase the ring file and discard pending frames
+ */
+bool traceRecorderClear();
+
+/**
+ * Get total frames available (flushed + pending), oldest first
+ */
+uint32_t traceRecorderGetFrameCount();
+
+/**
+ * Read frames in chronological order
+ *
+ * @param first_frame Index of first frame (0 = oldest)
+ * @param out Output buffer
+ * @param max_frames Capacity of output buffer
+ * @return Number of frames copied (0 if a deferred block write didn't finish in time)
+ */
+uint16_t traceRecorderReadFrames(uint32_t first_frame, TraceFrame* out, uint16_t max_frames);
+
+#endif // ENABLE_TRACE_RECORDER
+
+#endif // TRACE_RECORDER_H
@@ -15,7 +15,7 @@
 
 // Include display header for function declarations (needed even when calibration disabled)
 #if defined(BOARD_ADAFRUIT_FEATHER)
-    #include "Adafruit_ThinkInk.h"
+    #include "display.h"
 #endif
 
 #if ENABLE_STANDALONE_CALIBRATION
@@ -23,7 +23,7 @@
 // Initialize calibration UI module
 // Pass reference to e-paper display object
 #if defined(BOARD_ADAFRUIT_FEATHER)
-    void uiCalibrationInit(ThinkInk_213_Mono_GDEY0213B74& display);
+    void uiCalibrationInit(AquavateDisplay& display);
 #endif
 
 // Show calibration start screen
@@ -83,7 +83,7 @@ void uiCalibrationUpdateForState(CalibrationState state, int32_t adc_value, floa
 // Bottle emptied confirmation screen (always available - not tied to calibration mode)
 // Shows "Bottle / Emptied" in calibration screen style
 #if defined(BOARD_ADAFRUIT_FEATHER)
-    void uiShowBottleEmptied(ThinkInk_213_Mono_GDEY0213B74& display);
+    void uiShowBottleEmptied(AquavateDisplay& display);
 #endif
 
 #endif // UI_CALIBRATION_H
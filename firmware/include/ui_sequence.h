@@ -0,0 +1,49 @@
+// ui_sequence.h - Non-blocking timed screen holds
+// Part of the Aquavate smart water bottle firmware
+//
+// Info screens (bottle emptied, storage error, calibration result) used to be
+// followed by delay(3000), which stalled sensors, BLE and the sleep timers.
+// Instead the caller draws the screen and starts a hold; uiSequenceUpdate()
+// from loop() runs the completion step (normally a main-screen redraw) once
+// the hold expires. While a hold is active the main loop skips its own display
+// refreshes so the info screen stays up. Only one hold runs at a time - a new
+// hold replaces the pending one, whose step is dropped (each step redraws the
+// whole screen, so the last one wins).
+
+#ifndef UI_SEQUENCE_H
+#define UI_SEQUENCE_H
+
+#include <Arduino.h>
+
+// Completion step, run from loop() when the hold expires
+typedef void (*UiSequenceStep)();
+
+/**
+ * Keep the screen just drawn for hold_ms, then run on_done from loop()
+ * @param hold_ms How long the screen stays up
+ * @param on_done Step to run when the hold expires (nullptr = none)
+ */
+void uiSequenceHold(uint32_t hold_ms, UiSequenceStep on_done);
+
+/**
+ * Run the pending step once its hold has expired (call every loop)
+ */
+void uiSequenceUpdate();
+
+/**
+ * True while a held screen is showing (skip routine display refreshes)
+ */
+bool uiSequenceActive();
+
+/**
+ * Drop the pending hold without running its step (another flow owns the screen)
+ */
+void uiSequenceCancel();
+
+/**
+ * End the pending hold early and run its step now (before sleep, so the
+ * info screen isn't left on the panel)
+ */
+void uiSequenceFinish();
+
+#endif // UI_SEQUENCE_H
@@ -0,0 +1,29 @@
+// wake_stub.h - Deep-sleep wake stub for routine backpack-mode timer wakes
+// Part of the Aquavate smart water bottle firmware
+//
+// esp_wake_deep_sleep() runs from RTC fast memory before the bootloader loads
+// the app. When armed (backpack mode only) and the wake came from the timer, it
+// decides from RTC-resident state alone whether a full boot is needed:
+//   - low battery lockout active           -> boot
+//   - daily rollover passed since sleeping -> boot
+//   - full health check due                -> boot
+// Otherwise it counts the wake, re-arms the RTC timer and re-enters deep sleep
+// within a few hundred microseconds. Tap wake (EXT0) always boots.
+// ESP32 only (register-level sleep re-entry); a no-op on other targets.
+
+#ifndef WAKE_STUB_H
+#define WAKE_STUB_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Arm the stub just before entering backpack-mode deep sleep.
+// interval_sec: timer wake interval already passed to esp_sleep_enable_timer_wakeup()
+// seconds_until_rollover: from getSecondsUntilRollover() (0 = unknown / no time)
+void wakeStubArm(uint32_t interval_sec, uint32_t seconds_until_rollover);
+
+// Disarm at boot. Returns the number of timer wakes the stub handled since
+// the last full boot (for activityStatsAddTimerWakes()).
+uint16_t wakeStubDisarm();
+
+#endif // WAKE_STUB_H
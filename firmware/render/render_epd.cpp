@@ -0,0 +1,472 @@
+/**
+ * Aquavate - Native Display Renderer Shim
+ * Adafruit_GFX / Adafruit_EPD drawing against an in-memory frame buffer.
+ */
+
+#include "Adafruit_ThinkInk.h"
+
+// Adafruit_GFX glcdfont.c, printable ASCII (0x20-0x7E), 5 columns per glyph, LSB = top
+static const uint8_t FONT_FIRST = 0x20;
+static const uint8_t FONT_LAST = 0x7E;
+static const uint8_t FONT[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00,  // ' '
+    0x00, 0x00, 0x5F, 0x00, 0x00,  // !
+    0x00, 0x07, 0x00, 0x07, 0x00,  // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14,  // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,  // $
+    0x23, 0x13, 0x08, 0x64, 0x62,  // %
+    0x36, 0x49, 0x56, 0x20, 0x50,  // &
+    0x00, 0x08, 0x07, 0x03, 0x00,  // '
+    0x00, 0x1C, 0x22, 0x41, 0x00,  // (
+    0x00, 0x41, 0x22, 0x1C, 0x00,  // )
+    0x2A, 0x1C, 0x7F, 0x1C, 0x2A,  // *
+    0x08, 0x08, 0x3E, 0x08, 0x08,  // +
+    0x00, 0x80, 0x70, 0x30, 0x00,  // ,
+    0x08, 0x08, 0x08, 0x08, 0x08,  // -
+    0x00, 0x00, 0x60, 0x60, 0x00,  // .
+    0x20, 0x10, 0x08, 0x04, 0x02,  // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,  // 0
+    0x00, 0x42, 0x7F, 0x40, 0x00,  // 1
+    0x72, 0x49, 0x49, 0x49, 0x46,  // 2
+    0x21, 0x41, 0x49, 0x4D, 0x33,  // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,  // 4
+    0x27, 0x45, 0x45, 0x45, 0x39,  // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x31,  // 6
+    0x41, 0x21, 0x11, 0x09, 0x07,  // 7
+    0x36, 0x49, 0x49, 0x49, 0x36,  // 8
+    0x46, 0x49, 0x49, 0x29, 0x1E,  // 9
+    0x00, 0x00, 0x14, 0x00, 0x00,  // :
+    0x00, 0x40, 0x34, 0x00, 0x00,  // ;
+    0x00, 0x08, 0x14, 0x22, 0x41,  // <
+    0x14, 0x14, 0x14, 0x14, 0x14,  // =
+    0x00, 0x41, 0x22, 0x14, 0x08,  // >
+    0x02, 0x01, 0x59, 0x09, 0x06,  // ?
+    0x3E, 0x41, 0x5D, 0x59, 0x4E,  // @
+    0x7C, 0x12, 0x11, 0x12, 0x7C,  // A
+    0x7F, 0x49, 0x49, 0x49, 0x36,  // B
+    0x3E, 0x41, 0x41, 0x41, 0x22,  // C
+    0x7F, 0x41, 0x41, 0x41, 0x3E,  // D
+    0x7F, 0x49, 0x49, 0x49, 0x41,  // E
+    0x7F, 0x09, 0x09, 0x09, 0x01,  // F
+    0x3E, 0x41, 0x41, 0x51, 0x73,  // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,  // H
+    0x00, 0x41, 0x7F, 0x41, 0x00,  // I
+    0x20, 0x40, 0x41, 0x3F, 0x01,  // J
+    0x7F, 0x08, 0x14, 0x22, 0x41,  // K
+    0x7F, 0x40, 0x40, 0x40, 0x40,  // L
+    0x7F, 0x02, 0x1C, 0x02, 0x7F,  // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,  // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E,  // O
+    0x7F, 0x09, 0x09, 0x09, 0x06,  // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E,  // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,  // R
+    0x26, 0x49, 0x49, 0x49, 0x32,  // S
+    0x03, 0x01, 0x7F, 0x01, 0x03,  // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F,  // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,  // V
+    0x3F, 0x40, 0x38, 0x40, 0x3F,  // W
+    0x63, 0x14, 0x08, 0x14, 0x63,  // X
+    0x03, 0x04, 0x78, 0x04, 0x03,  // Y
+    0x61, 0x59, 0x49, 0x4D, 0x43,  // Z
+    0x00, 0x7F, 0x41, 0x41, 0x41,  // [
+    0x02, 0x04, 0x08, 0x10, 0x20,  // backslash
+    0x00, 0x41, 0x41, 0x41, 0x7F,  // ]
+    0x04, 0x02, 0x01, 0x02, 0x04,  // ^
+    0x40, 0x40, 0x40, 0x40, 0x40,  // _
+    0x00, 0x03, 0x07, 0x08, 0x00,  // `
+    0x20, 0x54, 0x54, 0x78, 0x40,  // a
+    0x7F, 0x28, 0x44, 0x44, 0x38,  // b
+    0x38, 0x44, 0x44, 0x44, 0x28,  // c
+    0x38, 0x44, 0x44, 0x28, 0x7F,  // d
+    0x38, 0x54, 0x54, 0x54, 0x18,  // e
+    0x00, 0x08, 0x7E, 0x09, 0x02,  // f
+    0x18, 0xA4, 0xA4, 0x9C, 0x78,  // g
+    0x7F, 0x08, 0x04, 0x04, 0x78,  // h
+    0x00, 0x44, 0x7D, 0x40, 0x00,  // i
+    0x20, 0x40, 0x40, 0x3D, 0x00,  // j
+    0x7F, 0x10, 0x28, 0x44, 0x00,  // k
+    0x00, 0x41, 0x7F, 0x40, 0x00,  // l
+    0x7C, 0x04, 0x78, 0x04, 0x78,  // m
+    0x7C, 0x08, 0x04, 0x04, 0x78,  // n
+    0x38, 0x44, 0x44, 0x44, 0x38,  // o
+    0xFC, 0x18, 0x24, 0x24, 0x18,  // p
+    0x18, 0x24, 0x24, 0x18, 0xFC,  // q
+    0x7C, 0x08, 0x04, 0x04, 0x08,  // r
+    0x48, 0x54, 0x54, 0x54, 0x24,  // s
+    0x04, 0x04, 0x3F, 0x44, 0x24,  // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C,  // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,  // v
+    0x3C, 0x40, 0x30, 0x40, 0x3C,  // w
+    0x44, 0x28, 0x10, 0x28, 0x44,  // x
+    0x4C, 0x90, 0x90, 0x90, 0x7C,  // y
+    0x44, 0x64, 0x54, 0x4C, 0x44,  // z
+    0x00, 0x08, 0x36, 0x41, 0x00,  // {
+    0x00, 0x00, 0x77, 0x00, 0x00,  // |
+    0x00, 0x41, 0x36, 0x08, 0x00,  // }
+    0x02, 0x01, 0x02, 0x04, 0x02,  // ~
+};
+
+// Gate rows are padded to a whole number of bytes
+static const int16_t BUFFER_ROW_BITS = 128;
+
+template <typename T> static void swapValues(T& a, T& b) {
+    T t = a;
+    a = b;
+    b = t;
+}
+
+ThinkInk_213_Mono_GDEY0213B74::ThinkInk_213_Mono_GDEY0213B74(int16_t dc, int16_t reset, int16_t cs,
+                                                             int16_t sram_cs, int16_t busy, void* spi)
+    : spi_dev(&host_spi), _busy_pin(busy), buffer1(nullptr), buffer1_addr(0), buffer1_size(0),
+      use_sram(false), rotation(0), _width(WIDTH), _height(HEIGHT), cursor_x(0), cursor_y(0),
+      textsize(1), textcolor(EPD_BLACK), textbgcolor(EPD_BLACK), wrap(true),
+      host_ram_plane(0), host_ram_row(0), host_full_refreshes(0), host_master_activations(0) {
+    (void)dc;
+    (void)reset;
+    (void)cs;
+    (void)sram_cs;
+    (void)spi;
+    host_spi.owner = this;
+    buffer1_size = (uint32_t)WIDTH * BUFFER_ROW_BITS / 8;
+    buffer1 = (uint8_t*)malloc(buffer1_size);
+    host_ram[0] = (uint8_t*)malloc(buffer1_size);
+    host_ram[1] = (uint8_t*)malloc(buffer1_size);
+    host_panel = (uint8_t*)malloc(buffer1_size);
+    memset(host_ram[0], 0xFF, buffer1_size);
+    memset(host_ram[1], 0xFF, buffer1_size);
+    memset(host_panel, 0xFF, buffer1_size);
+}
+
+ThinkInk_213_Mono_GDEY0213B74::~ThinkInk_213_Mono_GDEY0213B74() {
+    free(buffer1);
+    free(host_ram[0]);
+    free(host_ram[1]);
+    free(host_panel);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::begin(thinkinkmode_t mode) {
+    (void)mode;
+    clearBuffer();
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::display(bool sleep) {
+    (void)sleep;
+    powerUp();
+    setRAMAddress(0, 0);
+    writeRAMFramebufferToEPD(buffer1, buffer1_size, 0);
+    hostPanelUpdate();
+    host_full_refreshes++;
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::clearBuffer() {
+    memset(buffer1, 0xFF, buffer1_size);   // Black is a 0 bit
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::setRotation(uint8_t r) {
+    rotation = r & 3;
+    bool portrait = (rotation & 1) != 0;
+    _width = portrait ? HEIGHT : WIDTH;
+    _height = portrait ? WIDTH : HEIGHT;
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::writeRAMFramebufferToEPD(uint8_t* buffer, uint32_t buffer_size,
+                                                             uint8_t location, bool invertdata) {
+    writeRAMCommand(location);
+    hostRamWrite(buffer, buffer_size, invertdata);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::writeSRAMFramebufferToEPD(uint16_t sram_addr, uint32_t buffer_size,
+                                                              uint8_t location, bool invertdata) {
+    // The host "SRAM" is buffer1 itself
+    writeRAMFramebufferToEPD(buffer1 + (sram_addr - buffer1_addr), buffer_size, location, invertdata);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::EPD_command(uint8_t c, const uint8_t* buf, uint16_t len) {
+    if (c == 0x4F && len >= 2) {
+        host_ram_row = (uint16_t)(buf[0] | (buf[1] << 8));   // RAM Y (gate row) counter
+    }
+    EPD_command(c);
+}
+
+uint8_t ThinkInk_213_Mono_GDEY0213B74::EPD_command(uint8_t c, bool end) {
+    (void)end;
+    if (c == 0x20) {
+        hostPanelUpdate();           // Master activation = one panel update
+        host_master_activations++;
+    }
+    return 0;
+}
+
+// Controller RAM write from the current gate row (whole rows - X always starts at 0)
+void ThinkInk_213_Mono_GDEY0213B74::hostRamWrite(const uint8_t* data, uint32_t len, bool invert) {
+    uint32_t offset = (uint32_t)host_ram_row * (BUFFER_ROW_BITS / 8);
+    if (offset >= buffer1_size) return;
+    if (len > buffer1_size - offset) len = buffer1_size - offset;
+
+    uint8_t* ram = host_ram[host_ram_plane];
+    for (uint32_t i = 0; i < len; i++) {
+        ram[offset + i] = invert ? (uint8_t)~data[i] : data[i];
+    }
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::hostPanelUpdate() {
+    memcpy(host_panel, host_ram[0], buffer1_size);
+}
+
+// Adafruit_EPD::drawPixel mapping: rotate into panel coordinates, then
+// byte ((WIDTH - 1 - x) * 128 + y) / 8, bit 7 - y % 8
+bool ThinkInk_213_Mono_GDEY0213B74::bufferBit(int16_t x, int16_t y, uint32_t& addr, uint8_t& mask) const {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) {
+        return false;
+    }
+
+    switch (rotation) {
+    case 1:
+        swapValues(x, y);
+        x = WIDTH - x - 1;
+        break;
+    case 2:
+        x = WIDTH - x - 1;
+        y = HEIGHT - y - 1;
+        break;
+    case 3:
+        swapValues(x, y);
+        y = HEIGHT - y - 1;
+        break;
+    }
+
+    addr = ((uint32_t)(WIDTH - 1 - x) * BUFFER_ROW_BITS + y) / 8;
+    mask = (uint8_t)(1 << (7 - y % 8));
+    return true;
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    uint32_t addr;
+    uint8_t mask;
+    if (!bufferBit(x, y, addr, mask)) {
+        return;
+    }
+
+    if (color == EPD_WHITE) {
+        buffer1[addr] |= mask;
+    } else {
+        buffer1[addr] &= ~mask;
+    }
+}
+
+bool ThinkInk_213_Mono_GDEY0213B74::hostGetPixel(int16_t x, int16_t y) const {
+    uint32_t addr;
+    uint8_t mask;
+    if (!bufferBit(x, y, addr, mask)) {
+        return false;
+    }
+    return (buffer1[addr] & mask) == 0;
+}
+
+bool ThinkInk_213_Mono_GDEY0213B74::hostPanelPixel(int16_t x, int16_t y) const {
+    uint32_t addr;
+    uint8_t mask;
+    if (!bufferBit(x, y, addr, mask)) {
+        return false;
+    }
+    return (host_panel[addr] & mask) == 0;
+}
+
+// Adafruit_GFX::writeLine (Bresenham)
+void ThinkInk_213_Mono_GDEY0213B74::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                              uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        swapValues(x0, y0);
+        swapValues(x1, y1);
+    }
+    if (x0 > x1) {
+        swapValues(x0, x1);
+        swapValues(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            drawPixel(y0, x0, color);
+        } else {
+            drawPixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                             uint16_t color) {
+    if (x0 == x1) {
+        if (y0 > y1) swapValues(y0, y1);
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    } else if (y0 == y1) {
+        if (x0 > x1) swapValues(x0, x1);
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    } else {
+        writeLine(x0, y0, x1, y1, color);
+    }
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeLine(x, y, x, y + h - 1, color);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeLine(x, y, x + w - 1, y, color);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) {
+        drawFastVLine(i, y, h, color);
+    }
+}
+
+// Adafruit_GFX::fillCircleHelper
+void ThinkInk_213_Mono_GDEY0213B74::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                                                     int16_t delta, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        if (x < (y + 1)) {
+            if (corners & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+            if (corners & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+        }
+        if (y != px) {
+            if (corners & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+            if (corners & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                                  uint16_t color) {
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius) r = max_radius;
+
+    fillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+}
+
+void ThinkInk_213_Mono_GDEY0213B74::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap,
+                                               int16_t w, int16_t h, uint16_t color) {
+    int16_t row_bytes = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * row_bytes + i / 8] & (0x80 >> (i & 7))) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+// Adafruit_GFX::drawChar, classic font
+void ThinkInk_213_Mono_GDEY0213B74::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                                             uint16_t bg, uint8_t size) {
+    if (x >= _width || y >= _height || (x + 6 * size - 1) < 0 || (y + 8 * size - 1) < 0) {
+        return;
+    }
+
+    bool known = (c >= FONT_FIRST && c <= FONT_LAST);
+    for (int8_t i = 0; i < 5; i++) {
+        uint8_t line = known ? FONT[(c - FONT_FIRST) * 5 + i] : 0;
+        for (int8_t j = 0; j < 8; j++, line >>= 1) {
+            if (line & 1) {
+                if (size == 1) drawPixel(x + i, y + j, color);
+                else fillRect(x + i * size, y + j * size, size, size, color);
+            } else if (bg != color) {
+                if (size == 1) drawPixel(x + i, y + j, bg);
+                else fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+    }
+    if (bg != color) {
+        if (size == 1) drawFastVLine(x + 5, y, 8, bg);
+        else fillRect(x + 5 * size, y, size, 8 * size, bg);
+    }
+}
+
+// Adafruit_GFX::write, classic font
+size_t ThinkInk_213_Mono_GDEY0213B74::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize * 8;
+    } else if (c != '\r') {
+        if (wrap && ((cursor_x + textsize * 6) > _width)) {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+        cursor_x += textsize * 6;
+    }
+    return 1;
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(const char* s) {
+    size_t n = 0;
+    while (*s) {
+        n += write((uint8_t)*s++);
+    }
+    return n;
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(int v) {
+    return print((long)v);
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(unsigned int v) {
+    return print((unsigned long)v);
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(long v) {
+    char text[24];
+    snprintf(text, sizeof(text), "%ld", v);
+    return print(text);
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(unsigned long v) {
+    char text[24];
+    snprintf(text, sizeof(text), "%lu", v);
+    return print(text);
+}
+
+size_t ThinkInk_213_Mono_GDEY0213B74::print(double v, int digits) {
+    char text[40];
+    snprintf(text, sizeof(text), "%.*f", digits, v);
+    return print(text);
+}
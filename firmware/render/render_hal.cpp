@@ -0,0 +1,120 @@
+/**
+ * Aquavate - Native Display Renderer HAL
+ * Virtual clock, Serial sink and the firmware globals/services that
+ * display.cpp and ui_calibration.cpp link against.
+ */
+
+#include "render_hal.h"
+#include "config.h"
+#include "power_mgmt.h"
+#include "ui_sequence.h"
+#include "device_context.h"
+#include "activity_stats.h"
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
+#include <time.h>
+
+// ==================== Firmware globals (normally in main.cpp) ====================
+
+bool g_debug_enabled = false;
+bool g_debug_display = false;
+bool g_time_valid = true;
+bool g_calibrated = true;
+uint8_t g_daily_intake_display_mode = DAILY_INTAKE_DISPLAY_MODE;
+
+ReplaySerial Serial;
+
+static uint8_t g_battery_percent = 100;
+
+void renderSetBatteryPercent(uint8_t percent) {
+    g_battery_percent = percent;
+}
+
+// ==================== Virtual clock ====================
+
+static uint32_t g_millis = 0;
+static uint32_t g_epoch_seconds = 0;
+static uint32_t g_epoch_base_ms = 0;
+
+uint32_t millis() {
+    return g_millis;
+}
+
+uint32_t micros() {
+    return g_millis * 1000;
+}
+
+void delay(uint32_t ms) {
+    g_millis += ms;
+}
+
+void replaySetMillis(uint32_t ms) {
+    g_millis = ms;
+}
+
+void replaySetEpoch(uint32_t epoch_seconds) {
+    g_epoch_seconds = epoch_seconds;
+    g_epoch_base_ms = g_millis;
+}
+
+int replayGettimeofday(struct timeval* tv, void* tz) {
+    (void)tz;
+    uint32_t elapsed_ms = g_millis - g_epoch_base_ms;
+    tv->tv_sec = g_epoch_seconds + elapsed_ms / 1000;
+    tv->tv_usec = (elapsed_ms % 1000) * 1000;
+    return 0;
+}
+
+// ==================== Device services ====================
+
+// Local time = virtual wall clock (UTC, no timezone offset)
+bool deviceContextLocalTime(struct tm& out) {
+    if (!g_time_valid) {
+        return false;
+    }
+    struct timeval tv;
+    replayGettimeofday(&tv, nullptr);
+    time_t now = tv.tv_sec;
+    gmtime_r(&now, &out);
+    return true;
+}
+
+uint8_t deviceContextBatteryPercent() {
+    return g_battery_percent;
+}
+
+void powerMgmtAcquire(PowerLock lock) {
+    (void)lock;
+}
+
+void powerMgmtRelease(PowerLock lock) {
+    (void)lock;
+}
+
+// The renderer captures each screen as soon as it is drawn - follow-up steps don't run
+void uiSequenceHold(uint32_t hold_ms, UiSequenceStep on_done) {
+    (void)hold_ms;
+    (void)on_done;
+}
+
+#if ENABLE_ENERGY_LEDGER
+void energyLedgerAddOverlay(EnergyOverlay overlay, uint32_t duration_us) {
+    (void)overlay;
+    (void)duration_us;
+}
+#endif
+
+// Refresh counts are the firmware's activity stats - nothing to keep on the host
+void activityStatsRecordDisplayRefresh(bool partial) {
+    (void)partial;
+}
+
+void activityStatsRecordDisplayDeferred() {
+}
+
+uint8_t activityStatsGetDisplayDays(DisplayRefreshDay* buffer, uint8_t max_count) {
+    (void)buffer;
+    (void)max_count;
+    return 0;
+}
@@ -0,0 +1,20 @@
+/**
+ * Aquavate - Native Display Renderer HAL
+ * Host-side replacements for the globals and services display.cpp and
+ * ui_calibration.cpp link against (see render_hal.cpp).
+ */
+
+#ifndef RENDER_HAL_H
+#define RENDER_HAL_H
+
+#include <Arduino.h>
+
+// Firmware globals normally owned by main.cpp
+extern bool g_time_valid;
+extern bool g_calibrated;
+extern uint8_t g_daily_intake_display_mode;
+
+// Raw battery percent returned by deviceContextBatteryPercent()
+void renderSetBatteryPercent(uint8_t percent);
+
+#endif // RENDER_HAL_H
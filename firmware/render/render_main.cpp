@@ -0,0 +1,399 @@
+/**
+ * Aquavate - Native Display Renderer
+ *
+ * Renders the real display.cpp / ui_calibration.cpp screens on the host against
+ * an in-memory Adafruit_GFX/EPD shim (render/shims) and checks them pixel for
+ * pixel against golden PBM images, with host CPU time per render.
+ *
+ * Every screen is rendered twice - with the packed raster/sprite path (frame
+ * buffer in RAM) and with the plain Adafruit_GFX fallback (SPI SRAM build) -
+ * and the two must match each other and the golden. A sequence of main-screen
+ * updates is then replayed through the partial-refresh path and the image that
+ * reaches the (simulated) panel after every step is compared with a full render
+ * of the same frame.
+ *
+ * Build & run (from firmware/):
+ *   pio run -e native_display
+ *   .pio/build/native_display/program [options]
+ *
+ * Options:
+ *   --golden DIR     Golden image directory (default render/golden)
+ *   --update         Write the golden images instead of comparing
+ *   --out DIR        Also write every rendered image to DIR
+ *   --iterations N   Timed renders per screen and path (default 20)
+ *   --verbose        Pass firmware Serial output through to stdout
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include "render_hal.h"
+#include "config.h"
+#include "display.h"
+#include "ui_calibration.h"
+
+#define RENDER_WIDTH        250
+#define RENDER_HEIGHT       122
+#define RENDER_ROW_BYTES    ((RENDER_WIDTH + 7) / 8)
+#define RENDER_EPOCH        1767796200  // Wed 2026-01-07 14:30:00 UTC ("Wed 2pm")
+
+struct RenderOptions {
+    std::string golden_dir = "render/golden";
+    std::string out_dir;
+    bool update = false;
+    int iterations = 20;
+};
+
+// PBM (P4) pixel rows, 1 = black
+typedef std::vector<uint8_t> Image;
+
+struct MainInputs {
+    float water_ml;
+    uint16_t daily_ml;
+    uint8_t battery_percent;
+};
+
+struct ScreenCase {
+    std::string name;
+    std::function<void()> draw;
+};
+
+struct Timing {
+    double mean_us = 0.0;
+    double min_us = 0.0;
+};
+
+// Same panel, two frame buffer builds: RAM (raster + sprites) and SPI SRAM (GFX only)
+static AquavateDisplay g_epd_raster(EPD_DC, EPD_RESET, EPD_CS, -1, EPD_BUSY);
+static AquavateDisplay g_epd_gfx(EPD_DC, EPD_RESET, EPD_CS, -1, EPD_BUSY);
+static AquavateDisplay* g_epd = nullptr;
+
+static const uint16_t DAILY_GOAL_ML = 2500;
+
+// ==================== Display control ====================
+
+static void selectDisplay(AquavateDisplay& epd) {
+    g_epd = &epd;
+    displayInit(epd);
+    displaySetDailyGoal(DAILY_GOAL_ML);
+    uiCalibrationInit(epd);
+}
+
+// Push a blank frame so the next main screen is a full render
+static void invalidatePanel() {
+    g_epd->clearBuffer();
+    displayPushBuffer(*g_epd);
+}
+
+static void drawMain(const MainInputs& in, bool force) {
+    if (force) {
+        displayForceUpdate(in.water_ml, in.daily_ml, 14, 30, in.battery_percent, false);
+    } else {
+        displayUpdate(in.water_ml, in.daily_ml, 14, 30, in.battery_percent, false);
+    }
+}
+
+static Image capture(bool panel) {
+    Image img(RENDER_ROW_BYTES * RENDER_HEIGHT, 0);
+    for (int16_t y = 0; y < RENDER_HEIGHT; y++) {
+        for (int16_t x = 0; x < RENDER_WIDTH; x++) {
+            bool black = panel ? g_epd->hostPanelPixel(x, y) : g_epd->hostGetPixel(x, y);
+            if (black) {
+                img[y * RENDER_ROW_BYTES + x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+    return img;
+}
+
+static uint32_t pixelsDiffering(const Image& a, const Image& b) {
+    if (a.size() != b.size()) return RENDER_WIDTH * RENDER_HEIGHT;
+    uint32_t count = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        count += __builtin_popcount(a[i] ^ b[i]);
+    }
+    return count;
+}
+
+// ==================== PBM files ====================
+
+static bool writePbm(const std::string& path, const Image& img) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        fprintf(stderr, "ERROR: Cannot write %s\n", path.c_str());
+        return false;
+    }
+    fprintf(f, "P4\n%d %d\n", RENDER_WIDTH, RENDER_HEIGHT);
+    fwrite(img.data(), 1, img.size(), f);
+    fclose(f);
+    return true;
+}
+
+static bool readPbm(const std::string& path, Image& img) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    int width = 0;
+    int height = 0;
+    bool ok = fscanf(f, "P4 %d %d", &width, &height) == 2 &&
+              width == RENDER_WIDTH && height == RENDER_HEIGHT && fgetc(f) != EOF;
+    if (ok) {
+        img.assign(RENDER_ROW_BYTES * RENDER_HEIGHT, 0);
+        ok = fread(img.data(), 1, img.size(), f) == img.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+// ==================== Cases ====================
+
+static std::string mainCaseName(const MainInputs& in, uint8_t mode, bool time_valid) {
+    char name[64];
+    snprintf(name, sizeof(name), "main_m%u_w%d_d%u_b%u%s", mode, (int)in.water_ml, in.daily_ml,
+             in.battery_percent, time_valid ? "" : "_notime");
+    return name;
+}
+
+static void addMainCase(std::vector<ScreenCase>& cases, const MainInputs& in, uint8_t mode,
+                        bool time_valid) {
+    std::string name = mainCaseName(in, mode, time_valid);
+    for (const ScreenCase& c : cases) {
+        if (c.name == name) return;
+    }
+    cases.push_back({name, [in, mode, time_valid]() {
+        g_daily_intake_display_mode = mode;
+        g_time_valid = time_valid;
+        drawMain(in, true);
+    }});
+}
+
+static std::vector<ScreenCase> buildCases() {
+    std::vector<ScreenCase> cases;
+
+    // Main screen: one axis at a time around a mid-day frame, for both intake modes
+    const MainInputs base = { 415.0f, 1250, 60 };
+    const float water[] = { -80.0f, 0.0f, 150.0f, 415.0f, 700.0f, 830.0f, 900.0f };
+    const uint16_t daily[] = { 0, 380, 1250, 2490, 2500, 3200, 10000 };
+    const uint8_t battery[] = { 0, 20, 40, 60, 80, 100 };
+
+    for (uint8_t mode = 0; mode <= 1; mode++) {
+        for (float w : water) addMainCase(cases, { w, base.daily_ml, base.battery_percent }, mode, true);
+        for (uint16_t d : daily) addMainCase(cases, { base.water_ml, d, base.battery_percent }, mode, true);
+        for (uint8_t b : battery) addMainCase(cases, { base.water_ml, base.daily_ml, b }, mode, true);
+        addMainCase(cases, base, mode, false);
+    }
+
+    // Other screens
+    cases.push_back({"backpack_mode", []() { displayBackpackMode(); }});
+    cases.push_back({"low_battery", []() { displayLowBattery(); }});
+    cases.push_back({"tap_wake", []() { displayTapWakeFeedback(); }});
+    cases.push_back({"nvs_warning", []() { displayNVSWarning(); }});
+
+    // Calibration wizard
+    cases.push_back({"cal_start", []() { uiCalibrationShowStart(); }});
+    cases.push_back({"cal_started", []() { uiCalibrationShowStarted(); }});
+    cases.push_back({"cal_empty_prompt", []() { uiCalibrationShowEmptyPrompt(); }});
+    cases.push_back({"cal_full_prompt", []() { uiCalibrationShowFullPrompt(); }});
+    cases.push_back({"cal_measuring_empty", []() { uiCalibrationShowMeasuringEmpty(); }});
+    cases.push_back({"cal_empty_confirm", []() { uiCalibrationShowEmptyConfirm(84213); }});
+    cases.push_back({"cal_fill_bottle", []() { uiCalibrationShowFillBottle(); }});
+    cases.push_back({"cal_measuring_full", []() { uiCalibrationShowMeasuringFull(); }});
+    cases.push_back({"cal_full_confirm", []() { uiCalibrationShowFullConfirm(442917); }});
+    cases.push_back({"cal_complete", []() { uiCalibrationShowComplete(431.6f); }});
+    cases.push_back({"cal_error", []() { uiCalibrationShowError("unstable weight"); }});
+    cases.push_back({"cal_error_long", []() { uiCalibrationShowError("scale factor out of range"); }});
+    cases.push_back({"cal_aborted", []() { uiCalibrationShowAborted(); }});
+    cases.push_back({"bottle_emptied", []() { uiShowBottleEmptied(*g_epd); }});
+
+    return cases;
+}
+
+// A drinking session: levels fall, the daily total climbs, the battery steps down.
+// Repeats and sub-threshold changes exercise the skip path; the length runs past
+// the partial-refresh ghosting budget.
+static const MainInputs SEQUENCE[] = {
+    { 830.0f,    0, 100 },
+    { 830.0f,    0, 100 },
+    { 700.0f,  130, 100 },
+    { 560.0f,  270,  80 },
+    { 558.0f,  270,  80 },
+    { 400.0f,  430,  80 },
+    { 250.0f,  580,  60 },
+    { -80.0f,  580,  60 },
+    { 830.0f,  580,  60 },
+    { 600.0f,  810,  40 },
+    { 450.0f,  960,  40 },
+    { 300.0f, 1110,  20 },
+    { 150.0f, 1260,  20 },
+    {   0.0f, 1410,  20 },
+    { 830.0f, 1410,  20 },
+    { 500.0f, 2500,   0 },
+};
+
+// ==================== Runs ====================
+
+static Image renderTimed(const ScreenCase& c, int iterations, Timing& timing) {
+    double total = 0.0;
+    double best = 0.0;
+    for (int i = 0; i < iterations; i++) {
+        invalidatePanel();
+        auto start = std::chrono::steady_clock::now();
+        c.draw();
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        total += us;
+        if (i == 0 || us < best) best = us;
+    }
+    timing.mean_us = total / iterations;
+    timing.min_us = best;
+    return capture(true);
+}
+
+static int runScreens(const RenderOptions& opts, Timing& raster_total, Timing& gfx_total) {
+    std::vector<ScreenCase> cases = buildCases();
+    int failures = 0;
+
+    printf("%-34s %18s %18s  %s\n", "screen", "raster us (min)", "gfx us (min)", "result");
+    for (const ScreenCase& c : cases) {
+        Timing raster_time;
+        Timing gfx_time;
+
+        selectDisplay(g_epd_raster);
+        Image raster = renderTimed(c, opts.iterations, raster_time);
+        bool buffer_ok = pixelsDiffering(raster, capture(false)) == 0;
+
+        selectDisplay(g_epd_gfx);
+        Image gfx = renderTimed(c, opts.iterations, gfx_time);
+
+        raster_total.mean_us += raster_time.mean_us;
+        raster_total.min_us += raster_time.min_us;
+        gfx_total.mean_us += gfx_time.mean_us;
+        gfx_total.min_us += gfx_time.min_us;
+
+        std::string result = "ok";
+        uint32_t path_diff = pixelsDiffering(raster, gfx);
+        std::string golden_path = opts.golden_dir + "/" + c.name + ".pbm";
+
+        if (!buffer_ok) {
+            result = "FAIL panel != frame buffer";
+        } else if (path_diff != 0) {
+            result = "FAIL raster/gfx differ by " + std::to_string(path_diff) + " px";
+        } else if (opts.update) {
+            result = writePbm(golden_path, raster) ? "updated" : "FAIL write";
+        } else {
+            Image golden;
+            if (!readPbm(golden_path, golden)) {
+                result = "FAIL no golden (run with --update)";
+            } else {
+                uint32_t golden_diff = pixelsDiffering(raster, golden);
+                if (golden_diff != 0) {
+                    result = "FAIL differs from golden by " + std::to_string(golden_diff) + " px";
+                }
+            }
+        }
+        if (!opts.out_dir.empty()) {
+            writePbm(opts.out_dir + "/" + c.name + ".pbm", raster);
+            if (path_diff != 0) {
+                writePbm(opts.out_dir + "/" + c.name + ".gfx.pbm", gfx);
+            }
+        }
+        if (result.compare(0, 4, "FAIL") == 0) {
+            failures++;
+        }
+
+        printf("%-34s %9.1f (%6.1f) %9.1f (%6.1f)  %s\n", c.name.c_str(),
+               raster_time.mean_us, raster_time.min_us, gfx_time.mean_us, gfx_time.min_us,
+               result.c_str());
+    }
+    return failures;
+}
+
+// Replay SEQUENCE through the normal update path (partials, skips, ghosting
+// full refreshes) and check the panel against a full render after each step
+static int runSequence(AquavateDisplay& epd, const char* path_name, uint8_t mode) {
+    const size_t steps = sizeof(SEQUENCE) / sizeof(SEQUENCE[0]);
+    selectDisplay(epd);
+    g_daily_intake_display_mode = mode;
+    g_time_valid = true;
+
+    std::vector<Image> reference;
+    for (size_t i = 0; i < steps; i++) {
+        invalidatePanel();
+        drawMain(SEQUENCE[i], true);
+        reference.push_back(capture(true));
+    }
+
+    invalidatePanel();
+    uint32_t full_before = epd.hostFullRefreshes();
+    uint32_t partial_before = epd.hostMasterActivations();
+    int failures = 0;
+
+    for (size_t i = 0; i < steps; i++) {
+        drawMain(SEQUENCE[i], i == 0);
+        uint32_t diff = pixelsDiffering(capture(true), reference[i]);
+        if (diff != 0) {
+            printf("  step %zu: panel differs from full render by %u px\n", i, diff);
+            failures++;
+        }
+    }
+
+    printf("sequence m%u %-6s %zu steps: %u full, %u partial refreshes - %s\n", mode, path_name, steps,
+           epd.hostFullRefreshes() - full_before, epd.hostMasterActivations() - partial_before,
+           failures ? "FAIL" : "ok");
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    // Firmware treats gettimeofday()/mktime() as UTC (ESP32 default)
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    RenderOptions opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--golden" && i + 1 < argc) {
+            opts.golden_dir = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            opts.out_dir = argv[++i];
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            opts.iterations = atoi(argv[++i]);
+        } else if (arg == "--update") {
+            opts.update = true;
+        } else if (arg == "--verbose") {
+            Serial.enabled = true;
+        } else {
+            fprintf(stderr, "usage: %s [--golden DIR] [--update] [--out DIR] [--iterations N] "
+                            "[--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opts.iterations < 1) opts.iterations = 1;
+    if (opts.update) mkdir(opts.golden_dir.c_str(), 0755);
+    if (!opts.out_dir.empty()) mkdir(opts.out_dir.c_str(), 0755);
+
+    replaySetEpoch(RENDER_EPOCH);
+    for (AquavateDisplay* epd : { &g_epd_raster, &g_epd_gfx }) {
+        epd->begin(THINKINK_MONO);
+        epd->setRotation(2);  // As mounted (main.cpp)
+    }
+    g_epd_gfx.hostSetSramFramebuffer(true);
+
+    Timing raster_total;
+    Timing gfx_total;
+    int failures = runScreens(opts, raster_total, gfx_total);
+    printf("%-34s %9.1f (%6.1f) %9.1f (%6.1f)\n\n", "TOTAL",
+           raster_total.mean_us, raster_total.min_us, gfx_total.mean_us, gfx_total.min_us);
+
+    for (uint8_t mode = 0; mode <= 1; mode++) {
+        failures += runSequence(g_epd_raster, "raster", mode);
+        failures += runSequence(g_epd_gfx, "gfx", mode);
+    }
+
+    if (failures) {
+        printf("\n%d FAILURE(S)\n", failures);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * Aquavate - Native Display Renderer Shim
+ * In-memory stand-in for the Adafruit EPD driver + Adafruit_GFX drawing API.
+ *
+ * Only the parts display.cpp and ui_calibration.cpp use. Drawing follows the
+ * Adafruit_GFX algorithms (writeLine, fillRect as vertical lines, fillRoundRect,
+ * the classic 5x7 font with wrap) and the Adafruit_EPD pixel-to-buffer mapping
+ * of the GDEY0213B74 (250x122, 128-bit gate rows, black = 0 bit), so the frame
+ * buffer bytes match the device and rasterProbe() finds the same layout.
+ *
+ * The controller is modelled just far enough to check what reaches the glass:
+ * writes land in its new/old-image RAM at the current gate row, and each
+ * update (display() or master activation 0x20) copies the new-image RAM to
+ * the panel. Other commands are ignored.
+ */
+
+#ifndef ADAFRUIT_THINKINK_H
+#define ADAFRUIT_THINKINK_H
+
+#include <Arduino.h>
+
+#define EPD_WHITE   0
+#define EPD_BLACK   1
+#define EPD_RED     2
+#define EPD_GRAY    3
+#define EPD_DARK    4
+#define EPD_LIGHT   5
+
+typedef enum {
+    THINKINK_MONO,
+    THINKINK_TRICOLOR,
+    THINKINK_GRAYSCALE4,
+} thinkinkmode_t;
+
+class ThinkInk_213_Mono_GDEY0213B74 {
+public:
+    ThinkInk_213_Mono_GDEY0213B74(int16_t dc, int16_t reset, int16_t cs, int16_t sram_cs,
+                                  int16_t busy, void* spi = nullptr);
+    virtual ~ThinkInk_213_Mono_GDEY0213B74();
+
+    void begin(thinkinkmode_t mode = THINKINK_MONO);
+    void display(bool sleep = false);
+    void clearBuffer();
+
+    void setRotation(uint8_t r);
+    uint8_t getRotation() const { return rotation; }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextSize(uint8_t s) { textsize = (s > 0) ? s : 1; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextWrap(bool w) { wrap = w; }
+    size_t write(uint8_t c);
+    size_t print(const char* s);
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v);
+    size_t print(unsigned int v);
+    size_t print(long v);
+    size_t print(unsigned long v);
+    size_t print(double v, int digits = 2);
+
+    // ---- Host-only ----
+    // Pixel at drawing coordinates (after rotation): true = black
+    bool hostGetPixel(int16_t x, int16_t y) const;      // Frame buffer
+    bool hostPanelPixel(int16_t x, int16_t y) const;    // What the panel shows
+    // Behave like the SPI SRAM frame buffer build (no direct buffer access for rasterProbe)
+    void hostSetSramFramebuffer(bool sram) { use_sram = sram; }
+    uint32_t hostFullRefreshes() const { return host_full_refreshes; }
+    uint32_t hostMasterActivations() const { return host_master_activations; }
+
+protected:
+    const int16_t WIDTH = 250;          // Panel in rotation 0
+    const int16_t HEIGHT = 122;
+
+    virtual void powerUp() {}
+    virtual void busy_wait() {}
+    void setRAMAddress(uint16_t x, uint16_t y) { (void)x; host_ram_row = y; }
+    virtual void writeRAMFramebufferToEPD(uint8_t* buffer, uint32_t buffer_size,
+                                          uint8_t location, bool invertdata = false);
+    void writeSRAMFramebufferToEPD(uint16_t sram_addr, uint32_t buffer_size,
+                                   uint8_t location, bool invertdata = false);
+    virtual uint8_t writeRAMCommand(uint8_t ram) { host_ram_plane = ram ? 1 : 0; return 0; }
+    void dcHigh() {}
+    void csHigh() {}
+    void EPD_command(uint8_t c, const uint8_t* buf, uint16_t len);
+    uint8_t EPD_command(uint8_t c, bool end = true);
+
+    // Adafruit_SPIDevice stand-in: data bytes go to the selected controller RAM
+    struct HostSPIDevice {
+        ThinkInk_213_Mono_GDEY0213B74* owner;
+        bool write(const uint8_t* buffer, size_t len,
+                   const uint8_t* prefix = nullptr, size_t prefix_len = 0) {
+            (void)prefix;
+            (void)prefix_len;
+            owner->hostRamWrite(buffer, len, false);
+            return true;
+        }
+    };
+    HostSPIDevice* spi_dev;
+
+    int16_t _busy_pin;
+    uint8_t* buffer1;
+    uint16_t buffer1_addr;
+    uint32_t buffer1_size;
+    bool use_sram;
+
+private:
+    void hostRamWrite(const uint8_t* data, uint32_t len, bool invert);
+    void hostPanelUpdate();
+
+    void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                          int16_t delta, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+    bool bufferBit(int16_t x, int16_t y, uint32_t& addr, uint8_t& mask) const;
+
+    HostSPIDevice host_spi;
+    uint8_t rotation;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint8_t textsize;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    bool wrap;
+    uint8_t* host_ram[2];           // Controller new-image (0x24) and old-image (0x26) RAM
+    uint8_t* host_panel;
+    uint8_t host_ram_plane;
+    uint16_t host_ram_row;
+    uint32_t host_full_refreshes;
+    uint32_t host_master_activations;
+};
+
+#endif // ADAFRUIT_THINKINK_H
@@ -0,0 +1,30 @@
+/**
+ * Aquavate - Native Display Renderer Shim
+ * FreeRTOS types for display.cpp. There are no tasks on the host: task
+ * creation fails, so display.cpp renders inline on the caller.
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef void* TaskHandle_t;
+typedef void* QueueHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+typedef struct { int unused; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    {0}
+#define taskENTER_CRITICAL(mux)         (void)(mux)
+#define taskEXIT_CRITICAL(mux)          (void)(mux)
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       0xFFFFFFFFUL
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+
+#endif // FREERTOS_H
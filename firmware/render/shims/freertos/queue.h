@@ -0,0 +1,35 @@
+/**
+ * Aquavate - Native Display Renderer Shim
+ * Queues are never created on the host (see FreeRTOS.h).
+ */
+
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    (void)length;
+    (void)item_size;
+    return nullptr;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait) {
+    (void)queue;
+    (void)item;
+    (void)wait;
+    return pdFALSE;
+}
+
+inline BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item) {
+    (void)queue;
+    (void)item;
+    return pdFALSE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    (void)queue;
+    return 0;
+}
+
+#endif // FREERTOS_QUEUE_H
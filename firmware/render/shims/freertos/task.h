@@ -0,0 +1,30 @@
+/**
+ * Aquavate - Native Display Renderer Shim
+ * Task creation always fails on the host (see FreeRTOS.h).
+ */
+
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                          void* param, UBaseType_t priority,
+                                          TaskHandle_t* handle, BaseType_t core) {
+    (void)fn;
+    (void)name;
+    (void)stack;
+    (void)param;
+    (void)priority;
+    (void)core;
+    if (handle) *handle = nullptr;
+    return pdFAIL;
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+    (void)ticks;
+}
+
+#endif // FREERTOS_TASK_H
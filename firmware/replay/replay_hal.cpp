@@ -0,0 +1,196 @@
+/**
+ * Aquavate - Native Replay HAL
+ * Virtual clock, Serial sink, fake sensors and in-memory storage.
+ */
+
+#include "replay_hal.h"
+#include "weight.h"
+#include "display.h"
+#include "config.h"
+#include "sleep_scheduler.h"
+#include <vector>
+
+// ==================== Firmware globals (normally in main.cpp) ====================
+
+bool g_debug_enabled = false;
+bool g_debug_water_level = false;
+bool g_debug_accelerometer = false;
+bool g_debug_display = false;
+bool g_debug_drink_tracking = false;
+bool g_debug_calibration = false;
+bool g_debug_ble = false;
+uint8_t g_daily_intake_display_mode = DAILY_INTAKE_DISPLAY_MODE;
+
+int8_t g_timezone_offset = 0;
+bool g_time_valid = true;
+bool g_rtc_ds3231_present = true;  // Skips per-drink time save to NVS
+
+ReplaySerial Serial;
+Adafruit_ADXL343 g_replay_adxl(12345);
+Adafruit_NAU7802 nau;
+
+// ==================== Virtual clock ====================
+
+static uint32_t g_millis = 0;
+static uint32_t g_epoch_seconds = 0;
+static uint32_t g_epoch_base_ms = 0;
+
+uint32_t millis() {
+    return g_millis;
+}
+
+uint32_t micros() {
+    return g_millis * 1000;
+}
+
+void delay(uint32_t ms) {
+    g_millis += ms;
+}
+
+void replaySetMillis(uint32_t ms) {
+    g_millis = ms;
+}
+
+// Wall clock = epoch set at session start + millis elapsed since then
+void replaySetEpoch(uint32_t epoch_seconds) {
+    g_epoch_seconds = epoch_seconds;
+    g_epoch_base_ms = g_millis;
+}
+
+int replayGettimeofday(struct timeval* tv, void* tz) {
+    (void)tz;
+    uint32_t elapsed_ms = g_millis - g_epoch_base_ms;
+    tv->tv_sec = g_epoch_seconds + elapsed_ms / 1000;
+    tv->tv_usec = (elapsed_ms % 1000) * 1000;
+    return 0;
+}
+
+// ==================== In-memory storage ====================
+
+static std::vector<DrinkRecord> g_records;   // Logical order, oldest first
+static CircularBufferMetadata g_meta;
+static DailyState g_stored_daily_state;
+static bool g_has_daily_state = false;
+static CalibrationData g_stored_cal;
+static bool g_has_cal = false;
+
+void replayStorageReset() {
+    g_records.clear();
+    memset(&g_meta, 0, sizeof(g_meta));
+    g_meta.next_record_id = 1;
+    memset(&g_stored_daily_state, 0, sizeof(g_stored_daily_state));
+    g_has_daily_state = false;
+    g_stored_cal = storageGetEmptyCalibration();
+    g_has_cal = false;
+}
+
+void replayStorageSetCalibration(const CalibrationData& cal) {
+    g_stored_cal = cal;
+    g_has_cal = true;
+}
+
+void replayStorageSetDailyState(const DailyState& state) {
+    g_stored_daily_state = state;
+    g_has_daily_state = true;
+}
+
+bool storageSaveCalibration(const CalibrationData& cal) {
+    replayStorageSetCalibration(cal);
+    return true;
+}
+
+bool storageLoadCalibration(CalibrationData& cal) {
+    cal = g_stored_cal;
+    return g_has_cal && cal.calibration_valid;
+}
+
+CalibrationData storageGetEmptyCalibration() {
+    CalibrationData cal;
+    cal.scale_factor = 0.0f;
+    cal.empty_bottle_adc = 0;
+    cal.full_bottle_adc = 0;
+    cal.calibration_timestamp = 0;
+    cal.calibration_valid = 0;
+    return cal;
+}
+
+bool storageSaveLastBootTime(uint32_t timestamp) {
+    (void)timestamp;
+    return true;
+}
+
+bool storageSaveDrinkRecord(const DrinkRecord& record) {
+    DrinkRecord stored = record;
+    stored.record_id = g_meta.next_record_id++;
+    if (g_records.size() >= DRINK_MAX_RECORDS) {
+        g_records.erase(g_records.begin());
+    }
+    g_records.push_back(stored);
+    g_meta.record_count = g_records.size();
+    g_meta.write_index = g_records.size() % DRINK_MAX_RECORDS;
+    g_meta.total_writes++;
+    return true;
+}
+
+bool storageLoadBufferMetadata(CircularBufferMetadata& meta) {
+    meta = g_meta;
+    return true;
+}
+
+bool storageSaveBufferMetadata(const CircularBufferMetadata& meta) {
+    g_meta = meta;
+    if (meta.record_count < g_records.size()) {
+        g_records.resize(meta.record_count);
+    }
+    return true;
+}
+
+bool storageGetDrinkRecord(uint16_t index, DrinkRecord& record) {
+    if (index >= g_records.size()) {
+        return false;
+    }
+    record = g_records[index];
+    return true;
+}
+
+bool storageMarkDeleted(uint32_t record_id) {
+    for (DrinkRecord& record : g_records) {
+        if (record.record_id == record_id) {
+            record.flags |= 0x04;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool storageLoadDailyState(DailyState& state) {
+    state = g_stored_daily_state;
+    return g_has_daily_state;
+}
+
+bool storageSaveDailyState(const DailyState& state) {
+    replayStorageSetDailyState(state);
+    return true;
+}
+
+// ==================== Weight / display stubs ====================
+
+// Calibration measurements complete instantly at the current fake ADC value
+WeightMeasurement weightMeasureStable() {
+    WeightMeasurement m;
+    m.raw_adc = nau.read();
+    m.variance = 0.0f;
+    m.stable = true;
+    m.sample_count = 1;
+    m.valid = true;
+    return m;
+}
+
+void displayNVSWarning() {}
+
+#if ENABLE_SLEEP_SCHEDULER
+// Usage model lives in RTC memory on the device - nothing to learn on the host
+void sleepSchedulerRecordDrink(uint32_t timestamp) {
+    (void)timestamp;
+}
+#endif
@@ -0,0 +1,25 @@
+/**
+ * Aquavate - Native Replay HAL
+ * Host-side replacements for the hardware and storage modules that
+ * gestures.cpp, drinks.cpp and calibration.cpp link against.
+ */
+
+#ifndef REPLAY_HAL_H
+#define REPLAY_HAL_H
+
+#include <Arduino.h>
+#include <Adafruit_ADXL343.h>
+#include <Adafruit_NAU7802.h>
+#include "storage.h"
+#include "storage_drinks.h"
+
+// Fake sensors fed from trace frames (nau is also the firmware's extern)
+extern Adafruit_ADXL343 g_replay_adxl;
+extern Adafruit_NAU7802 nau;
+
+// In-memory storage backend (replaces NVS + LittleFS)
+void replayStorageReset();
+void replayStorageSetCalibration(const CalibrationData& cal);
+void replayStorageSetDailyState(const DailyState& state);
+
+#endif // REPLAY_HAL_H
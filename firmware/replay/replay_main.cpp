@@ -0,0 +1,469 @@
+/**
+ * Aquavate - Native Trace Replay Harness
+ *
+ * Replays sensor traces captured by the trace recorder (DUMP TRACE CSV,
+ * /trace.bin ring file, or concatenated BLE trace chunks) through the real
+ * gestures.cpp / drinks.cpp / calibration.cpp and reports per-event detection
+ * latency, missed and spurious drinks, and host CPU time per loop.
+ *
+ * Build & run:
+ *   pio run -e native
+ *   .pio/build/native/program [options] trace1.csv trace2.bin ...
+ *
+ * Options:
+ *   --scale F        Calibration scale factor (ADC counts per gram)
+ *   --empty-adc N    Calibration empty bottle ADC
+ *   --epoch N        Unix time of the first frame (default 2026-01-01 12:00 UTC)
+ *   --window-ms N    Match window around each reference drink (default 30000)
+ *   --events         Print every reference/detected event
+ *   --verbose        Pass firmware Serial output through to stdout
+ *
+ * Reference drinks come from "<trace>.labels.csv" when present (lines of
+ * "session,timestamp_ms"), otherwise from the TRACE_FLAG_DRINK_RECORDED flags
+ * the bottle logged while recording - i.e. a regression check against the
+ * detector that was running at capture time.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "replay_hal.h"
+#include "config.h"
+#include "gestures.h"
+#include "drinks.h"
+#include "calibration.h"
+#include "trace_recorder.h"
+
+// Gap inserted between sessions on the virtual timeline (bottle asleep)
+#define REPLAY_SESSION_GAP_MS   60000
+
+struct ReplayOptions {
+    float scale_factor = 0.0f;
+    int32_t empty_adc = 0;
+    bool have_calibration = false;
+    uint32_t epoch = 1767268800;  // 2026-01-01 12:00:00 UTC
+    uint32_t window_ms = 30000;
+    bool print_events = false;
+};
+
+struct Trace {
+    std::string path;
+    std::vector<TraceFrame> frames;
+    bool have_calibration = false;
+    float scale_factor = 0.0f;
+    int32_t empty_adc = 0;
+};
+
+// An event on the virtual timeline (session-relative ms is kept for printing)
+struct ReplayEvent {
+    uint64_t global_ms;
+    uint16_t session;
+    uint32_t timestamp_ms;
+    int16_t amount_ml;
+};
+
+struct ReplayResult {
+    uint32_t frames = 0;
+    uint16_t sessions = 0;
+    uint32_t reference = 0;
+    uint32_t detected = 0;
+    uint32_t matched = 0;
+    std::vector<int64_t> latencies_ms;
+    std::vector<double> loop_us;
+};
+
+// ==================== Trace loading ====================
+
+static bool loadCsvTrace(FILE* f, Trace& trace) {
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        float scale;
+        int empty;
+        if (sscanf(line, "# calibration scale_factor=%f empty_adc=%d", &scale, &empty) == 2) {
+            trace.scale_factor = scale;
+            trace.empty_adc = empty;
+            trace.have_calibration = true;
+            continue;
+        }
+
+        unsigned ts, gesture, flags;
+        int adc, baseline, ax, ay, az;
+        if (sscanf(line, "%u,%d,%d,%d,%d,%d,%u,0x%x",
+                   &ts, &adc, &baseline, &ax, &ay, &az, &gesture, &flags) == 8) {
+            TraceFrame frame;
+            frame.timestamp_ms = ts;
+            frame.adc = adc;
+            frame.baseline_adc = baseline;
+            frame.accel_x = (int16_t)ax;
+            frame.accel_y = (int16_t)ay;
+            frame.accel_z = (int16_t)az;
+            frame.gesture = (uint8_t)gesture;
+            frame.flags = (uint8_t)flags;
+            trace.frames.push_back(frame);
+        }
+        // Anything else (markers, interleaved log lines) is ignored
+    }
+    return !trace.frames.empty();
+}
+
+static bool loadBinaryTrace(const std::vector<uint8_t>& data, Trace& trace) {
+    uint32_t magic = 0;
+    if (data.size() >= sizeof(magic)) {
+        memcpy(&magic, data.data(), sizeof(magic));
+    }
+
+    if (magic == TRACE_BLOCK_MAGIC) {
+        // Ring file: order blocks by sequence
+        std::vector<std::pair<uint32_t, size_t>> blocks;
+        for (size_t offset = 0; offset + TRACE_BLOCK_SIZE <= data.size(); offset += TRACE_BLOCK_SIZE) {
+            TraceBlockHeader header;
+            memcpy(&header, &data[offset], sizeof(header));
+            if (header.magic == TRACE_BLOCK_MAGIC && header.version == TRACE_FORMAT_VERSION &&
+                header.frame_size == sizeof(TraceFrame) && header.frame_count <= TRACE_FRAMES_PER_BLOCK) {
+                blocks.push_back({(uint32_t)header.sequence, offset});
+            }
+        }
+        std::sort(blocks.begin(), blocks.end());
+        for (const auto& block : blocks) {
+            TraceBlockHeader header;
+            memcpy(&header, &data[block.second], sizeof(header));
+            const uint8_t* p = &data[block.second + sizeof(TraceBlockHeader)];
+            for (uint16_t i = 0; i < header.frame_count; i++) {
+                TraceFrame frame;
+                memcpy(&frame, p + i * sizeof(TraceFrame), sizeof(TraceFrame));
+                trace.frames.push_back(frame);
+            }
+        }
+    } else if (data.size() % sizeof(TraceFrame) == 0) {
+        // Raw frame stream (concatenated BLE_TraceChunk payloads)
+        for (size_t offset = 0; offset < data.size(); offset += sizeof(TraceFrame)) {
+            TraceFrame frame;
+            memcpy(&frame, &data[offset], sizeof(TraceFrame));
+            trace.frames.push_back(frame);
+        }
+    }
+    return !trace.frames.empty();
+}
+
+static bool loadTrace(const char* path, Trace& trace) {
+    trace.path = path;
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "ERROR: Cannot open %s\n", path);
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+
+    // Text if it contains the CSV column header, binary otherwise
+    static const char kCsvHeader[] = "timestamp_ms,adc,";
+    bool is_csv = std::search(data.begin(), data.end(), kCsvHeader, kCsvHeader + strlen(kCsvHeader)) != data.end();
+
+    bool ok;
+    if (is_csv) {
+        rewind(f);
+        ok = loadCsvTrace(f, trace);
+    } else {
+        ok = loadBinaryTrace(data, trace);
+    }
+    fclose(f);
+
+    if (!ok) {
+        fprintf(stderr, "ERROR: No trace frames in %s\n", path);
+    }
+    return ok;
+}
+
+static std::vector<std::pair<uint16_t, uint32_t>> loadLabels(const std::string& trace_path) {
+    std::vector<std::pair<uint16_t, uint32_t>> labels;
+    std::string path = trace_path + ".labels.csv";
+    FILE* f = fopen(path.c_str(), "r");
+    if (!f) {
+        return labels;
+    }
+
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned session, ts;
+        if (line[0] != '#' && sscanf(line, "%u,%u", &session, &ts) == 2) {
+            labels.push_back({(uint16_t)session, ts});
+        }
+    }
+    fclose(f);
+    return labels;
+}
+
+// ==================== Replay ====================
+
+static bool isSessionStart(const TraceFrame& frame, const TraceFrame* prev) {
+    return prev == nullptr || (frame.flags & TRACE_FLAG_SESSION_START) ||
+           frame.timestamp_ms < prev->timestamp_ms;
+}
+
+static ReplayResult replayTrace(const Trace& trace, const ReplayOptions& opts) {
+    ReplayResult result;
+
+    CalibrationData cal = storageGetEmptyCalibration();
+    cal.scale_factor = trace.have_calibration ? trace.scale_factor : opts.scale_factor;
+    cal.empty_bottle_adc = trace.have_calibration ? trace.empty_adc : opts.empty_adc;
+    cal.full_bottle_adc = cal.empty_bottle_adc + (int32_t)(830.0f * cal.scale_factor);
+    cal.calibration_valid = 1;
+
+    replayStorageReset();
+    replayStorageSetCalibration(cal);
+
+    // Start from the bottle's baseline at capture time
+    DailyState initial_state;
+    memset(&initial_state, 0, sizeof(initial_state));
+    initial_state.last_recorded_adc = trace.frames.front().baseline_adc;
+    replayStorageSetDailyState(initial_state);
+
+    std::vector<ReplayEvent> reference;
+    std::vector<ReplayEvent> detected;
+
+    uint64_t session_base_ms = 0;
+    uint64_t last_global_ms = 0;
+    uint32_t last_level_check = 0;
+    const TraceFrame* prev = nullptr;
+
+    for (const TraceFrame& frame : trace.frames) {
+        replaySetMillis(frame.timestamp_ms);
+
+        // New session = fresh boot: re-init modules, restore drink baseline (as RTC would)
+        if (isSessionStart(frame, prev)) {
+            if (prev != nullptr) {
+                drinksSaveToRTC();
+                session_base_ms = last_global_ms + REPLAY_SESSION_GAP_MS;
+            }
+            replaySetEpoch(opts.epoch + (uint32_t)(session_base_ms / 1000));
+            gesturesInit(g_replay_adxl);
+            calibrationInit();
+            drinksInit();
+            drinksRestoreFromRTC();
+            last_level_check = frame.timestamp_ms;
+            result.sessions++;
+        }
+        uint64_t global_ms = session_base_ms + frame.timestamp_ms;
+        last_global_ms = global_ms;
+        prev = &frame;
+
+        if (frame.flags & TRACE_FLAG_DRINK_RECORDED) {
+            reference.push_back({global_ms, (uint16_t)(result.sessions - 1), frame.timestamp_ms, 0});
+        }
+
+        g_replay_adxl.feed(frame.accel_x, frame.accel_y, frame.accel_z);
+        nau.feed(frame.adc, (frame.flags & TRACE_FLAG_ADC_FRESH) != 0);
+
+        // Loop-equivalent: mirrors the sensor snapshot + drink tracking path in main.cpp loop()
+        auto t0 = std::chrono::steady_clock::now();
+
+        int32_t adc = 0;
+        float water_ml = 0.0f;
+        if (nau.available()) {
+            adc = nau.read();
+            water_ml = calibrationGetWaterWeight(adc, cal);
+        }
+
+        GestureType gesture = gesturesUpdate(water_ml);
+        bool drink_recorded = false;
+
+        if (gesture == GESTURE_UPRIGHT_STABLE && (frame.flags & TRACE_FLAG_CANCEL_PENDING)) {
+            // Bottle emptied - main.cpp skips detection and resets the baseline
+            drinksResetBaseline(adc);
+        } else if (!(frame.flags & TRACE_FLAG_CAL_ACTIVE) && gesture == GESTURE_UPRIGHT_STABLE &&
+                   millis() - last_level_check >= DISPLAY_UPDATE_INTERVAL_MS) {
+            last_level_check = millis();
+            float display_water_ml = water_ml > 830 ? 830 : water_ml;
+            if (display_water_ml >= -50.0f) {
+                drink_recorded = drinksUpdate(adc, cal);
+            }
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+        result.loop_us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+        if (drink_recorded) {
+            DrinkRecord record;
+            CircularBufferMetadata meta;
+            int16_t amount = 0;
+            if (storageLoadBufferMetadata(meta) && meta.record_count > 0 &&
+                storageGetDrinkRecord(meta.record_count - 1, record)) {
+                amount = record.amount_ml;
+            }
+            detected.push_back({global_ms, (uint16_t)(result.sessions - 1), frame.timestamp_ms, amount});
+        }
+        result.frames++;
+    }
+
+    // Labels override the recorded flags as ground truth
+    auto labels = loadLabels(trace.path);
+    if (!labels.empty()) {
+        reference.clear();
+        // Map (session, ms) onto the global timeline using each session's first frame
+        std::vector<uint64_t> session_bases;
+        uint64_t base = 0, last = 0;
+        const TraceFrame* p = nullptr;
+        for (const TraceFrame& frame : trace.frames) {
+            if (isSessionStart(frame, p)) {
+                if (p != nullptr) base = last + REPLAY_SESSION_GAP_MS;
+                session_bases.push_back(base);
+            }
+            last = base + frame.timestamp_ms;
+            p = &frame;
+        }
+        for (const auto& label : labels) {
+            if (label.first < session_bases.size()) {
+                reference.push_back({session_bases[label.first] + label.second, label.first, label.second, 0});
+            }
+        }
+    }
+
+    // Match each reference drink to the nearest unmatched detection within the window
+    std::vector<bool> used(detected.size(), false);
+    for (const ReplayEvent& ref : reference) {
+        int best = -1;
+        int64_t best_delta = 0;
+        for (size_t i = 0; i < detected.size(); i++) {
+            if (used[i]) continue;
+            int64_t delta = (int64_t)detected[i].global_ms - (int64_t)ref.global_ms;
+            if (llabs(delta) <= opts.window_ms && (best < 0 || llabs(delta) < llabs(best_delta))) {
+                best = (int)i;
+                best_delta = delta;
+            }
+        }
+        if (best >= 0) {
+            used[best] = true;
+            result.matched++;
+            result.latencies_ms.push_back(best_delta);
+        }
+        if (opts.print_events) {
+            if (best >= 0) {
+                printf("    ref  s%u %8ums -> detected %+dml, latency %+lldms\n",
+                       ref.session, ref.timestamp_ms, detected[best].amount_ml, (long long)best_delta);
+            } else {
+                printf("    ref  s%u %8ums -> MISSED\n", ref.session, ref.timestamp_ms);
+            }
+        }
+    }
+    if (opts.print_events) {
+        for (size_t i = 0; i < detected.size(); i++) {
+            if (!used[i]) {
+                printf("    det  s%u %8ums %+dml -> SPURIOUS\n",
+                       detected[i].session, detected[i].timestamp_ms, detected[i].amount_ml);
+            }
+        }
+    }
+
+    result.reference = reference.size();
+    result.detected = detected.size();
+    return result;
+}
+
+// ==================== Reporting ====================
+
+static double percentile(std::vector<double> v, double pct) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = (size_t)(pct / 100.0 * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+static void printResult(const char* name, const ReplayResult& r) {
+    printf("%s\n", name);
+    printf("  frames: %u in %u session(s)\n", r.frames, r.sessions);
+    printf("  drinks: reference=%u detected=%u matched=%u missed=%u spurious=%u\n",
+           r.reference, r.detected, r.matched, r.reference - r.matched, r.detected - r.matched);
+
+    if (!r.latencies_ms.empty()) {
+        std::vector<double> lat(r.latencies_ms.begin(), r.latencies_ms.end());
+        double sum = 0;
+        for (double v : lat) sum += v;
+        printf("  latency ms: mean=%.0f p50=%.0f max=%.0f\n",
+               sum / lat.size(), percentile(lat, 50), percentile(lat, 100));
+    }
+
+    if (!r.loop_us.empty()) {
+        double sum = 0;
+        for (double v : r.loop_us) sum += v;
+        printf("  loop cpu us: mean=%.2f p50=%.2f p99=%.2f max=%.2f\n",
+               sum / r.loop_us.size(), percentile(r.loop_us, 50),
+               percentile(r.loop_us, 99), percentile(r.loop_us, 100));
+    }
+}
+
+int main(int argc, char** argv) {
+    // Firmware treats gettimeofday()/mktime() as UTC (ESP32 default)
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    ReplayOptions opts;
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--scale" && i + 1 < argc) {
+            opts.scale_factor = strtof(argv[++i], nullptr);
+            opts.have_calibration = true;
+        } else if (arg == "--empty-adc" && i + 1 < argc) {
+            opts.empty_adc = strtol(argv[++i], nullptr, 10);
+        } else if (arg == "--epoch" && i + 1 < argc) {
+            opts.epoch = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--window-ms" && i + 1 < argc) {
+            opts.window_ms = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--events") {
+            opts.print_events = true;
+        } else if (arg == "--verbose") {
+            Serial.enabled = true;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "ERROR: Unknown option %s\n", arg.c_str());
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.empty()) {
+        fprintf(stderr, "usage: %s [--scale F --empty-adc N] [--epoch N] [--window-ms N] "
+                        "[--events] [--verbose] trace...\n", argv[0]);
+        return 2;
+    }
+
+    ReplayResult total;
+    int failures = 0;
+
+    for (const char* path : paths) {
+        Trace trace;
+        if (!loadTrace(path, trace)) {
+            failures++;
+            continue;
+        }
+        if (!trace.have_calibration && !opts.have_calibration) {
+            fprintf(stderr, "ERROR: %s has no calibration line - pass --scale/--empty-adc\n", path);
+            failures++;
+            continue;
+        }
+
+        ReplayResult r = replayTrace(trace, opts);
+        printResult(path, r);
+
+        total.frames += r.frames;
+        total.sessions += r.sessions;
+        total.reference += r.reference;
+        total.detected += r.detected;
+        total.matched += r.matched;
+        total.latencies_ms.insert(total.latencies_ms.end(), r.latencies_ms.begin(), r.latencies_ms.end());
+        total.loop_us.insert(total.loop_us.end(), r.loop_us.begin(), r.loop_us.end());
+    }
+
+    if (paths.size() > 1) {
+        printResult("TOTAL", total);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * Aquavate - Native Replay HAL Shim
+ * Fake ADXL343: returns the raw counts of the current trace frame.
+ */
+
+#ifndef ADAFRUIT_ADXL343_H
+#define ADAFRUIT_ADXL343_H
+
+#include <Arduino.h>
+
+class Adafruit_ADXL343 {
+public:
+    explicit Adafruit_ADXL343(int32_t sensorID = -1) { (void)sensorID; }
+
+    void getXYZ(int16_t& x, int16_t& y, int16_t& z) {
+        x = raw_x;
+        y = raw_y;
+        z = raw_z;
+    }
+
+    // Set by the replay harness before each loop (256 LSB/g)
+    void feed(int16_t x, int16_t y, int16_t z) {
+        raw_x = x;
+        raw_y = y;
+        raw_z = z;
+    }
+
+private:
+    int16_t raw_x = 0;
+    int16_t raw_y = 0;
+    int16_t raw_z = 256;
+};
+
+#endif // ADAFRUIT_ADXL343_H
@@ -0,0 +1,31 @@
+/**
+ * Aquavate - Native Replay HAL Shim
+ * Fake NAU7802: returns the ADC value of the current trace frame.
+ */
+
+#ifndef ADAFRUIT_NAU7802_H
+#define ADAFRUIT_NAU7802_H
+
+#include <Arduino.h>
+
+class Adafruit_NAU7802 {
+public:
+    bool available() { return fresh; }
+
+    int32_t read() {
+        fresh = false;
+        return adc;
+    }
+
+    // Set by the replay harness before each loop
+    void feed(int32_t value, bool is_fresh) {
+        adc = value;
+        fresh = is_fresh;
+    }
+
+private:
+    int32_t adc = 0;
+    bool fresh = false;
+};
+
+#endif // ADAFRUIT_NAU7802_H
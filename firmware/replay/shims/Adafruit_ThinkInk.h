@@ -0,0 +1,13 @@
+/**
+ * Aquavate - Native Replay HAL Shim
+ * Display type only - display.h names it in function signatures.
+ */
+
+#ifndef ADAFRUIT_THINKINK_H
+#define ADAFRUIT_THINKINK_H
+
+#include <Arduino.h>
+
+class ThinkInk_213_Mono_GDEY0213B74 {};
+
+#endif // ADAFRUIT_THINKINK_H
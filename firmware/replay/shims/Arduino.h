@@ -0,0 +1,71 @@
+/**
+ * Aquavate - Native Replay HAL Shim
+ * Minimal Arduino API for building detector modules on the host.
+ * Time is virtual: the replay harness advances millis() and the wall clock
+ * frame by frame, so detector timing matches the recorded trace exactly.
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdarg.h>
+#include <sys/time.h>
+
+#define PROGMEM
+#define RTC_DATA_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+#define HIGH 1
+#define LOW  0
+
+// Virtual clock (replay_hal.cpp)
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void replaySetMillis(uint32_t ms);
+
+// Virtual wall clock - firmware calls gettimeofday() for Unix timestamps
+int replayGettimeofday(struct timeval* tv, void* tz);
+void replaySetEpoch(uint32_t epoch_seconds);
+#define gettimeofday(tv, tz) replayGettimeofday((tv), (tz))
+
+// Serial sink - silent unless the harness runs with --verbose
+class ReplaySerial {
+public:
+    bool enabled = false;
+
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush() { if (enabled) fflush(stdout); }
+
+    void print(const char* s) { if (enabled) fputs(s, stdout); }
+    void print(char c) { if (enabled) fputc(c, stdout); }
+    void print(int v) { if (enabled) printf("%d", v); }
+    void print(unsigned int v) { if (enabled) printf("%u", v); }
+    void print(long v) { if (enabled) printf("%ld", v); }
+    void print(unsigned long v) { if (enabled) printf("%lu", v); }
+    void print(double v, int digits = 2) { if (enabled) printf("%.*f", digits, v); }
+
+    void println() { print("\n"); }
+    template <typename T> void println(T v) { print(v); println(); }
+    void println(double v, int digits) { print(v, digits); println(); }
+
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (!enabled) return 0;
+        va_list args;
+        va_start(args, fmt);
+        int n = vprintf(fmt, args);
+        va_end(args);
+        return n;
+    }
+};
+
+extern ReplaySerial Serial;
+
+#endif // ARDUINO_H
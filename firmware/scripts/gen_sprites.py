@@ -0,0 +1,269 @@
+"""Aquavate - main-screen sprite generator
+
+Bakes the fixed main-screen artwork into column-major 1bpp RasterSprites in
+flash (src/sprites_generated.cpp, declared in include/sprites.h):
+
+  - bottle outline (water is drawn on top as a rounded-rect run fill)
+  - human figure outline/filled (from the bitmaps in src/display.cpp)
+  - tumbler outline, empty and completely full
+  - size-3 glyphs for the intake number ("0"-"9", "m", "l")
+  - the size-2 "today" label
+
+Shapes use the same algorithms as Adafruit_GFX (fillRoundRect, drawLine, the
+classic 5x7 font scaled with fillRect), so the sprites match what the GFX calls
+drew pixel for pixel.
+
+Runs before every adafruit_feather build (extra_scripts in platformio.ini) and
+only rewrites the output when it changes. Standalone: python3 scripts/gen_sprites.py
+"""
+
+import os
+import re
+import struct
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO when run as an extra script
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+DISPLAY_CPP = os.path.join(PROJECT_DIR, "src", "display.cpp")
+OUTPUT_CPP = os.path.join(PROJECT_DIR, "src", "sprites_generated.cpp")
+
+# Adafruit_GFX glcdfont.c columns (LSB = top row) for the glyphs we bake
+GLCD_FONT = {
+    "0": (0x3E, 0x51, 0x49, 0x45, 0x3E),
+    "1": (0x00, 0x42, 0x7F, 0x40, 0x00),
+    "2": (0x72, 0x49, 0x49, 0x49, 0x46),
+    "3": (0x21, 0x41, 0x49, 0x4D, 0x33),
+    "4": (0x18, 0x14, 0x12, 0x7F, 0x10),
+    "5": (0x27, 0x45, 0x45, 0x45, 0x39),
+    "6": (0x3C, 0x4A, 0x49, 0x49, 0x31),
+    "7": (0x41, 0x21, 0x11, 0x09, 0x07),
+    "8": (0x36, 0x49, 0x49, 0x49, 0x36),
+    "9": (0x46, 0x49, 0x49, 0x29, 0x1E),
+    "a": (0x20, 0x54, 0x54, 0x78, 0x40),
+    "d": (0x38, 0x44, 0x44, 0x28, 0x7F),
+    "l": (0x00, 0x41, 0x7F, 0x40, 0x00),
+    "m": (0x7C, 0x04, 0x78, 0x04, 0x78),
+    "o": (0x38, 0x44, 0x44, 0x44, 0x38),
+    "t": (0x04, 0x04, 0x3F, 0x44, 0x24),
+    "y": (0x4C, 0x90, 0x90, 0x90, 0x7C),
+}
+
+LARGE_GLYPHS = "0123456789ml"
+
+
+def f32(value):
+    """Round to IEEE single precision (the firmware's float arithmetic)"""
+    return struct.unpack("f", struct.pack("f", value))[0]
+
+
+class Canvas:
+    """1bpp drawing surface with the Adafruit_GFX primitives the firmware uses"""
+
+    def __init__(self, width, height):
+        self.width = width
+        self.height = height
+        self.pixels = [[False] * width for _ in range(height)]
+
+    def pixel(self, x, y, ink=True):
+        if 0 <= x < self.width and 0 <= y < self.height:
+            self.pixels[y][x] = ink
+
+    def fill_rect(self, x, y, w, h, ink=True):
+        for px in range(x, x + w):
+            for py in range(y, y + h):
+                self.pixel(px, py, ink)
+
+    def _fill_circle_helper(self, x0, y0, r, corners, delta, ink):
+        f = 1 - r
+        ddf_x = 1
+        ddf_y = -2 * r
+        x = 0
+        y = r
+        px = x
+        py = y
+        delta += 1
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddf_y += 2
+                f += ddf_y
+            x += 1
+            ddf_x += 2
+            f += ddf_x
+            if x < y + 1:
+                if corners & 1:
+                    self.fill_rect(x0 + x, y0 - y, 1, 2 * y + delta, ink)
+                if corners & 2:
+                    self.fill_rect(x0 - x, y0 - y, 1, 2 * y + delta, ink)
+            if y != px:
+                if corners & 1:
+                    self.fill_rect(x0 + py, y0 - px, 1, 2 * px + delta, ink)
+                if corners & 2:
+                    self.fill_rect(x0 - py, y0 - px, 1, 2 * px + delta, ink)
+                py = y
+            px = x
+
+    def fill_round_rect(self, x, y, w, h, r, ink=True):
+        max_radius = min(w, h) // 2
+        if r > max_radius:
+            r = max_radius
+        self.fill_rect(x + r, y, w - 2 * r, h, ink)
+        self._fill_circle_helper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, ink)
+        self._fill_circle_helper(x + r, y + r, r, 2, h - 2 * r - 1, ink)
+
+    def draw_line(self, x0, y0, x1, y1, ink=True):
+        steep = abs(y1 - y0) > abs(x1 - x0)
+        if steep:
+            x0, y0 = y0, x0
+            x1, y1 = y1, x1
+        if x0 > x1:
+            x0, x1 = x1, x0
+            y0, y1 = y1, y0
+        dx = x1 - x0
+        dy = abs(y1 - y0)
+        err = dx // 2
+        ystep = 1 if y0 < y1 else -1
+        while x0 <= x1:
+            if steep:
+                self.pixel(y0, x0, ink)
+            else:
+                self.pixel(x0, y0, ink)
+            err -= dy
+            if err < 0:
+                y0 += ystep
+                err += dx
+            x0 += 1
+
+    def draw_char(self, x, y, char, size):
+        for i, line in enumerate(GLCD_FONT[char]):
+            for j in range(8):
+                if line & (1 << j):
+                    self.fill_rect(x + i * size, y + j * size, size, size)
+
+    def draw_row_bitmap(self, rows, width, height):
+        row_bytes = (width + 7) // 8
+        for y in range(height):
+            for x in range(width):
+                if rows[y * row_bytes + x // 8] & (0x80 >> (x % 8)):
+                    self.pixel(x, y)
+
+    def columns(self):
+        """Column-major bytes, MSB = top row (RasterSprite layout)"""
+        column_bytes = (self.height + 7) // 8
+        data = []
+        for x in range(self.width):
+            column = [0] * column_bytes
+            for y in range(self.height):
+                if self.pixels[y][x]:
+                    column[y // 8] |= 0x80 >> (y % 8)
+            data.extend(column)
+        return data
+
+
+def bottle_outline():
+    # drawBottleGraphic() without the water / "?"
+    c = Canvas(40, 90)
+    c.fill_round_rect(0, 20, 40, 70, 8)
+    c.fill_round_rect(2, 22, 36, 66, 6, False)
+    c.fill_rect(6, 10, 28, 10)
+    c.fill_rect(8, 12, 24, 6, False)
+    c.fill_rect(8, 0, 24, 10)
+    return c
+
+
+def glass(full):
+    # drawGlassGrid() for one tumbler (18x16), empty or at glass_fill = 1.0
+    width, height = 18, 16
+    c = Canvas(width, height)
+    c.draw_line(0, 0, 3, height - 1)
+    c.draw_line(width - 1, 0, width - 4, height - 1)
+    c.draw_line(0, 0, width - 1, 0)
+    c.draw_line(3, height - 1, width - 4, height - 1)
+    if full:
+        fill_start_row = height - 1 - (height - 2)
+        for i in range(fill_start_row, height - 1):
+            ratio = f32(f32(i) / f32(height - 1))
+            inset = 1 + int(f32(ratio * 3))
+            c.draw_line(inset, i, width - 1 - inset, i)
+    return c
+
+
+def text(string, size):
+    c = Canvas(len(string) * 6 * size - size, 8 * size)
+    for i, char in enumerate(string):
+        c.draw_char(i * 6 * size, 0, char, size)
+    return c
+
+
+def display_bitmap(name, width, height):
+    with open(DISPLAY_CPP) as source:
+        match = re.search(r"\b" + name + r"\[\]\s*=\s*\{(.*?)\};", source.read(), re.S)
+    if match is None:
+        raise SystemExit("gen_sprites: %s not found in %s" % (name, DISPLAY_CPP))
+    values = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", match.group(1))]
+    c = Canvas(width, height)
+    c.draw_row_bitmap(values, width, height)
+    return c
+
+
+def emit(name, canvas, out):
+    data = canvas.columns()
+    out.append("static const uint8_t %s_DATA[] PROGMEM = {" % name)
+    for i in range(0, len(data), 12):
+        out.append("    " + " ".join("0x%02X," % b for b in data[i:i + 12]))
+    out.append("};")
+    out.append("const RasterSprite %s = { %s_DATA, %d, %d, %d };" % (
+        name, name, canvas.width, canvas.height, (canvas.height + 7) // 8))
+    out.append("")
+
+
+def generate():
+    out = [
+        "// sprites_generated.cpp - Pre-rendered main-screen sprites",
+        "// Part of the Aquavate smart water bottle firmware",
+        "//",
+        "// GENERATED by scripts/gen_sprites.py - do not edit.",
+        "",
+        '#include "sprites.h"',
+        "",
+    ]
+    emit("SPRITE_BOTTLE", bottle_outline(), out)
+    emit("SPRITE_FIGURE_OUTLINE", display_bitmap("human_figure_bitmap", 54, 90), out)
+    emit("SPRITE_FIGURE_FILLED", display_bitmap("human_figure_filled_bitmap", 54, 90), out)
+    emit("SPRITE_GLASS_EMPTY", glass(False), out)
+    emit("SPRITE_GLASS_FULL", glass(True), out)
+    emit("SPRITE_TODAY", text("today", 2), out)
+
+    names = []
+    for char in LARGE_GLYPHS:
+        name = "SPRITE_LARGE_" + (char if char.isdigit() else char.upper())
+        emit(name, text(char, 3), out)
+        names.append((char, name))
+
+    out.append("const RasterSprite* spriteLargeGlyph(char c) {")
+    out.append("    switch (c) {")
+    for char, name in names:
+        out.append("        case '%s': return &%s;" % (char, name))
+    out.append("        default: return nullptr;")
+    out.append("    }")
+    out.append("}")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    content = generate()
+    try:
+        with open(OUTPUT_CPP) as existing:
+            if existing.read() == content:
+                return
+    except FileNotFoundError:
+        pass
+    with open(OUTPUT_CPP, "w") as output:
+        output.write(content)
+    print("gen_sprites: wrote %s" % os.path.relpath(OUTPUT_CPP, PROJECT_DIR))
+
+
+main()
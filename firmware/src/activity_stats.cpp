@@ -1,13 +1,14 @@
 // activity_stats.cpp - Activity and sleep mode tracking implementation
 // Part of the Aquavate smart water bottle firmware
 //
-// Tracks individual wake events and aggregated backpack sessions for
-// battery life analysis. Data stored in RTC memory (survives deep sleep,
+// Tracks individual wake events, aggregated backpack sessions and e-paper
+// refreshes per day for battery life analysis. Data stored in RTC memory (survives deep sleep,
 // resets on power cycle).
 
 #include "activity_stats.h"
 #include "config.h"
 #include <sys/time.h>
+#include <freertos/FreeRTOS.h>
 
 // External functions from drinks.cpp
 extern uint32_t getCurrentUnixTime();
@@ -21,6 +22,9 @@ RTC_DATA_ATTR ActivityBuffer rtc_activity_buffer;
 static CurrentWakeSession g_current_wake = {0, 0, WAKE_REASON_OTHER, false, 0};
 static bool g_activity_initialized = false;
 
+// Display refreshes are counted from the display task as well as the main loop
+static portMUX_TYPE g_display_days_mux = portMUX_INITIALIZER_UNLOCKED;
+
 // Helper: Add motion wake event to circular buffer
 static void addMotionEvent(const MotionWakeEvent& event) {
     uint8_t index = rtc_activity_buffer.motion_write_index;
@@ -41,6 +45,31 @@ static void addBackpackSession(const BackpackSession& session) {
     }
 }
 
+// Helper: Today's display refresh entry (opens a new day when the local date changes)
+// Caller holds g_display_days_mux and reads day_start before taking it (no clock reads in there)
+static DisplayRefreshDay& currentDisplayDay(uint32_t day_start) {
+    if (rtc_activity_buffer.display_day_count > 0) {
+        uint8_t newest = (rtc_activity_buffer.display_day_index + DISPLAY_REFRESH_DAY_COUNT - 1) %
+                         DISPLAY_REFRESH_DAY_COUNT;
+        DisplayRefreshDay& day = rtc_activity_buffer.display_days[newest];
+        if (day.day_start == day_start) {
+            return day;
+        }
+    }
+
+    uint8_t index = rtc_activity_buffer.display_day_index;
+    DisplayRefreshDay& day = rtc_activity_buffer.display_days[index];
+    day.day_start = day_start;
+    day.full_refreshes = 0;
+    day.partial_refreshes = 0;
+    day.deferred = 0;
+    rtc_activity_buffer.display_day_index = (index + 1) % DISPLAY_REFRESH_DAY_COUNT;
+    if (rtc_activity_buffer.display_day_count < DISPLAY_REFRESH_DAY_COUNT) {
+        rtc_activity_buffer.display_day_count++;
+    }
+    return day;
+}
+
 void activityStatsInit() {
     // Initialize fresh buffer (power cycle or first boot)
     rtc_activity_buffer.magic = RTC_MAGIC_ACTIVITY;
@@ -51,6 +80,8 @@ void activityStatsInit() {
     rtc_activity_buffer.current_session_start = 0;
     rtc_activity_buffer.current_timer_wake_count = 0;
     rtc_activity_buffer._reserved = 0;
+    rtc_activity_buffer.display_day_index = 0;
+    rtc_activity_buffer.display_day_count = 0;
 
     // Clear current wake tracking
     g_current_wake = {0, 0, WAKE_REASON_OTHER, false, 0};
@@ -168,6 +199,16 @@ void activityStatsRecordTimerWake() {
                   rtc_activity_buffer.current_timer_wake_count);
 }
 
+void activityStatsAddTimerWakes(uint16_t count) {
+    if (count == 0 || rtc_activity_buffer.current_session_start == 0) {
+        return;  // Stub only runs in backpack mode
+    }
+
+    rtc_activity_buffer.current_timer_wake_count += count;
+    DEBUG_PRINTF(g_debug_drink_tracking, "Activity: %d timer wakes handled by wake stub (total %d)\n",
+                  count, rtc_activity_buffer.current_timer_wake_count);
+}
+
 void activityStatsFinalizeBackpackSession(BackpackExitReason reason) {
     if (rtc_activity_buffer.current_session_start == 0) {
         return;  // Not in backpack mode
@@ -229,6 +270,53 @@ uint8_t activityStatsGetBackpackSessions(BackpackSession* buffer, uint8_t max_co
     return count;
 }
 
+void activityStatsRecordDisplayRefresh(bool partial) {
+    if (!g_activity_initialized) {
+        return;  // Boot splash - buffer not restored yet
+    }
+
+    uint32_t day_start = getCurrentUnixTime() / 86400 * 86400;
+    taskENTER_CRITICAL(&g_display_days_mux);
+    DisplayRefreshDay& day = currentDisplayDay(day_start);
+    if (partial) {
+        if (day.partial_refreshes < UINT16_MAX) day.partial_refreshes++;
+    } else {
+        if (day.full_refreshes < UINT16_MAX) day.full_refreshes++;
+    }
+    taskEXIT_CRITICAL(&g_display_days_mux);
+}
+
+void activityStatsRecordDisplayDeferred() {
+    if (!g_activity_initialized) {
+        return;
+    }
+
+    uint32_t day_start = getCurrentUnixTime() / 86400 * 86400;
+    taskENTER_CRITICAL(&g_display_days_mux);
+    DisplayRefreshDay& day = currentDisplayDay(day_start);
+    if (day.deferred < UINT16_MAX) day.deferred++;
+    taskEXIT_CRITICAL(&g_display_days_mux);
+}
+
+uint8_t activityStatsGetDisplayDays(DisplayRefreshDay* buffer, uint8_t max_count) {
+    taskENTER_CRITICAL(&g_display_days_mux);
+    uint8_t count = min(rtc_activity_buffer.display_day_count, max_count);
+
+    // Oldest first - same layout as the motion event buffer
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t idx;
+        if (rtc_activity_buffer.display_day_count < DISPLAY_REFRESH_DAY_COUNT) {
+            idx = i;
+        } else {
+            idx = (rtc_activity_buffer.display_day_index + i) % DISPLAY_REFRESH_DAY_COUNT;
+        }
+        buffer[i] = rtc_activity_buffer.display_days[idx];
+    }
+    taskEXIT_CRITICAL(&g_display_days_mux);
+
+    return count;
+}
+
 uint8_t activityStatsGetMotionEventCount() {
     return rtc_activity_buffer.motion_count;
 }
@@ -0,0 +1,195 @@
+// app_tasks.cpp - FreeRTOS task layout (sensor acquisition, storage writer)
+// Part of the Aquavate smart water bottle firmware
+
+#include "app_tasks.h"
+#include "config.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
+
+#define SENSOR_TASK_STACK       3072
+#define STORAGE_TASK_STACK      4096    // LittleFS write path
+
+struct StorageJob {
+    StorageJobFn fn;
+    void* arg;
+};
+
+static TaskHandle_t g_sensor_task = nullptr;
+static TaskHandle_t g_storage_task = nullptr;
+static QueueHandle_t g_sample_mailbox = nullptr;   // Depth 1, overwritten
+static QueueHandle_t g_storage_queue = nullptr;
+static SemaphoreHandle_t g_sensor_gate = nullptr;   // Held by the sensor task per sample, or by a pauser
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Latest published sample (guarded by g_mux)
+static PublishedSample g_latest;
+static bool g_has_latest = false;
+static uint32_t g_dropped_samples = 0;
+
+// Jobs queued but not yet finished (guarded by g_mux)
+static uint32_t g_storage_pending = 0;
+
+static void sensorTask(void* param) {
+    (void)param;
+    TickType_t last_wake = xTaskGetTickCount();
+    uint32_t sequence = 0;
+
+    for (;;) {
+        if (xSemaphoreTakeRecursive(g_sensor_gate, 0) != pdTRUE) {
+            // Paused for direct sensor access - restart the cadence afterwards
+            // instead of catching up with a burst of back-to-back samples
+            xSemaphoreTakeRecursive(g_sensor_gate, portMAX_DELAY);
+            last_wake = xTaskGetTickCount();
+        }
+
+        PublishedSample published;
+        sensorSamplerGet(published.sample);
+        published.timestamp = millis();
+        published.sequence = ++sequence;
+
+        taskENTER_CRITICAL(&g_mux);
+        g_latest = published;
+        g_has_latest = true;
+        taskEXIT_CRITICAL(&g_mux);
+
+        // Logic task still busy with the previous sample - replace it
+        if (uxQueueMessagesWaiting(g_sample_mailbox) > 0) {
+            g_dropped_samples++;
+        }
+        xQueueOverwrite(g_sample_mailbox, &published);
+        xSemaphoreGiveRecursive(g_sensor_gate);
+
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(SENSOR_TASK_INTERVAL_MS));
+    }
+}
+
+static void storageTask(void* param) {
+    (void)param;
+    StorageJob job;
+
+    for (;;) {
+        if (xQueueReceive(g_storage_queue, &job, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        {
+#if ENABLE_ENERGY_LEDGER
+            EnergyOverlayScope energy(ENERGY_OVERLAY_FLASH_WRITE);
+#endif
+            job.fn(job.arg);
+        }
+
+        taskENTER_CRITICAL(&g_mux);
+        g_storage_pending--;
+        taskEXIT_CRITICAL(&g_mux);
+    }
+}
+
+bool appTasksInit() {
+    bool ok = true;
+
+    if (!g_storage_task) {
+        g_storage_queue = xQueueCreate(STORAGE_QUEUE_DEPTH, sizeof(StorageJob));
+        if (g_storage_queue == nullptr ||
+            xTaskCreatePinnedToCore(storageTask, "storage", STORAGE_TASK_STACK, nullptr,
+                                    STORAGE_TASK_PRIORITY, &g_storage_task, STORAGE_TASK_CORE) != pdPASS) {
+            Serial.println("ERROR: Storage task creation failed - flash writes stay synchronous");
+            g_storage_task = nullptr;
+            ok = false;
+        }
+    }
+
+    if (!g_sensor_task) {
+        g_sample_mailbox = xQueueCreate(1, sizeof(PublishedSample));
+        g_sensor_gate = xSemaphoreCreateRecursiveMutex();
+        if (g_sample_mailbox == nullptr || g_sensor_gate == nullptr ||
+            xTaskCreatePinnedToCore(sensorTask, "sensor", SENSOR_TASK_STACK, nullptr,
+                                    SENSOR_TASK_PRIORITY, &g_sensor_task, SENSOR_TASK_CORE) != pdPASS) {
+            Serial.println("ERROR: Sensor task creation failed - sampling inline in loop");
+            g_sensor_task = nullptr;
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+bool appTasksSensorRunning() {
+    return g_sensor_task != nullptr;
+}
+
+bool appTasksWaitSample(PublishedSample& out, uint32_t timeout_ms) {
+    if (!g_sensor_task) {
+        return false;
+    }
+    return xQueueReceive(g_sample_mailbox, &out, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+bool appTasksGetLatestSample(PublishedSample& out) {
+    taskENTER_CRITICAL(&g_mux);
+    bool has = g_has_latest;
+    if (has) {
+        out = g_latest;
+    }
+    taskEXIT_CRITICAL(&g_mux);
+    return has;
+}
+
+uint32_t appTasksGetDroppedSamples() {
+    return g_dropped_samples;
+}
+
+void appTasksSensorPause() {
+    if (g_sensor_task && g_sensor_gate) {
+        xSemaphoreTakeRecursive(g_sensor_gate, portMAX_DELAY);
+    }
+}
+
+void appTasksSensorResume() {
+    if (g_sensor_task && g_sensor_gate) {
+        xSemaphoreGiveRecursive(g_sensor_gate);
+    }
+}
+
+bool appTasksQueueStorageJob(StorageJobFn fn, void* arg) {
+    if (!g_storage_task || fn == nullptr) {
+        return false;
+    }
+
+    taskENTER_CRITICAL(&g_mux);
+    g_storage_pending++;
+    taskEXIT_CRITICAL(&g_mux);
+
+    StorageJob job = { fn, arg };
+    if (xQueueSend(g_storage_queue, &job, 0) != pdTRUE) {
+        taskENTER_CRITICAL(&g_mux);
+        g_storage_pending--;
+        taskEXIT_CRITICAL(&g_mux);
+        return false;
+    }
+    return true;
+}
+
+bool appTasksStorageBusy() {
+    taskENTER_CRITICAL(&g_mux);
+    bool busy = g_storage_pending > 0;
+    taskEXIT_CRITICAL(&g_mux);
+    return busy;
+}
+
+bool appTasksStorageSync(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    while (appTasksStorageBusy()) {
+        if (millis() - start >= timeout_ms) {
+            Serial.println("ERROR: Timed out waiting for deferred storage writes");
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(2));
+    }
+    return true;
+}
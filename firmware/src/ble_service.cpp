@@ -17,6 +17,18 @@
 #include "weight.h"
 #include "calibration.h"
 #include "display.h"
+#include "mpsc_queue.h"
+#include "power_mgmt.h"
+#include <esp_bt.h>
+#if ENABLE_BOOT_PROFILE
+#include "boot_profile.h"
+#endif
+#if ENABLE_TRACE_RECORDER
+#include "trace_recorder.h"
+#endif
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
 
 // NimBLE objects
 static NimBLEServer* pServer = nullptr;
@@ -72,28 +84,73 @@ static DrinkRecord* syncBuffer = nullptr;  // Buffer for unsynced records
 static uint16_t syncBufferSize = 0;        // Number of records in buffer
 static uint16_t syncCurrentChunk = 0;      // Current chunk being sent
 
-// Command execution flags (main loop will handle these)
-static volatile bool g_ble_tare_requested = false;
-static volatile bool g_ble_reset_daily_requested = false;
-static volatile bool g_ble_clear_history_requested = false;
-static volatile bool g_ble_set_daily_total_requested = false;
-static volatile uint16_t g_ble_set_daily_total_value = 0;
-static volatile bool g_ble_force_display_refresh = false;
+// Unsynced record count, refreshed from flash on the loop task and served to
+// Sync Control reads on the NimBLE host task (which must not touch flash)
+static volatile uint16_t g_unsynced_count = 0;
+
+// Command flags for the main loop. Set by bleProcessCommands() when it drains
+// the command queue, consumed by the bleCheck*() functions - loop task only.
+static bool g_ble_tare_requested = false;
+static bool g_ble_reset_daily_requested = false;
+static bool g_ble_clear_history_requested = false;
+static bool g_ble_set_daily_total_requested = false;
+static uint16_t g_ble_set_daily_total_value = 0;
+static bool g_ble_force_display_refresh = false;
 
 // BLE activity flag for activity timeout reset (Plan 034 - Timer Rationalization)
-// Set whenever BLE data activity occurs (sync, commands)
+// Set whenever BLE data activity occurs (sync, commands). Also set from Sync
+// Control reads on the NimBLE host task, hence volatile.
 static volatile bool g_ble_data_activity = false;
 
 // Calibration state for iOS-driven calibration (Plan 060 - original approach)
-static volatile bool g_cal_mode = false;            // Calibration mode active (blocks sleep)
-static volatile bool g_cal_measuring = false;       // Measurement in progress
-static volatile bool g_cal_result_ready = false;    // Result available for reading
-static volatile int32_t g_cal_last_adc = 0;         // Last measured raw ADC value
+static bool g_cal_mode = false;            // Calibration mode active (blocks sleep)
+static bool g_cal_measuring = false;       // Measurement in progress
+static bool g_cal_result_ready = false;    // Result available for reading
+static int32_t g_cal_last_adc = 0;         // Last measured raw ADC value
 
 // Bottle-driven calibration (Plan 060 - revised approach)
 // iOS sends START/CANCEL, bottle runs its state machine and notifies iOS of state changes
-static volatile bool g_ble_calibration_start_requested = false;   // iOS requested calibration start
-static volatile bool g_ble_calibration_cancel_requested = false;  // iOS requested calibration cancel
+static bool g_ble_calibration_start_requested = false;   // iOS requested calibration start
+static bool g_ble_calibration_cancel_requested = false;  // iOS requested calibration cancel
+
+// ==================== Command queue ====================
+// Every GATT write becomes a typed message on the NimBLE host task and is
+// pushed onto a lock-free queue; bleUpdate() drains it on the loop task. The
+// host never waits on NVS/LittleFS or the load cell, and queued writes can be
+// batched (e.g. many DELETE_DRINK_RECORDs -> one total recalculation).
+//
+// Command characteristic writes use their BLE_CMD_* code as the message type;
+// writes to other characteristics use the BLE_MSG_* types below.
+#define BLE_MSG_BOTTLE_CONFIG       0xF0
+#define BLE_MSG_SYNC_CONTROL        0xF1
+#define BLE_MSG_DEVICE_SETTINGS     0xF2
+#define BLE_MSG_DISCONNECTED        0xF3
+
+struct BleCommandMsg {
+    uint8_t type;           // BLE_CMD_* or BLE_MSG_*
+    uint8_t param1;         // BLE_Command.param1
+    uint16_t param2;        // BLE_Command.param2
+    union {
+        uint32_t value;     // SET_TIME timestamp, DELETE record_id, SET_DAILY_TOTAL ml
+        struct {
+            int32_t empty_adc;
+            int32_t full_adc;
+            float scale_factor;
+        } cal;              // CAL_SET_DATA
+        BLE_BottleConfig bottle_config;
+        BLE_SyncControl sync;
+        BLE_DeviceSettings settings;
+    } data;
+};
+
+// Follow-up work collected while draining, done once per batch
+struct BleCommandBatch {
+    bool recalculate_totals;
+    bool notify_state;
+};
+
+static MpscQueue<BleCommandMsg, BLE_CMD_QUEUE_DEPTH> g_cmd_queue;
+static volatile uint32_t g_cmd_dropped = 0;
 
 // Forward declaration for sync complete notification
 static void bleNotifyCurrentStateUpdate();
@@ -109,19 +166,50 @@ extern uint8_t rtc_low_battery_threshold;
 #define BLE_DEBUG_F(fmt, ...) if (g_debug_enabled && g_debug_ble) { Serial.printf("[BLE] " fmt "\n", ##__VA_ARGS__); }
 
 // Forward declarations
-void bleLoadBottleConfig();
 void bleSaveBottleConfig();
 void bleSyncSendNextChunk();
 void bleSendActivitySummary();
 void bleSendMotionEventChunk(uint8_t chunkIndex);
 void bleSendBackpackSessionChunk(uint8_t chunkIndex);
+#if ENABLE_TRACE_RECORDER
+static void bleSendTraceInfo();
+static void bleSendTraceChunk(uint16_t chunkIndex);
+#endif
+#if ENABLE_BOOT_PROFILE
+static void bleSendBootProfileStats(uint8_t wakeReason);
+static void bleSendBootProfileEntry(uint8_t index);
+#endif
+#if ENABLE_ENERGY_LEDGER
+static void bleSendEnergySummary();
+#endif
+
+// Recount unsynced records into the cache served to Sync Control reads (loop task)
+static uint16_t bleRefreshUnsyncedCount() {
+    g_unsynced_count = storageGetUnsyncedCount();
+    return g_unsynced_count;
+}
+
+// Push a message for the loop task (NimBLE host task - never blocks)
+static void bleQueueCommand(const BleCommandMsg& msg) {
+    if (!g_cmd_queue.push(msg)) {
+        g_cmd_dropped++;
+        Serial.printf("ERROR: BLE command queue full - dropped 0x%02X\n", msg.type);
+    }
+}
+
+static BleCommandMsg bleMakeCommand(uint8_t type) {
+    BleCommandMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = type;
+    return msg;
+}
 
 // Bottle Config characteristic callbacks
 class BottleConfigCallbacks : public NimBLECharacteristicCallbacks {
     void onRead(NimBLECharacteristic* pCharacteristic) {
         BLE_DEBUG("Bottle Config read");
-        // Reload from NVS to ensure fresh data
-        bleLoadBottleConfig();
+        // Serves the cached value - bleLoadBottleConfig() refreshes it on the
+        // loop task whenever the calibration or goal is saved
     }
 
     void onWrite(NimBLECharacteristic* pCharacteristic) {
@@ -130,33 +218,9 @@ class BottleConfigCallbacks : public NimBLECharacteristicCallbacks {
         // Get written data
         std::string value = pCharacteristic->getValue();
         if (value.length() == sizeof(BLE_BottleConfig)) {
-            memcpy(&bottleConfig, value.data(), sizeof(BLE_BottleConfig));
-
-            BLE_DEBUG_F("Config received: scale=%.2f, tare=%d, capacity=%d, goal=%d",
-                       bottleConfig.scale_factor, bottleConfig.tare_weight_grams,
-                       bottleConfig.bottle_capacity_ml, bottleConfig.daily_goal_ml);
-
-            // Validate scale_factor before accepting - prevents calibration corruption
-            // (Issue #84: iOS app was sending default/uninitialized scale_factor values)
-            if (bottleConfig.scale_factor < CALIBRATION_SCALE_FACTOR_MIN ||
-                bottleConfig.scale_factor > CALIBRATION_SCALE_FACTOR_MAX) {
-                BLE_DEBUG_F("WARNING: Invalid scale_factor %.2f (valid range: %.0f-%.0f), rejecting write",
-                           bottleConfig.scale_factor, CALIBRATION_SCALE_FACTOR_MIN, CALIBRATION_SCALE_FACTOR_MAX);
-                // Restore valid values from NVS
-                bleLoadBottleConfig();
-                return;
-            }
-
-            BLE_DEBUG("Config validated - saving to NVS");
-
-            // Save to NVS
-            bleSaveBottleConfig();
-
-            // Update display module with new goal (triggers redraw if changed)
-            displaySetDailyGoal(bottleConfig.daily_goal_ml);
-
-            // Trigger Current State update to reflect config change
-            // (Main loop will call bleUpdateCurrentState)
+            BleCommandMsg msg = bleMakeCommand(BLE_MSG_BOTTLE_CONFIG);
+            memcpy(&msg.data.bottle_config, value.data(), sizeof(BLE_BottleConfig));
+            bleQueueCommand(msg);
         } else {
             BLE_DEBUG_F("Invalid config size: %d bytes (expected %d)",
                        value.length(), sizeof(BLE_BottleConfig));
@@ -164,131 +228,48 @@ class BottleConfigCallbacks : public NimBLECharacteristicCallbacks {
     }
 };
 
-// Forward declarations for time handling
-extern bool g_time_valid;
-void drinksInit();          // Initialize drink tracking when time becomes valid
-bool drinksIsInitialized(); // Check if already initialized
-
-// Command characteristic callbacks
+// Command characteristic callbacks - parse only, handled in bleHandleCommand()
 class CommandCallbacks : public NimBLECharacteristicCallbacks {
     void onWrite(NimBLECharacteristic* pCharacteristic) {
         BLE_DEBUG("Command received");
-        g_ble_data_activity = true;  // Signal activity for timeout reset
 
         // Get written data
         std::string value = pCharacteristic->getValue();
 
-        // Check for SET_TIME command (5 bytes)
-        // Note: SET_TIME is housekeeping, not user interaction — don't reset activity timeout
+        // SET_TIME (5 bytes: cmd + 4-byte Unix timestamp)
         if (value.length() == sizeof(BLE_SetTimeCommand) && value[0] == BLE_CMD_SET_TIME) {
-            g_ble_data_activity = false;  // Undo the activity flag set above
             BLE_SetTimeCommand timeCmd;
             memcpy(&timeCmd, value.data(), sizeof(BLE_SetTimeCommand));
-
-            BLE_DEBUG_F("Command: SET_TIME, timestamp=%u", timeCmd.timestamp);
-
-            // Set the ESP32 RTC
-            struct timeval tv;
-            tv.tv_sec = timeCmd.timestamp;
-            tv.tv_usec = 0;
-
-            if (settimeofday(&tv, NULL) == 0) {
-                BLE_DEBUG("Time set successfully");
-
-                // Mark time as valid
-                g_time_valid = true;
-                storageSaveTimeValid(true);
-
-                // Initialize drink tracking if not already initialized
-                if (!drinksIsInitialized()) {
-                    drinksInit();
-                    Serial.println("[BLE] SET_TIME: initialized drink tracking");
-                } else {
-                    Serial.println("[BLE] SET_TIME: drink tracking already initialized, skipped drinksInit");
-                }
-
-                // Log the time we set (using gmtime_r to avoid IRAM overhead)
-                time_t now = time(NULL);
-                struct tm timeinfo;
-                gmtime_r(&now, &timeinfo);
-                char timeStr[32];
-                snprintf(timeStr, sizeof(timeStr), "%04d-%02d-%02d %02d:%02d:%02d",
-                         timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
-                         timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-                BLE_DEBUG_F("Device time set to: %s", timeStr);
-            } else {
-                BLE_DEBUG("ERROR: Failed to set time");
-            }
+            BleCommandMsg msg = bleMakeCommand(BLE_CMD_SET_TIME);
+            msg.data.value = timeCmd.timestamp;
+            bleQueueCommand(msg);
             return;
         }
 
-        // Check for SET_DAILY_TOTAL command (3 bytes: cmd + 2-byte little-endian value)
-        // DEPRECATED: Kept for backwards compatibility, but apps should use DELETE_DRINK_RECORD
+        // SET_DAILY_TOTAL (3 bytes: cmd + 2-byte little-endian value) - DEPRECATED
         if (value.length() == 3 && value[0] == BLE_CMD_SET_DAILY_TOTAL) {
-            uint16_t dailyTotal = (uint8_t)value[1] | ((uint8_t)value[2] << 8);
-            BLE_DEBUG_F("Command: SET_DAILY_TOTAL to %dml (DEPRECATED)", dailyTotal);
-            g_ble_set_daily_total_value = dailyTotal;
-            g_ble_set_daily_total_requested = true;
-            g_ble_force_display_refresh = true;  // Force display update
+            BleCommandMsg msg = bleMakeCommand(BLE_CMD_SET_DAILY_TOTAL);
+            msg.data.value = (uint8_t)value[1] | ((uint8_t)value[2] << 8);
+            bleQueueCommand(msg);
             return;
         }
 
-        // Check for CAL_SET_DATA command (13 bytes: cmd + empty_adc + full_adc + scale_factor)
+        // CAL_SET_DATA (13 bytes: cmd + empty_adc + full_adc + scale_factor, little-endian)
         if (value.length() == 13 && value[0] == BLE_CMD_CAL_SET_DATA) {
-            // Parse calibration data (all little-endian)
-            int32_t empty_adc, full_adc;
-            float scale_factor;
-
-            memcpy(&empty_adc, &value[1], sizeof(int32_t));
-            memcpy(&full_adc, &value[5], sizeof(int32_t));
-            memcpy(&scale_factor, &value[9], sizeof(float));
-
-            BLE_DEBUG_F("Command: CAL_SET_DATA empty=%d, full=%d, scale=%.2f",
-                       empty_adc, full_adc, scale_factor);
-
-            // Validate calibration data
-            if (scale_factor <= 0.0f || full_adc <= empty_adc) {
-                BLE_DEBUG("ERROR: Invalid calibration data");
-                return;
-            }
-
-            // Create and save calibration data
-            CalibrationData cal;
-            cal.empty_bottle_adc = empty_adc;
-            cal.full_bottle_adc = full_adc;
-            cal.scale_factor = scale_factor;
-
-            if (storageSaveCalibration(cal)) {
-                BLE_DEBUG("Calibration saved to NVS");
-                g_cal_mode = false;          // Exit calibration mode
-                g_cal_result_ready = false;  // Clear calibration result flag
-                g_ble_force_display_refresh = true;
-                bleNotifyCurrentStateUpdate();
-            } else {
-                BLE_DEBUG("ERROR: Failed to save calibration to NVS");
-                g_cal_mode = false;          // Exit calibration mode even on error
-            }
+            BleCommandMsg msg = bleMakeCommand(BLE_CMD_CAL_SET_DATA);
+            memcpy(&msg.data.cal.empty_adc, &value[1], sizeof(int32_t));
+            memcpy(&msg.data.cal.full_adc, &value[5], sizeof(int32_t));
+            memcpy(&msg.data.cal.scale_factor, &value[9], sizeof(float));
+            bleQueueCommand(msg);
             return;
         }
 
-        // Check for DELETE_DRINK_RECORD command (5 bytes: cmd + 4-byte record_id)
+        // DELETE_DRINK_RECORD (5 bytes: cmd + 4-byte record_id)
         if (value.length() == 5 && value[0] == BLE_CMD_DELETE_DRINK_RECORD) {
-            uint32_t recordId = (uint8_t)value[1] | ((uint8_t)value[2] << 8) |
-                               ((uint8_t)value[3] << 16) | ((uint8_t)value[4] << 24);
-
-            BLE_DEBUG_F("Command: DELETE_DRINK_RECORD id=%lu", recordId);
-
-            bool found = storageMarkDeleted(recordId);
-            if (found) {
-                drinksRecalculateTotals();
-                BLE_DEBUG_F("DELETE_DRINK_RECORD: %lu deleted, total recalculated", recordId);
-            } else {
-                BLE_DEBUG_F("DELETE_DRINK_RECORD: %lu not found (rolled off)", recordId);
-            }
-
-            // Always notify - either way, the delete is "successful" from the app's perspective
-            g_ble_force_display_refresh = true;
-            bleNotifyCurrentStateUpdate();
+            BleCommandMsg msg = bleMakeCommand(BLE_CMD_DELETE_DRINK_RECORD);
+            msg.data.value = (uint8_t)value[1] | ((uint8_t)value[2] << 8) |
+                             ((uint8_t)value[3] << 16) | ((uint32_t)(uint8_t)value[4] << 24);
+            bleQueueCommand(msg);
             return;
         }
 
@@ -296,98 +277,10 @@ class CommandCallbacks : public NimBLECharacteristicCallbacks {
         if (value.length() == sizeof(BLE_Command)) {
             BLE_Command cmd;
             memcpy(&cmd, value.data(), sizeof(BLE_Command));
-
-            BLE_DEBUG_F("Command: 0x%02X, param1=%d, param2=%d",
-                       cmd.command, cmd.param1, cmd.param2);
-
-            // Set flags for main loop to handle
-            switch (cmd.command) {
-                case BLE_CMD_PING:
-                    BLE_DEBUG("Command: PING (activity timeout reset)");
-                    // No action needed - g_ble_data_activity already set above
-                    break;
-
-                case BLE_CMD_TARE_NOW:
-                    BLE_DEBUG("Command: TARE_NOW");
-                    g_ble_tare_requested = true;
-                    break;
-
-                case BLE_CMD_RESET_DAILY:
-                    BLE_DEBUG("Command: RESET_DAILY");
-                    g_ble_reset_daily_requested = true;
-                    break;
-
-                case BLE_CMD_CLEAR_HISTORY:
-                    BLE_DEBUG("Command: CLEAR_HISTORY (WARNING)");
-                    g_ble_clear_history_requested = true;
-                    break;
-
-                case BLE_CMD_START_CALIBRATION:
-                    // Bottle-driven calibration (Plan 060): iOS requests start, bottle runs state machine
-                    BLE_DEBUG("Command: START_CALIBRATION (bottle-driven)");
-                    g_ble_calibration_start_requested = true;
-                    g_cal_mode = true;  // Block sleep during calibration
-                    break;
-
-                case BLE_CMD_CANCEL_CALIBRATION:
-                    // Cancel ongoing bottle-driven calibration
-                    BLE_DEBUG("Command: CANCEL_CALIBRATION");
-                    g_ble_calibration_cancel_requested = true;
-                    break;
-
-                case BLE_CMD_GET_ACTIVITY_SUMMARY:
-                    BLE_DEBUG("Command: GET_ACTIVITY_SUMMARY");
-                    bleSendActivitySummary();
-                    break;
-
-                case BLE_CMD_GET_MOTION_CHUNK:
-                    BLE_DEBUG_F("Command: GET_MOTION_CHUNK, chunk=%d", cmd.param1);
-                    bleSendMotionEventChunk(cmd.param1);
-                    break;
-
-                case BLE_CMD_GET_BACKPACK_CHUNK:
-                    BLE_DEBUG_F("Command: GET_BACKPACK_CHUNK, chunk=%d", cmd.param1);
-                    bleSendBackpackSessionChunk(cmd.param1);
-                    break;
-
-                case BLE_CMD_CAL_MEASURE_POINT: {
-                    // iOS-driven calibration: take stable measurement
-                    // param1: 0 = empty bottle, 1 = full bottle
-                    uint8_t pointType = cmd.param1;
-                    BLE_DEBUG_F("Command: CAL_MEASURE_POINT, point=%s", pointType == 0 ? "empty" : "full");
-
-                    // Enter calibration mode (blocks sleep until CAL_SET_DATA or disconnect)
-                    g_cal_mode = true;
-                    g_cal_measuring = true;
-                    g_cal_result_ready = false;
-                    bleNotifyCurrentStateUpdate();
-
-                    // Take stable measurement (uses default 10s duration with variance check)
-                    // Note: This blocks the BLE callback, but NimBLE handles it
-                    WeightMeasurement result = weightMeasureStable();
-
-                    g_cal_measuring = false;
-                    if (result.valid && result.stable) {
-                        g_cal_last_adc = result.raw_adc;
-                        g_cal_result_ready = true;
-                        BLE_DEBUG_F("Calibration measurement complete: ADC=%d, stable=%d",
-                                   result.raw_adc, result.stable);
-                    } else {
-                        g_cal_last_adc = result.raw_adc;  // Still report the ADC even if unstable
-                        g_cal_result_ready = true;  // Let iOS decide what to do
-                        BLE_DEBUG_F("Calibration measurement: ADC=%d, valid=%d, stable=%d (warning)",
-                                   result.raw_adc, result.valid, result.stable);
-                    }
-
-                    // Notify iOS with result
-                    bleNotifyCurrentStateUpdate();
-                    break;
-                }
-
-                default:
-                    BLE_DEBUG_F("Unknown command: 0x%02X", cmd.command);
-                    break;
-            }
+            BleCommandMsg msg = bleMakeCommand(cmd.command);
+            msg.param1 = cmd.param1;
+            msg.param2 = cmd.param2;
+            bleQueueCommand(msg);
         } else {
             BLE_DEBUG_F("Invalid command size: %d bytes (expected 4 or 5)",
                        value.length());
@@ -400,14 +293,13 @@ class SyncControlCallbacks : public NimBLECharacteristicCallbacks {
     void onRead(NimBLECharacteristic* pCharacteristic) {
         BLE_DEBUG("Sync Control read");
         g_ble_data_activity = true;  // Signal activity for timeout reset
-        // Update status with current unsynced count
-        syncControl.count = storageGetUnsyncedCount();
+        // Update status with the cached unsynced count
+        syncControl.count = g_unsynced_count;
         pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
     }
 
     void onWrite(NimBLECharacteristic* pCharacteristic) {
         BLE_DEBUG("Sync Control write");
-        g_ble_data_activity = true;  // Signal activity for timeout reset
 
         // Get written data
         std::string value = pCharacteristic->getValue();
@@ -417,152 +309,486 @@ class SyncControlCallbacks : public NimBLECharacteristicCallbacks {
             return;
         }
 
-        BLE_SyncControl request;
-        memcpy(&request, value.data(), sizeof(BLE_SyncControl));
+        BleCommandMsg msg = bleMakeCommand(BLE_MSG_SYNC_CONTROL);
+        memcpy(&msg.data.sync, value.data(), sizeof(BLE_SyncControl));
+        bleQueueCommand(msg);
+    }
+};
 
-        BLE_DEBUG_F("Sync command: %d, start=%d, count=%d, chunk_size=%d",
-                   request.command, request.start_index, request.count, request.chunk_size);
+// Device Settings characteristic callbacks
+class DeviceSettingsCallbacks : public NimBLECharacteristicCallbacks {
+    void onRead(NimBLECharacteristic* pCharacteristic) {
+        BLE_DEBUG("Device Settings read");
+        // Serve the cache (loaded at init, updated when settings are saved)
+        pCharacteristic->setValue((uint8_t*)&deviceSettings, sizeof(deviceSettings));
+    }
 
-        // Handle sync commands
-        switch (request.command) {
-            case 0: // QUERY
-                BLE_DEBUG("Sync: QUERY");
-                syncControl.count = storageGetUnsyncedCount();
-                syncControl.status = 0; // IDLE
-                pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
-                break;
+    void onWrite(NimBLECharacteristic* pCharacteristic) {
+        BLE_DEBUG("Device Settings write");
+
+        // Get written data
+        std::string value = pCharacteristic->getValue();
+        if (value.length() == sizeof(BLE_DeviceSettings)) {
+            BleCommandMsg msg = bleMakeCommand(BLE_MSG_DEVICE_SETTINGS);
+            memcpy(&msg.data.settings, value.data(), sizeof(BLE_DeviceSettings));
+            bleQueueCommand(msg);
+        } else {
+            BLE_DEBUG_F("Invalid device settings size: %d bytes (expected %d)",
+                       value.length(), sizeof(BLE_DeviceSettings));
+        }
+    }
+};
 
-            case 1: // START
-                BLE_DEBUG_F("Sync: START (count=%d)", request.count);
+// ==================== Command handlers (loop task) ====================
 
-                // Free previous buffer if exists
-                if (syncBuffer != nullptr) {
-                    delete[] syncBuffer;
-                    syncBuffer = nullptr;
-                }
+// Forward declarations for time handling
+extern bool g_time_valid;
+void drinksInit();          // Initialize drink tracking when time becomes valid
+bool drinksIsInitialized(); // Check if already initialized
 
-                // Allocate buffer for unsynced records
-                syncBufferSize = 0;
-                syncBuffer = new DrinkRecord[request.count];
-
-                if (syncBuffer == nullptr) {
-                    BLE_DEBUG("ERROR: Failed to allocate sync buffer");
-                    syncControl.status = 0; // IDLE
-                    syncControl.count = 0;
-                    pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
-                    return;
-                }
-
-                // Load unsynced records
-                if (!storageGetUnsyncedRecords(syncBuffer, request.count, syncBufferSize)) {
-                    BLE_DEBUG("ERROR: Failed to load unsynced records");
-                    delete[] syncBuffer;
-                    syncBuffer = nullptr;
-                    syncControl.status = 0; // IDLE
-                    syncControl.count = 0;
-                    pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
-                    return;
-                }
-
-                // Setup sync state
-                syncControl.start_index = 0;
-                syncControl.count = syncBufferSize;
-                syncControl.chunk_size = (request.chunk_size > 0 && request.chunk_size <= 20)
-                                        ? request.chunk_size : 20;
-                syncControl.status = 1; // IN_PROGRESS
-                syncCurrentChunk = 0;
-
-                BLE_DEBUG_F("Sync started: %d records, chunk_size=%d",
-                           syncBufferSize, syncControl.chunk_size);
-
-                // Update characteristic and send first chunk
-                pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
-                bleSyncSendNextChunk();
-                break;
+static void bleHandleBottleConfig(const BLE_BottleConfig& config) {
+    memcpy(&bottleConfig, &config, sizeof(BLE_BottleConfig));
 
-            case 2: { // ACK
-                BLE_DEBUG_F("Sync: ACK chunk %d", syncCurrentChunk);
+    BLE_DEBUG_F("Config received: scale=%.2f, tare=%d, capacity=%d, goal=%d",
+               bottleConfig.scale_factor, bottleConfig.tare_weight_grams,
+               bottleConfig.bottle_capacity_ml, bottleConfig.daily_goal_ml);
 
-                if (syncControl.status != 1) {
-                    BLE_DEBUG("ERROR: Received ACK but sync not in progress");
-                    return;
-                }
+    // Validate scale_factor before accepting - prevents calibration corruption
+    // (Issue #84: iOS app was sending default/uninitialized scale_factor values)
+    if (bottleConfig.scale_factor < CALIBRATION_SCALE_FACTOR_MIN ||
+        bottleConfig.scale_factor > CALIBRATION_SCALE_FACTOR_MAX) {
+        BLE_DEBUG_F("WARNING: Invalid scale_factor %.2f (valid range: %.0f-%.0f), rejecting write",
+                   bottleConfig.scale_factor, CALIBRATION_SCALE_FACTOR_MIN, CALIBRATION_SCALE_FACTOR_MAX);
+        // Restore valid values from NVS
+        bleLoadBottleConfig();
+        return;
+    }
 
-                // Move to next chunk
-                syncCurrentChunk++;
+    BLE_DEBUG("Config validated - saving to NVS");
 
-                // Calculate total chunks
-                uint16_t total_chunks = (syncBufferSize + syncControl.chunk_size - 1) / syncControl.chunk_size;
+    // Save to NVS, then refresh the cache reads are served from (the save may
+    // have kept the stored scale factor)
+    bleSaveBottleConfig();
+    bleLoadBottleConfig();
 
-                if (syncCurrentChunk >= total_chunks) {
-                    // Sync complete - mark all records as synced
-                    BLE_DEBUG("Sync: COMPLETE");
+    // Update display module with new goal (triggers redraw if changed)
+    displaySetDailyGoal(bottleConfig.daily_goal_ml);
 
-                    // Mark records as synced in NVS
-                    storageMarkSynced(0, syncBufferSize);
+    // Trigger Current State update to reflect config change
+    // (Main loop will call bleUpdateCurrentState)
+}
 
-                    // Free buffer
-                    delete[] syncBuffer;
-                    syncBuffer = nullptr;
-                    syncBufferSize = 0;
+static void bleHandleSetTime(uint32_t timestamp) {
+    BLE_DEBUG_F("Command: SET_TIME, timestamp=%u", timestamp);
 
-                    // Update state
-                    syncControl.status = 2; // COMPLETE
-                    pCharacteristic->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+    // Set the ESP32 RTC
+    struct timeval tv;
+    tv.tv_sec = timestamp;
+    tv.tv_usec = 0;
 
-                    // Reset to IDLE after brief delay
-                    syncControl.status = 0; // IDLE
-                    syncControl.count = 0;
+    if (settimeofday(&tv, NULL) == 0) {
+        BLE_DEBUG("Time set successfully");
 
-                    // Notify app of updated unsynced count (should now be 0)
-                    bleNotifyCurrentStateUpdate();
-                } else {
-                    // Send next chunk
-                    bleSyncSendNextChunk();
-                }
-                break;
-            }
+        // Mark time as valid
+        g_time_valid = true;
+        storageSaveTimeValid(true);
 
-            default:
-                BLE_DEBUG_F("Unknown sync command: %d", request.command);
-                break;
+        // Initialize drink tracking if not already initialized
+        if (!drinksIsInitialized()) {
+            drinksInit();
+            Serial.println("[BLE] SET_TIME: initialized drink tracking");
+        } else {
+            Serial.println("[BLE] SET_TIME: drink tracking already initialized, skipped drinksInit");
         }
+
+        // Log the time we set (using gmtime_r to avoid IRAM overhead)
+        time_t now = time(NULL);
+        struct tm timeinfo;
+        gmtime_r(&now, &timeinfo);
+        char timeStr[32];
+        snprintf(timeStr, sizeof(timeStr), "%04d-%02d-%02d %02d:%02d:%02d",
+                 timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+                 timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+        BLE_DEBUG_F("Device time set to: %s", timeStr);
+    } else {
+        BLE_DEBUG("ERROR: Failed to set time");
     }
-};
+}
 
-// Device Settings characteristic callbacks
-class DeviceSettingsCallbacks : public NimBLECharacteristicCallbacks {
-    void onRead(NimBLECharacteristic* pCharacteristic) {
-        BLE_DEBUG("Device Settings read");
-        // Load from NVS to ensure fresh data
-        bool shakeEnabled = storageLoadShakeToEmptyEnabled();
-        deviceSettings.flags = shakeEnabled ? DEVICE_SETTINGS_FLAG_SHAKE_EMPTY_ENABLED : 0;
-        pCharacteristic->setValue((uint8_t*)&deviceSettings, sizeof(deviceSettings));
+static void bleHandleCalSetData(int32_t empty_adc, int32_t full_adc, float scale_factor,
+                                BleCommandBatch& batch) {
+    BLE_DEBUG_F("Command: CAL_SET_DATA empty=%d, full=%d, scale=%.2f",
+               empty_adc, full_adc, scale_factor);
+
+    // Validate calibration data
+    if (scale_factor <= 0.0f || full_adc <= empty_adc) {
+        BLE_DEBUG("ERROR: Invalid calibration data");
+        return;
     }
 
-    void onWrite(NimBLECharacteristic* pCharacteristic) {
-        BLE_DEBUG("Device Settings write");
-        g_ble_data_activity = true;  // Signal activity for timeout reset
+    // Create and save calibration data
+    CalibrationData cal;
+    cal.empty_bottle_adc = empty_adc;
+    cal.full_bottle_adc = full_adc;
+    cal.scale_factor = scale_factor;
 
-        // Get written data
-        std::string value = pCharacteristic->getValue();
-        if (value.length() == sizeof(BLE_DeviceSettings)) {
-            memcpy(&deviceSettings, value.data(), sizeof(BLE_DeviceSettings));
+    if (storageSaveCalibration(cal)) {
+        BLE_DEBUG("Calibration saved to NVS");
+        bleLoadBottleConfig();
+        g_cal_mode = false;          // Exit calibration mode
+        g_cal_result_ready = false;  // Clear calibration result flag
+        g_ble_force_display_refresh = true;
+        batch.notify_state = true;
+    } else {
+        BLE_DEBUG("ERROR: Failed to save calibration to NVS");
+        g_cal_mode = false;          // Exit calibration mode even on error
+    }
+}
+
+static void bleHandleDeleteRecord(uint32_t recordId, BleCommandBatch& batch) {
+    BLE_DEBUG_F("Command: DELETE_DRINK_RECORD id=%lu", recordId);
 
-            // Extract shake-to-empty setting
-            bool shakeEnabled = (deviceSettings.flags & DEVICE_SETTINGS_FLAG_SHAKE_EMPTY_ENABLED) != 0;
+    bool found = storageMarkDeleted(recordId);
+    if (found) {
+        batch.recalculate_totals = true;  // Once per batch, after all deletes
+        BLE_DEBUG_F("DELETE_DRINK_RECORD: %lu deleted", recordId);
+    } else {
+        BLE_DEBUG_F("DELETE_DRINK_RECORD: %lu not found (rolled off)", recordId);
+    }
 
-            BLE_DEBUG_F("Device Settings updated: shake_to_empty=%s",
-                       shakeEnabled ? "enabled" : "disabled");
+    // Always notify - either way, the delete is "successful" from the app's perspective
+    g_ble_force_display_refresh = true;
+    batch.notify_state = true;
+}
 
-            // Save to NVS
-            storageSaveShakeToEmptyEnabled(shakeEnabled);
-        } else {
-            BLE_DEBUG_F("Invalid device settings size: %d bytes (expected %d)",
-                       value.length(), sizeof(BLE_DeviceSettings));
+static void bleHandleCalMeasurePoint(uint8_t pointType) {
+    // iOS-driven calibration: take stable measurement
+    // param1: 0 = empty bottle, 1 = full bottle
+    BLE_DEBUG_F("Command: CAL_MEASURE_POINT, point=%s", pointType == 0 ? "empty" : "full");
+
+    // Enter calibration mode (blocks sleep until CAL_SET_DATA or disconnect)
+    g_cal_mode = true;
+    g_cal_measuring = true;
+    g_cal_result_ready = false;
+    bleNotifyCurrentStateUpdate();
+
+    // Take stable measurement. Blocks the loop task for the measurement window
+    // (bottle is stationary during calibration); the sensor task is paused for it.
+    WeightMeasurement result = weightMeasureStable();
+
+    g_cal_measuring = false;
+    if (result.valid && result.stable) {
+        g_cal_last_adc = result.raw_adc;
+        g_cal_result_ready = true;
+        BLE_DEBUG_F("Calibration measurement complete: ADC=%d, stable=%d",
+                   result.raw_adc, result.stable);
+    } else {
+        g_cal_last_adc = result.raw_adc;  // Still report the ADC even if unstable
+        g_cal_result_ready = true;  // Let iOS decide what to do
+        BLE_DEBUG_F("Calibration measurement: ADC=%d, valid=%d, stable=%d (warning)",
+                   result.raw_adc, result.valid, result.stable);
+    }
+
+    // Notify iOS with result
+    bleNotifyCurrentStateUpdate();
+}
+
+static void bleHandleSyncControl(const BLE_SyncControl& request) {
+    BLE_DEBUG_F("Sync command: %d, start=%d, count=%d, chunk_size=%d",
+               request.command, request.start_index, request.count, request.chunk_size);
+
+    // Handle sync commands
+    switch (request.command) {
+        case 0: // QUERY
+            BLE_DEBUG("Sync: QUERY");
+            syncControl.count = bleRefreshUnsyncedCount();
+            syncControl.status = 0; // IDLE
+            pSyncControlChar->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+            break;
+
+        case 1: // START
+            BLE_DEBUG_F("Sync: START (count=%d)", request.count);
+
+            // Free previous buffer if exists
+            if (syncBuffer != nullptr) {
+                delete[] syncBuffer;
+                syncBuffer = nullptr;
+            }
+
+            // Allocate buffer for unsynced records
+            syncBufferSize = 0;
+            syncBuffer = new DrinkRecord[request.count];
+
+            if (syncBuffer == nullptr) {
+                BLE_DEBUG("ERROR: Failed to allocate sync buffer");
+                syncControl.status = 0; // IDLE
+                syncControl.count = 0;
+                pSyncControlChar->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+                return;
+            }
+
+            // Load unsynced records
+            if (!storageGetUnsyncedRecords(syncBuffer, request.count, syncBufferSize)) {
+                BLE_DEBUG("ERROR: Failed to load unsynced records");
+                delete[] syncBuffer;
+                syncBuffer = nullptr;
+                syncControl.status = 0; // IDLE
+                syncControl.count = 0;
+                pSyncControlChar->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+                return;
+            }
+
+            // Setup sync state
+            syncControl.start_index = 0;
+            syncControl.count = syncBufferSize;
+            syncControl.chunk_size = (request.chunk_size > 0 && request.chunk_size <= 20)
+                                    ? request.chunk_size : 20;
+            syncControl.status = 1; // IN_PROGRESS
+            syncCurrentChunk = 0;
+
+            BLE_DEBUG_F("Sync started: %d records, chunk_size=%d",
+                       syncBufferSize, syncControl.chunk_size);
+
+            // Update characteristic and send first chunk
+            pSyncControlChar->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+            bleSyncSendNextChunk();
+            break;
+
+        case 2: { // ACK
+            BLE_DEBUG_F("Sync: ACK chunk %d", syncCurrentChunk);
+
+            if (syncControl.status != 1) {
+                BLE_DEBUG("ERROR: Received ACK but sync not in progress");
+                return;
+            }
+
+            // Move to next chunk
+            syncCurrentChunk++;
+
+            // Calculate total chunks
+            uint16_t total_chunks = (syncBufferSize + syncControl.chunk_size - 1) / syncControl.chunk_size;
+
+            if (syncCurrentChunk >= total_chunks) {
+                // Sync complete - mark all records as synced
+                BLE_DEBUG("Sync: COMPLETE");
+
+                // Mark records as synced in NVS
+                storageMarkSynced(0, syncBufferSize);
+
+                // Free buffer
+                delete[] syncBuffer;
+                syncBuffer = nullptr;
+                syncBufferSize = 0;
+
+                // Update state
+                syncControl.status = 2; // COMPLETE
+                pSyncControlChar->setValue((uint8_t*)&syncControl, sizeof(syncControl));
+
+                // Reset to IDLE after brief delay
+                syncControl.status = 0; // IDLE
+                syncControl.count = 0;
+
+                // Notify app of updated unsynced count (should now be 0)
+                bleNotifyCurrentStateUpdate();
+            } else {
+                // Send next chunk
+                bleSyncSendNextChunk();
+            }
+            break;
         }
+
+        default:
+            BLE_DEBUG_F("Unknown sync command: %d", request.command);
+            break;
+    }
+}
+
+static void bleHandleDeviceSettings(const BLE_DeviceSettings& settings) {
+    memcpy(&deviceSettings, &settings, sizeof(BLE_DeviceSettings));
+
+    // Extract shake-to-empty setting
+    bool shakeEnabled = (deviceSettings.flags & DEVICE_SETTINGS_FLAG_SHAKE_EMPTY_ENABLED) != 0;
+
+    BLE_DEBUG_F("Device Settings updated: shake_to_empty=%s",
+               shakeEnabled ? "enabled" : "disabled");
+
+    // Save to NVS, then refresh the cached value that reads are served from
+    storageSaveShakeToEmptyEnabled(shakeEnabled);
+    pDeviceSettingsChar->setValue((uint8_t*)&deviceSettings, sizeof(deviceSettings));
+}
+
+static void bleHandleCommand(const BleCommandMsg& msg, BleCommandBatch& batch) {
+    // Signal activity for timeout reset (SET_TIME is housekeeping, not user interaction)
+    if (msg.type != BLE_CMD_SET_TIME && msg.type != BLE_MSG_BOTTLE_CONFIG &&
+        msg.type != BLE_MSG_DISCONNECTED) {
+        g_ble_data_activity = true;
+    }
+
+    switch (msg.type) {
+        case BLE_MSG_BOTTLE_CONFIG:
+            bleHandleBottleConfig(msg.data.bottle_config);
+            break;
+
+        case BLE_MSG_SYNC_CONTROL:
+            bleHandleSyncControl(msg.data.sync);
+            break;
+
+        case BLE_MSG_DEVICE_SETTINGS:
+            bleHandleDeviceSettings(msg.data.settings);
+            break;
+
+        case BLE_MSG_DISCONNECTED:
+            // Clear calibration mode if disconnected mid-calibration
+            if (g_cal_mode) {
+                BLE_DEBUG("Calibration abandoned due to disconnect");
+                g_cal_mode = false;
+                g_cal_measuring = false;
+                g_cal_result_ready = false;
+            }
+            break;
+
+        case BLE_CMD_SET_TIME:
+            bleHandleSetTime(msg.data.value);
+            break;
+
+        case BLE_CMD_SET_DAILY_TOTAL:
+            // DEPRECATED: Kept for backwards compatibility, but apps should use DELETE_DRINK_RECORD
+            BLE_DEBUG_F("Command: SET_DAILY_TOTAL to %dml (DEPRECATED)", (uint16_t)msg.data.value);
+            g_ble_set_daily_total_value = (uint16_t)msg.data.value;
+            g_ble_set_daily_total_requested = true;
+            g_ble_force_display_refresh = true;  // Force display update
+            break;
+
+        case BLE_CMD_CAL_SET_DATA:
+            bleHandleCalSetData(msg.data.cal.empty_adc, msg.data.cal.full_adc,
+                                msg.data.cal.scale_factor, batch);
+            break;
+
+        case BLE_CMD_DELETE_DRINK_RECORD:
+            bleHandleDeleteRecord(msg.data.value, batch);
+            break;
+
+        case BLE_CMD_PING:
+            BLE_DEBUG("Command: PING (activity timeout reset)");
+            // No action needed - g_ble_data_activity already set above
+            break;
+
+        case BLE_CMD_TARE_NOW:
+            BLE_DEBUG("Command: TARE_NOW");
+            g_ble_tare_requested = true;
+            break;
+
+        case BLE_CMD_RESET_DAILY:
+            BLE_DEBUG("Command: RESET_DAILY");
+            g_ble_reset_daily_requested = true;
+            break;
+
+        case BLE_CMD_CLEAR_HISTORY:
+            BLE_DEBUG("Command: CLEAR_HISTORY (WARNING)");
+            g_ble_clear_history_requested = true;
+            break;
+
+        case BLE_CMD_START_CALIBRATION:
+            // Bottle-driven calibration (Plan 060): iOS requests start, bottle runs state machine
+            BLE_DEBUG("Command: START_CALIBRATION (bottle-driven)");
+            g_ble_calibration_start_requested = true;
+            g_cal_mode = true;  // Block sleep during calibration
+            break;
+
+        case BLE_CMD_CANCEL_CALIBRATION:
+            // Cancel ongoing bottle-driven calibration
+            BLE_DEBUG("Command: CANCEL_CALIBRATION");
+            g_ble_calibration_cancel_requested = true;
+            break;
+
+        case BLE_CMD_GET_ACTIVITY_SUMMARY:
+            BLE_DEBUG("Command: GET_ACTIVITY_SUMMARY");
+            bleSendActivitySummary();
+            break;
+
+        case BLE_CMD_GET_MOTION_CHUNK:
+            BLE_DEBUG_F("Command: GET_MOTION_CHUNK, chunk=%d", msg.param1);
+            bleSendMotionEventChunk(msg.param1);
+            break;
+
+        case BLE_CMD_GET_BACKPACK_CHUNK:
+            BLE_DEBUG_F("Command: GET_BACKPACK_CHUNK, chunk=%d", msg.param1);
+            bleSendBackpackSessionChunk(msg.param1);
+            break;
+
+#if ENABLE_TRACE_RECORDER
+        case BLE_CMD_GET_TRACE_INFO:
+            BLE_DEBUG("Command: GET_TRACE_INFO");
+            bleSendTraceInfo();
+            break;
+
+        case BLE_CMD_GET_TRACE_CHUNK:
+            BLE_DEBUG_F("Command: GET_TRACE_CHUNK, chunk=%d", msg.param2);
+            bleSendTraceChunk(msg.param2);
+            break;
+
+        case BLE_CMD_SET_TRACE_ENABLED:
+            BLE_DEBUG_F("Command: SET_TRACE_ENABLED, enabled=%d", msg.param1);
+            traceRecorderSetEnabled(msg.param1 != 0);
+            bleSendTraceInfo();
+            break;
+#endif
+
+#if ENABLE_BOOT_PROFILE
+        case BLE_CMD_GET_BOOT_PROFILE:
+            BLE_DEBUG_F("Command: GET_BOOT_PROFILE, wake_reason=%d", msg.param1);
+            bleSendBootProfileStats(msg.param1);
+            break;
+
+        case BLE_CMD_GET_BOOT_PROFILE_ENTRY:
+            BLE_DEBUG_F("Command: GET_BOOT_PROFILE_ENTRY, index=%d", msg.param1);
+            bleSendBootProfileEntry(msg.param1);
+            break;
+#endif
+
+#if ENABLE_ENERGY_LEDGER
+        case BLE_CMD_GET_ENERGY_SUMMARY:
+            BLE_DEBUG("Command: GET_ENERGY_SUMMARY");
+            bleSendEnergySummary();
+            break;
+#endif
+
+        case BLE_CMD_CAL_MEASURE_POINT:
+            bleHandleCalMeasurePoint(msg.param1);
+            break;
+
+        default:
+            BLE_DEBUG_F("Unknown command: 0x%02X", msg.type);
+            break;
+    }
+}
+
+// Drain the command queue (loop task). Bounded per call so a burst of writes
+// can't starve the rest of the loop; follow-up work runs once per batch.
+static void bleProcessCommands() {
+    BleCommandMsg msg;
+    BleCommandBatch batch = {false, false};
+    uint8_t processed = 0;
+
+    while (processed < BLE_CMD_DRAIN_MAX && g_cmd_queue.pop(msg)) {
+        bleHandleCommand(msg, batch);
+        processed++;
     }
-};
+
+    if (batch.recalculate_totals) {
+        drinksRecalculateTotals();
+        BLE_DEBUG("Daily total recalculated after delete batch");
+    }
+    if (batch.notify_state) {
+        bleNotifyCurrentStateUpdate();
+    }
+    if (processed > 1) {
+        BLE_DEBUG_F("Processed %u queued commands", processed);
+    }
+
+    // Full CPU clock only while a drink record sync is streaming
+    powerMgmtSetHeld(POWER_LOCK_BLE_SYNC, bleIsSyncing());
+}
 
 // Server callbacks
 class AquavateServerCallbacks : public NimBLEServerCallbacks {
@@ -580,13 +806,9 @@ class AquavateServerCallbacks : public NimBLEServerCallbacks {
         BLE_DEBUG("Client disconnected");
         isConnected = false;
 
-        // Clear calibration mode if disconnected mid-calibration
-        if (g_cal_mode) {
-            BLE_DEBUG("Calibration abandoned due to disconnect");
-            g_cal_mode = false;
-            g_cal_measuring = false;
-            g_cal_result_ready = false;
-        }
+        // Clear calibration mode if disconnected mid-calibration (loop task)
+        BleCommandMsg msg = bleMakeCommand(BLE_MSG_DISCONNECTED);
+        bleQueueCommand(msg);
 
         // Restart advertising for next connection
         // Note: Main loop will handle advertising timeout logic
@@ -606,17 +828,17 @@ void bleLoadBottleConfig() {
         bottleConfig.tare_weight_grams = (int32_t)(cal.empty_bottle_adc / cal.scale_factor);
         bottleConfig.bottle_capacity_ml = 830; // Default capacity (could be configurable later)
 
-        // Update characteristic value
-        if (pBottleConfigChar) {
-            pBottleConfigChar->setValue((uint8_t*)&bottleConfig, sizeof(bottleConfig));
-        }
-
         BLE_DEBUG_F("Loaded config: scale=%.2f, tare=%d, capacity=%d, goal=%d",
                    bottleConfig.scale_factor, bottleConfig.tare_weight_grams,
                    bottleConfig.bottle_capacity_ml, bottleConfig.daily_goal_ml);
     } else {
         BLE_DEBUG_F("No calibration data found in NVS (goal=%dml)", bottleConfig.daily_goal_ml);
     }
+
+    // Update characteristic value (reads are served from it)
+    if (pBottleConfigChar) {
+        pBottleConfigChar->setValue((uint8_t*)&bottleConfig, sizeof(bottleConfig));
+    }
 }
 
 // Save bottle config to NVS
@@ -739,6 +961,14 @@ bool bleInit() {
     NimBLEDevice::setPower(ESP_PWR_LVL_N0); // 0dBm (ESP_PWR_LVL_N0 = 0dBm)
     NimBLEDevice::setMTU(BLE_MTU_SIZE);
 
+#if CONFIG_IDF_TARGET_ESP32 && CONFIG_BTDM_CTRL_MODEM_SLEEP
+    // Controller modem sleep between connection/advertising events, so connected-idle
+    // periods can drop into automatic light sleep (see power_mgmt.h)
+    if (esp_bt_sleep_enable() != ESP_OK) {
+        BLE_DEBUG("WARNING: BT modem sleep not enabled");
+    }
+#endif
+
     // Create server
     pServer = NimBLEDevice::createServer();
     pServer->setCallbacks(new AquavateServerCallbacks());
@@ -827,7 +1057,7 @@ bool bleInit() {
     );
     pSyncControlChar->setCallbacks(new SyncControlCallbacks());
     syncControl.start_index = 0;
-    syncControl.count = 0;
+    syncControl.count = bleRefreshUnsyncedCount();
     syncControl.command = 0;
     syncControl.status = 0; // IDLE
     syncControl.chunk_size = 20;
@@ -922,11 +1152,24 @@ bool bleIsConnected() {
     return isConnected;
 }
 
+// Check if advertising
+bool bleIsAdvertising() {
+    return isAdvertising;
+}
+
+// Check if a drink record sync is streaming
+bool bleIsSyncing() {
+    return isConnected && syncControl.status == 1;
+}
+
 // Update BLE service (call from main loop)
 void bleUpdate() {
     // Note: Advertising timeout removed (Plan 034 - Timer Rationalization)
     // Advertising now runs until bleStopAdvertising() is called at sleep time
     // This simplifies behavior: awake = advertising, asleep = not advertising
+
+    // Handle GATT writes queued by the NimBLE host task
+    bleProcessCommands();
 }
 
 // Update battery level
@@ -997,7 +1240,7 @@ void bleUpdateCurrentState(uint16_t daily_total_ml, int32_t current_adc,
     }
 
     // Unsynced count (Phase 3D)
-    currentState.unsynced_count = storageGetUnsyncedCount();
+    currentState.unsynced_count = bleRefreshUnsyncedCount();
 
     // Update characteristic value
     pCurrentStateChar->setValue((uint8_t*)&currentState, sizeof(currentState));
@@ -1041,7 +1284,7 @@ static void bleNotifyCurrentStateUpdate() {
     }
 
     // Update unsynced count and notify
-    currentState.unsynced_count = storageGetUnsyncedCount();
+    currentState.unsynced_count = bleRefreshUnsyncedCount();
     pCurrentStateChar->setValue((uint8_t*)&currentState, sizeof(currentState));
     pCurrentStateChar->notify();
     BLE_DEBUG_F("Current State notified after sync: unsynced=%d", currentState.unsynced_count);
@@ -1266,4 +1509,121 @@ bool bleCheckCalibrationCancelRequested() {
     return false;
 }
 
+#if ENABLE_TRACE_RECORDER
+// Sensor trace helper functions
+
+static void bleSendTraceInfo() {
+    BLE_TraceInfo info;
+    info.frame_count = traceRecorderGetFrameCount();
+    info.enabled = traceRecorderIsEnabled() ? 1 : 0;
+    info.frame_size = sizeof(TraceFrame);
+    info.frames_per_chunk = TRACE_FRAMES_PER_CHUNK;
+    info.version = TRACE_FORMAT_VERSION;
+
+    pActivityStatsChar->setValue((uint8_t*)&info, sizeof(info));
+    pActivityStatsChar->notify();
+
+    BLE_DEBUG_F("Trace: Sent info - frames=%u, enabled=%d", info.frame_count, info.enabled);
+}
+
+static void bleSendTraceChunk(uint16_t chunkIndex) {
+    static_assert(sizeof(TraceFrame) * TRACE_FRAMES_PER_CHUNK <= sizeof(BLE_TraceChunk::frames),
+                  "BLE_TraceChunk too small for TraceFrame");
+
+    BLE_TraceChunk chunk;
+    chunk.chunk_index = chunkIndex;
+    chunk._reserved = 0;
+    chunk.frame_count = traceRecorderReadFrames((uint32_t)chunkIndex * TRACE_FRAMES_PER_CHUNK,
+                                                (TraceFrame*)chunk.frames, TRACE_FRAMES_PER_CHUNK);
+
+    // Calculate actual size (header + frames); frame_count = 0 marks end of trace
+    size_t chunkSize = 4 + (chunk.frame_count * sizeof(TraceFrame));
+
+    pActivityStatsChar->setValue((uint8_t*)&chunk, chunkSize);
+    pActivityStatsChar->notify();
+
+    BLE_DEBUG_F("Trace: Sent chunk %d with %d frames", chunkIndex, chunk.frame_count);
+}
+#endif // ENABLE_TRACE_RECORDER
+
+#if ENABLE_BOOT_PROFILE
+// Boot profile helper functions
+
+static void bleSendBootProfileStats(uint8_t wakeReason) {
+    static_assert(BOOT_PHASE_COUNT <= BLE_BOOT_PROFILE_MAX_PHASES,
+                  "BLE_BootProfileStats too small for BootPhase");
+
+    BLE_BootProfileStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.phase_count = BOOT_PHASE_COUNT;
+    stats.wake_reason = wakeReason;
+
+    int filter = (wakeReason == 0xFF) ? -1 : wakeReason;
+    for (uint8_t p = 0; p < BOOT_PHASE_COUNT; p++) {
+        BootPhaseStats phase;
+        if (bootProfileGetStats((BootPhase)p, filter, phase)) {
+            stats.phases[p].min_us = phase.min_us;
+            stats.phases[p].avg_us = phase.avg_us;
+            stats.phases[p].max_us = phase.max_us;
+            if (phase.samples > stats.profile_count) {
+                stats.profile_count = phase.samples;
+            }
+        }
+    }
+
+    // Calculate actual size (header + phases)
+    size_t size = 4 + (stats.phase_count * sizeof(BLE_BootPhaseStats));
+
+    pActivityStatsChar->setValue((uint8_t*)&stats, size);
+    pActivityStatsChar->notify();
+
+    BLE_DEBUG_F("Boot profile: Sent stats - %d profiles, %d phases", stats.profile_count, stats.phase_count);
+}
+
+static void bleSendBootProfileEntry(uint8_t index) {
+    BootProfile profile;
+    if (!bootProfileGet(index, profile)) {
+        // Past end - empty profile (phase_count = 0) marks no more entries
+        memset(&profile, 0, sizeof(profile));
+        profile.wake_reason = WAKE_REASON_OTHER;
+        pActivityStatsChar->setValue((uint8_t*)&profile, 4);
+    } else {
+        pActivityStatsChar->setValue((uint8_t*)&profile, sizeof(profile));
+    }
+    pActivityStatsChar->notify();
+
+    BLE_DEBUG_F("Boot profile: Sent entry %d", index);
+}
+#endif // ENABLE_BOOT_PROFILE
+
+#if ENABLE_ENERGY_LEDGER
+// Energy ledger helper functions
+
+static void bleSendEnergySummary() {
+    static_assert(ENERGY_BUCKET_COUNT == BLE_ENERGY_BUCKETS,
+                  "BLE_EnergySummary bucket count out of sync with energy_ledger.h");
+
+    EnergySummary summary;
+    energyLedgerGetSummary(lastBatteryPercent, summary);
+
+    BLE_EnergySummary msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.uah_per_day = (uint32_t)(summary.mah_per_day * 1000.0f);
+    float days_x10 = summary.days_remaining * 10.0f;
+    msg.days_remaining_x10 = (days_x10 > 65535.0f) ? 65535 : (uint16_t)days_x10;
+    msg.battery_percent = lastBatteryPercent;
+    msg.flags = summary.estimate_complete ? BLE_ENERGY_FLAG_COMPLETE : 0;
+    msg.window_sec = summary.window_sec;
+    for (uint8_t i = 0; i < BLE_ENERGY_BUCKETS; i++) {
+        msg.charge_uah[i] = summary.charge_uah[i];
+    }
+
+    pActivityStatsChar->setValue((uint8_t*)&msg, sizeof(msg));
+    pActivityStatsChar->notify();
+
+    BLE_DEBUG_F("Energy: Sent summary - %.2f mAh/day, %.1f days remaining",
+                summary.mah_per_day, summary.days_remaining);
+}
+#endif // ENABLE_ENERGY_LEDGER
+
 #endif // ENABLE_BLE
@@ -0,0 +1,202 @@
+// boot_profile.cpp - Boot and wake phase profiler (RTC ring of recent wakes)
+// Part of the Aquavate smart water bottle firmware
+
+#include "boot_profile.h"
+
+#if ENABLE_BOOT_PROFILE
+
+#include "activity_stats.h"
+#include <esp_timer.h>
+
+#define RTC_MAGIC_BOOT_PROFILE  0x42505246  // "BPRF"
+
+// RTC ring - survives deep sleep, lost on power cycle
+RTC_DATA_ATTR static uint32_t rtc_boot_profile_magic = 0;
+RTC_DATA_ATTR static uint8_t rtc_boot_profile_head = 0;     // Next slot to write
+RTC_DATA_ATTR static uint8_t rtc_boot_profile_count = 0;
+RTC_DATA_ATTR static BootProfile rtc_boot_profiles[BOOT_PROFILE_HISTORY];
+
+// Profile for this boot (marks may come from the NAU bring-up task)
+static BootProfile g_current;
+static bool g_active = false;
+static bool g_committed = false;
+static uint16_t g_loop_count = 0;
+
+static const char* const PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "i2c_up",
+    "serial_up",
+    "nau_ready",
+    "adxl_configured",
+    "nvs_loaded",
+    "littlefs_mounted",
+    "drinks_init",
+    "ble_advertising",
+    "display_restored",
+    "setup_done",
+    "first_weight",
+    "loop_n",
+};
+
+static const char* wakeReasonName(uint8_t reason) {
+    switch (reason) {
+        case WAKE_REASON_MOTION:   return "motion";
+        case WAKE_REASON_TIMER:    return "timer";
+        case WAKE_REASON_POWER_ON: return "power_on";
+        default:                   return "other";
+    }
+}
+
+void bootProfileBegin(uint8_t wake_reason) {
+    if (rtc_boot_profile_magic != RTC_MAGIC_BOOT_PROFILE ||
+        rtc_boot_profile_count > BOOT_PROFILE_HISTORY ||
+        rtc_boot_profile_head >= BOOT_PROFILE_HISTORY) {
+        // Power cycle - RTC memory is garbage
+        memset(rtc_boot_profiles, 0, sizeof(rtc_boot_profiles));
+        rtc_boot_profile_head = 0;
+        rtc_boot_profile_count = 0;
+        rtc_boot_profile_magic = RTC_MAGIC_BOOT_PROFILE;
+    }
+
+    memset(&g_current, 0, sizeof(g_current));
+    g_current.wake_reason = wake_reason;
+    g_current.phase_count = BOOT_PHASE_COUNT;
+    g_loop_count = 0;
+    g_committed = false;
+    g_active = true;
+}
+
+void bootProfileMark(BootPhase phase) {
+    if (!g_active || phase >= BOOT_PHASE_COUNT || g_current.phase_us[phase] != 0) {
+        return;
+    }
+
+    // Single aligned 32-bit store - no lock needed across tasks
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    g_current.phase_us[phase] = (now == 0) ? 1 : now;
+}
+
+void bootProfileLoopTick() {
+    if (!g_active || g_committed) {
+        return;
+    }
+
+    if (++g_loop_count >= BOOT_PROFILE_LOOP_ITERATIONS) {
+        bootProfileMark(BOOT_PHASE_LOOP_N);
+        bootProfileCommit();
+    }
+}
+
+void bootProfileCommit() {
+    if (!g_active || g_committed) {
+        return;
+    }
+
+    rtc_boot_profiles[rtc_boot_profile_head] = g_current;
+    rtc_boot_profile_head = (rtc_boot_profile_head + 1) % BOOT_PROFILE_HISTORY;
+    if (rtc_boot_profile_count < BOOT_PROFILE_HISTORY) {
+        rtc_boot_profile_count++;
+    }
+    g_committed = true;
+
+    Serial.printf("Boot profile: setup %lums, first weight %lums (%s wake)\n",
+                  (unsigned long)(g_current.phase_us[BOOT_PHASE_SETUP_DONE] / 1000),
+                  (unsigned long)(g_current.phase_us[BOOT_PHASE_FIRST_WEIGHT] / 1000),
+                  wakeReasonName(g_current.wake_reason));
+}
+
+uint8_t bootProfileGetCount() {
+    return rtc_boot_profile_count;
+}
+
+bool bootProfileGet(uint8_t index, BootProfile& out) {
+    if (index >= rtc_boot_profile_count) {
+        return false;
+    }
+
+    uint8_t slot = (rtc_boot_profile_head + BOOT_PROFILE_HISTORY - 1 - index) % BOOT_PROFILE_HISTORY;
+    out = rtc_boot_profiles[slot];
+    return true;
+}
+
+bool bootProfileGetStats(BootPhase phase, int wake_reason, BootPhaseStats& out) {
+    out.min_us = UINT32_MAX;
+    out.avg_us = 0;
+    out.max_us = 0;
+    out.samples = 0;
+
+    if (phase >= BOOT_PHASE_COUNT) {
+        return false;
+    }
+
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < rtc_boot_profile_count; i++) {
+        const BootProfile& p = rtc_boot_profiles[i];
+        if (wake_reason >= 0 && p.wake_reason != wake_reason) {
+            continue;
+        }
+        uint32_t t = p.phase_us[phase];
+        if (t == 0) {
+            continue;  // Phase not reached on this wake
+        }
+        if (t < out.min_us) out.min_us = t;
+        if (t > out.max_us) out.max_us = t;
+        sum += t;
+        out.samples++;
+    }
+
+    if (out.samples == 0) {
+        out.min_us = 0;
+        return false;
+    }
+
+    out.avg_us = (uint32_t)(sum / out.samples);
+    return true;
+}
+
+const char* bootProfilePhaseName(BootPhase phase) {
+    return (phase < BOOT_PHASE_COUNT) ? PHASE_NAMES[phase] : "?";
+}
+
+void bootProfilePrint() {
+    uint8_t count = bootProfileGetCount();
+    Serial.printf("\n=== BOOT PROFILE (%d wakes) ===\n", count);
+    if (count == 0) {
+        Serial.println("No profiles stored yet");
+        Serial.println("===============================\n");
+        return;
+    }
+
+    // Per-phase statistics, one table per wake reason seen
+    const int reasons[] = { -1, WAKE_REASON_MOTION, WAKE_REASON_TIMER, WAKE_REASON_POWER_ON };
+    for (int r : reasons) {
+        BootPhaseStats stats;
+        if (!bootProfileGetStats(BOOT_PHASE_SETUP_DONE, r, stats)) {
+            continue;
+        }
+
+        Serial.printf("\n%s (%d wakes) - ms since boot\n",
+                      r < 0 ? "All wakes" : wakeReasonName((uint8_t)r), stats.samples);
+        Serial.println("  phase              min      avg      max");
+        for (uint8_t p = 0; p < BOOT_PHASE_COUNT; p++) {
+            if (!bootProfileGetStats((BootPhase)p, r, stats)) {
+                continue;
+            }
+            Serial.printf("  %-16s %7.1f  %7.1f  %7.1f\n", PHASE_NAMES[p],
+                          stats.min_us / 1000.0f, stats.avg_us / 1000.0f, stats.max_us / 1000.0f);
+        }
+    }
+
+    // Most recent profiles, one line each
+    Serial.println("\nRecent (newest first), ms: setup_done / first_weight / loop_n");
+    for (uint8_t i = 0; i < count; i++) {
+        BootProfile p;
+        bootProfileGet(i, p);
+        Serial.printf("  %2d %-8s %7.1f  %7.1f  %7.1f\n", i, wakeReasonName(p.wake_reason),
+                      p.phase_us[BOOT_PHASE_SETUP_DONE] / 1000.0f,
+                      p.phase_us[BOOT_PHASE_FIRST_WEIGHT] / 1000.0f,
+                      p.phase_us[BOOT_PHASE_LOOP_N] / 1000.0f);
+    }
+    Serial.println("===============================\n");
+}
+
+#endif // ENABLE_BOOT_PROFILE
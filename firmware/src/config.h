@@ -135,6 +135,46 @@ extern uint8_t g_daily_intake_display_mode;
 // Battery impact: ~1mAh/day (negligible vs 400-1000mAh LiPo)
 #define HEALTH_CHECK_WAKE_INTERVAL_SEC  7200    // 2 hours
 
+// Deep-sleep wake stub (ESP32 only): in backpack mode, routine health-check timer
+// wakes are handled by esp_wake_deep_sleep() in RTC fast memory - it counts the
+// wake and goes straight back to sleep without booting. A full boot still happens
+// for tap wake, the daily rollover, low battery lockout, and a real health check
+// every BACKPACK_FULL_BOOT_INTERVAL_SEC.
+#define ENABLE_WAKE_STUB                1
+#define BACKPACK_FULL_BOOT_INTERVAL_SEC 28800   // 8 hours (every 4th health-check wake)
+
+// Awake-mode power management (esp_pm): DFS between the two clocks below, plus
+// automatic light sleep whenever every task is blocked (not while USB is attached,
+// so the serial console keeps working). I2C bursts, e-paper transfers and BLE sync
+// hold PM locks. Cores without CONFIG_PM_ENABLE run at a fixed POWER_CPU_MIN_MHZ.
+#define ENABLE_POWER_MANAGEMENT         1
+#define POWER_CPU_MAX_MHZ               240
+#define POWER_CPU_MIN_MHZ               80      // Lowest clock that keeps APB (I2C/SPI) and BLE at full rate
+
+// Learned sleep scheduler: a per-hour-of-day usage model (drink records, motion
+// wake history, phone connections) that adapts the two timers above. Idle hours
+// get shorter timeouts, hours where the bottle is usually set straight back down
+// again get longer ones, the sync window is only cut where the phone has not been
+// connecting, and backpack-mode timer wakes are aimed at hours the phone usually
+// connects while records are waiting. Needs valid time and SCHED_MIN_DAYS of history.
+#define ENABLE_SLEEP_SCHEDULER          1
+#define SCHED_MIN_DAYS                  3       // Days of history before adapting anything
+#define SCHED_DECAY_PER_DAY             0.875f  // Hourly counts decay daily (~5 day half-life)
+#define SCHED_MIN_SAMPLES               4       // Samples in an hour before trusting a ratio
+#define SCHED_IDLE_EVENTS_PER_DAY       0.25f   // Wakes + drinks per day below this = idle hour
+#define SCHED_ACTIVE_DRINKS_PER_DAY     0.5f    // Drinks per day at or above this = active hour
+#define SCHED_REPICKUP_WINDOW_SEC       60      // Placement wake this soon after sleep = re-pick-up
+#define SCHED_REPICKUP_LIKELY           0.35f   // Re-pick-up ratio that lengthens the timeout
+#define SCHED_SYNC_UNLIKELY             0.1f    // Phone connect ratio below which the sync window is cut
+#define SCHED_SYNC_LIKELY_PER_DAY       0.3f    // Connects per day that make an hour a sync target
+#define SCHED_SYNC_WAKE_OFFSET_SEC      600     // Aim sync wakes this far into the target hour
+#define SCHED_SEED_MAX_RECORDS          200     // Drink records read to seed the model after power-on
+#define ACTIVITY_TIMEOUT_MIN_MS         15000   // Shortest learned activity timeout
+#define ACTIVITY_TIMEOUT_MAX_MS         90000   // Longest learned activity timeout
+#define ACTIVITY_TIMEOUT_SYNC_MIN_MS    60000   // Shortest learned sync window
+#define TIME_SINCE_STABLE_MIN_SEC       90      // Backpack threshold range for learned hours
+#define TIME_SINCE_STABLE_MAX_SEC       300
+
 // Display "Zzzz" indicator before entering deep sleep
 // 0 = No display update before sleep (saves battery, no flash)
 // 1 = Show "Zzzz" indicator before sleep (visual feedback)
@@ -144,12 +184,66 @@ extern uint8_t g_daily_intake_display_mode;
 // Activity detection for normal sleep wake (ADXL343 AC-coupled activity interrupt)
 #define ACTIVITY_WAKE_THRESHOLD     0x18    // 1.5g threshold (24 x 62.5mg/LSB) - detects tilt to pour
 
+// Placement wake for normal sleep: instead of waking on any motion, the ADXL343's
+// linked activity/inactivity state machine wakes the CPU only once the bottle has
+// been moved and then set down upright and still. Inactivity is DC-coupled on the
+// horizontal axes (X, Z), so it only asserts while the bottle is upright.
+// 0 = wake on any motion above ACTIVITY_WAKE_THRESHOLD (previous behaviour)
+#define ENABLE_PLACEMENT_WAKE       1
+#define PLACEMENT_INACT_THRESHOLD   0x05    // 0.31g (5 x 62.5mg/LSB) - max X/Z tilt (~18 degrees)
+#define PLACEMENT_INACT_TIME        2       // Seconds upright and still before wake (1s/LSB)
+#define PLACEMENT_ARM_TIMEOUT_MS    ((PLACEMENT_INACT_TIME + 1) * 1000)  // Max wait for the initial inactivity at sleep entry
+#define PLACEMENT_ARM_POLL_MS       50      // INT_SOURCE poll interval while arming
+
 // Tap detection threshold (double-tap detection for backpack mode)
 #define TAP_WAKE_THRESHOLD          0x30    // 3.0g threshold (48 x 62.5mg/LSB) - firm tap required
 #define TAP_WAKE_DURATION           0x10    // 10ms max duration (16 x 625us/LSB) - short sharp tap
 #define TAP_WAKE_LATENT             0x50    // 100ms latency (80 x 1.25ms/LSB) - between taps
 #define TAP_WAKE_WINDOW             0xF0    // 300ms window (240 x 1.25ms/LSB) - for second tap
 
+// ==================== I2C Bus ====================
+
+// NAU7802, ADXL343 and DS3231 are all rated for 400kHz fast mode.
+// Per-loop sensor reads go through the i2c_bus worker task (queued command links)
+// so the loop is not blocked while the transfer is on the wire.
+#define I2C_BUS_CLOCK_HZ                400000  // Fast mode (Wire default is 100kHz)
+#define I2C_BUS_QUEUE_DEPTH             8       // Pending transactions before submit fails
+#define I2C_BUS_TIMEOUT_MS              20      // Per-transaction bus timeout
+#define I2C_BUS_MERGE_GAP               2       // Max unused registers bridged when merging burst reads
+#define I2C_BUS_TASK_PRIORITY           3       // Above loopTask (1), below NimBLE host
+
+// ==================== Task Layout ====================
+
+// Sensor acquisition runs in its own task above loopTask (priority 1, core 1), so
+// sampling keeps its cadence whatever the loop is doing.
+// The loop (detection/logic) is paced by the sensor task's samples instead of
+// delay(). Deferred flash writes run on a low-priority storage task on core 0.
+#define SENSOR_TASK_INTERVAL_MS         200     // Sample period (was loop delay(200))
+#define SENSOR_TASK_PRIORITY            3
+#define SENSOR_TASK_CORE                1       // Same core as loopTask
+#define STORAGE_TASK_PRIORITY           1
+#define STORAGE_TASK_CORE               0       // Away from sensing/logic
+#define STORAGE_QUEUE_DEPTH             4       // Pending deferred writes
+
+// Main-screen renders + e-paper refreshes run on a display task: the loop posts the
+// frame and keeps going through the seconds-long refresh. Other screens and sleep
+// entry wait for it to go idle first.
+#define ENABLE_DISPLAY_TASK             1
+#define DISPLAY_TASK_PRIORITY           1
+#define DISPLAY_TASK_CORE               0       // Refresh waits never hold up core 1
+#define DISPLAY_IDLE_TIMEOUT_MS         8000    // Max wait for an in-flight refresh
+
+// Boot: the NAU7802 is brought up on a one-shot task at the start of setup() so
+// its power-up/settling overlaps display, storage and accelerometer init.
+// setup() joins it before the weight module is initialised.
+#define NAU_BOOT_TASK_PRIORITY          2       // Above loopTask so it gets the bus first
+#define NAU_BOOT_TIMEOUT_MS             2000    // Max wait at join before giving up
+
+// Serial console: the 1s attach delay is only paid on power-on/reset, or on a
+// wake from deep sleep while USB power is present (someone may be watching).
+#define SERIAL_ATTACH_DELAY_MS          1000
+#define USB_VBUS_PRESENT_MV             1000    // PIN_VBUS reading above this = USB attached
+
 // ==================== ADXL343 Accelerometer ====================
 
 // Note: PIN_ACCEL_INT is defined in board-specific pins_*.h files
@@ -183,6 +277,29 @@ extern uint8_t g_daily_intake_display_mode;
 #define BATTERY_VOLTAGE_FULL    4.2f  // 100%
 #define BATTERY_VOLTAGE_EMPTY   3.2f  // 0%
 
+// Battery sampling (device_context.h): oversampled read every 5s, IIR-smoothed
+#define CONTEXT_BATTERY_SAMPLE_MS       5000    // Sample cadence while awake
+#define CONTEXT_BATTERY_OVERSAMPLE      8       // ADC reads averaged per sample
+#define CONTEXT_BATTERY_IIR_ALPHA       0.25f   // Filter weight of each new sample
+
+// Battery capacity for the energy ledger's days-remaining estimate
+#define BATTERY_CAPACITY_MAH    1000
+
+// Energy ledger: time in each power state x these currents (uA) = charge.
+// Typical board-level figures at 3.7V - refine with a power profiler and the
+// per-state times from GET_ENERGY_SUMMARY.
+#define ENABLE_ENERGY_LEDGER                1
+#define ENERGY_CURRENT_SLEEP_NORMAL_UA      150     // ESP32 deep sleep + board + ADXL343 measuring
+#define ENERGY_CURRENT_SLEEP_EXTENDED_UA    150     // Same hardware state, tap wake armed
+#define ENERGY_CURRENT_AWAKE_IDLE_UA        25000   // CPU (DFS) + peripherals, radio off
+#define ENERGY_CURRENT_ADVERTISING_UA       30000   // + BLE advertising duty cycle
+#define ENERGY_CURRENT_CONNECTED_UA         35000   // + BLE connection events
+#define ENERGY_CURRENT_SYNCING_UA           55000   // Full clock, radio streaming
+#define ENERGY_CURRENT_EPD_REFRESH_UA       8000    // Overlay: e-paper transfer + refresh
+#define ENERGY_CURRENT_FLASH_WRITE_UA       20000   // Overlay: flash program/erase
+#define ENERGY_CURRENT_NAU_ACTIVE_UA        1500    // Overlay: NAU7802 converting (never powered down)
+#define ENERGY_ROLLING_WEIGHT               0.25f   // Weight of the newest day in the mAh/day average
+
 // Low Battery Lockout
 #define LOW_BATTERY_LOCKOUT_PCT_DEFAULT  20      // Default lockout threshold (%)
 #define LOW_BATTERY_RECOVERY_OFFSET      5       // Recovery = lockout + this (%)
@@ -199,6 +316,52 @@ extern uint8_t g_daily_intake_display_mode;
     #define EPD_RESET   -1
 #endif
 
+// Frame buffer location. Internal RAM (two 4KB planes from the heap) renders at memory
+// speed and streams each plane in one SPI burst; the FeatherWing's SPI SRAM is the
+// fallback, where every pixel is an SPI read-modify-write.
+#define EPD_FRAMEBUFFER_INTERNAL        1
+#if EPD_FRAMEBUFFER_INTERNAL
+    #define EPD_FRAMEBUFFER_SRAM_CS     -1      // Adafruit_EPD mallocs the buffers when no SRAM CS
+#else
+    #define EPD_FRAMEBUFFER_SRAM_CS     SRAM_CS
+#endif
+
+// Main-screen partial refresh (SSD1680 differential waveform - only changed pixels are driven)
+// Other screens and the calibration UI always use a full refresh. A full refresh also
+// runs after EPD_PARTIAL_MAX_BEFORE_FULL partials or EPD_FULL_REFRESH_MAX_AGE_SEC,
+// whichever comes first, to clear ghosting.
+#define ENABLE_EPD_PARTIAL_REFRESH      1
+#define EPD_PARTIAL_MAX_BEFORE_FULL     10      // Ghosting budget: partials between full refreshes
+#define EPD_FULL_REFRESH_MAX_AGE_SEC    14400   // 4 hours - full refresh at least this often (needs valid time)
+#define EPD_PARTIAL_REFRESH_MS          400     // Fixed wait for a partial refresh (no BUSY line on the FeatherWing)
+
+// Skip the transfer + refresh when a render produces the frame the panel already shows
+// (hash of the last pushed frame buffer kept in RTC memory). Needs EPD_FRAMEBUFFER_INTERNAL.
+#define ENABLE_EPD_FRAME_HASH           1
+
+// Refresh governor - caps main-screen refreshes from displayNeedsUpdate() with a per-hour
+// budget (token bucket in RTC memory) that tightens as the battery falls. Daily-total
+// changes always refresh; a bottle-level change needs a token; clock and battery-icon
+// ticks need a token with REFRESH_COSMETIC_RESERVE left over. Changes are held for
+// REFRESH_COALESCE_MS so ones arriving close together share a refresh. Forced refreshes
+// (wake, BLE, goal change) bypass the governor but still spend a token.
+#define ENABLE_REFRESH_GOVERNOR         1
+#define REFRESH_BUDGET_HIGH_PER_HOUR    20      // Battery >= REFRESH_BUDGET_MID_BATTERY
+#define REFRESH_BUDGET_MID_PER_HOUR     8       // Battery >= REFRESH_BUDGET_LOW_BATTERY
+#define REFRESH_BUDGET_LOW_PER_HOUR     3       // Below REFRESH_BUDGET_LOW_BATTERY
+#define REFRESH_BUDGET_MID_BATTERY      50      // %
+#define REFRESH_BUDGET_LOW_BATTERY      25      // %
+#define REFRESH_COSMETIC_RESERVE        1       // Tokens kept back from clock/battery ticks
+#define REFRESH_COALESCE_MS             5000    // One DISPLAY_UPDATE_INTERVAL_MS check
+
+// Deferred render - main-screen changes found by displayNeedsUpdate() are held while the
+// bottle is in use and rendered once: at normal sleep entry, or after DISPLAY_DEFER_QUIET_MS
+// without a further change, so a pick-up/put-down cycle costs at most one refresh.
+// Calibration, low-battery and info screens, the first draw after boot and forced
+// refreshes (wake, BLE, goal change) still render immediately.
+#define ENABLE_DEFERRED_RENDER          0
+#define DISPLAY_DEFER_QUIET_MS          60000   // Above ACTIVITY_TIMEOUT_MS - usually sleep entry renders first
+
 // ==================== Calibration ====================
 
 // Gesture detection thresholds (in g units)
@@ -249,6 +412,9 @@ extern uint8_t g_daily_intake_display_mode;
 #define CAL_WAIT_EMPTY_TIMEOUT          60000   // 60 seconds - Empty bottle prompt timeout
 #define CAL_WAIT_FULL_TIMEOUT           120000  // 120 seconds - Full bottle prompt timeout
 
+// Info screen hold (bottle emptied, storage error) - non-blocking, see ui_sequence.h
+#define INFO_SCREEN_DISPLAY_MS          3000    // 3 seconds before returning to the main screen
+
 // Display update parameters
 #define DISPLAY_UPDATE_INTERVAL_MS      5000    // Check for water level changes every 5 seconds
 #define DISPLAY_UPDATE_THRESHOLD_ML     5.0f    // Only refresh display if water level changed by >5ml
@@ -278,6 +444,32 @@ extern uint8_t g_daily_intake_display_mode;
 #define DISPLAY_BATTERY_UPDATE_INTERVAL_MS  900000  // Check battery every 15 minutes
 #define DISPLAY_BATTERY_UPDATE_THRESHOLD    20      // Update display if battery changed by ≥20%
 
+// ==================== Sensor Trace Recorder ====================
+
+// Binary per-loop sensor trace on LittleFS for offline threshold tuning and replay.
+// Compiled in by default; recording itself is opt-in at runtime (TRACE ON / BLE)
+// and the enabled flag persists in NVS.
+#define ENABLE_TRACE_RECORDER           1
+#define TRACE_BLOCK_SIZE                4096    // Flush granularity in bytes (one LittleFS block)
+#define TRACE_RING_BLOCKS               6       // Ring capacity: 6 x 4KB = 24KB (~1200 frames, ~4 min awake)
+
+// ==================== Boot Profiler ====================
+
+// Named esp_timer checkpoints through setup() and the first loop() iterations,
+// kept for the last BOOT_PROFILE_HISTORY wakes in RTC memory (52 bytes each).
+// Read with BOOT PROFILE (serial) or GET_BOOT_PROFILE (BLE).
+#define ENABLE_BOOT_PROFILE             1
+#define BOOT_PROFILE_HISTORY            16
+#define BOOT_PROFILE_LOOP_ITERATIONS    5       // loop() iterations covered after setup()
+
+// ==================== Loop Profiler ====================
+
+// Scoped timing probes around each loop() stage: per-stage log2 histograms of
+// execution time plus loop period jitter, reset on every wake. Read with PROFILE
+// (serial). Set to 0 to compile the probes out entirely.
+#define ENABLE_LOOP_PROFILER            1
+#define LOOP_PROFILE_BUCKETS            21      // Log2 us buckets: 0-1us ... >=1s
+
 // NVS Storage
 #define NVS_NAMESPACE                   "aquavate"  // NVS namespace for calibration data
 
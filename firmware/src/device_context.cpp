@@ -0,0 +1,95 @@
+// device_context.cpp - Cached battery level and local time for the main loop
+// Part of the Aquavate smart water bottle firmware
+
+#include "device_context.h"
+
+// External dependencies from main.cpp
+extern int8_t g_timezone_offset;
+extern bool g_time_valid;
+
+// Filter state survives deep sleep so each wake continues the smoothed value
+// instead of re-priming on one noisy reading; cleared only by a power cycle
+RTC_DATA_ATTR static float rtc_vbat_filtered = 0.0f;
+RTC_DATA_ATTR static bool rtc_vbat_primed = false;
+static uint32_t g_vbat_last_sample_ms = 0;
+
+static time_t g_cached_minute = -1;         // Local time / 60 of g_cached_tm
+static struct tm g_cached_tm;
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// One oversampled VBAT reading in volts
+static float readBatteryVoltage() {
+#if defined(BOARD_ADAFRUIT_FEATHER)
+    uint32_t sum_mv = 0;
+    for (uint8_t i = 0; i < CONTEXT_BATTERY_OVERSAMPLE; i++) {
+        sum_mv += analogReadMilliVolts(VBAT_PIN);
+    }
+    // Voltage divider halves VBAT
+    return (float)sum_mv * 2.0f / CONTEXT_BATTERY_OVERSAMPLE / 1000.0f;
+#else
+    return BATTERY_VOLTAGE_FULL;  // No battery monitor on this board
+#endif
+}
+
+static void sampleBattery() {
+    float voltage = readBatteryVoltage();
+    if (!rtc_vbat_primed) {
+        rtc_vbat_filtered = voltage;
+        rtc_vbat_primed = true;
+    } else {
+        rtc_vbat_filtered += CONTEXT_BATTERY_IIR_ALPHA * (voltage - rtc_vbat_filtered);
+    }
+    g_vbat_last_sample_ms = millis();
+}
+
+void deviceContextUpdate() {
+    if (!rtc_vbat_primed || millis() - g_vbat_last_sample_ms >= CONTEXT_BATTERY_SAMPLE_MS) {
+        sampleBattery();
+    }
+}
+
+float deviceContextBatteryVoltage() {
+    if (!rtc_vbat_primed) {
+        sampleBattery();
+    }
+    return rtc_vbat_filtered;
+}
+
+uint8_t deviceContextBatteryPercent() {
+    // LiPo: BATTERY_VOLTAGE_FULL = 100%, BATTERY_VOLTAGE_EMPTY = 0%
+    int percent = (deviceContextBatteryVoltage() - BATTERY_VOLTAGE_EMPTY) /
+                  (BATTERY_VOLTAGE_FULL - BATTERY_VOLTAGE_EMPTY) * 100;
+    if (percent > 100) percent = 100;
+    if (percent < 0) percent = 0;
+    return (uint8_t)percent;
+}
+
+bool deviceContextLocalTime(struct tm& out) {
+    if (!g_time_valid) {
+        return false;
+    }
+
+    time_t now = time(nullptr) + (g_timezone_offset * 3600);
+    time_t minute = now / 60;
+
+    taskENTER_CRITICAL(&g_mux);
+    if (minute != g_cached_minute) {
+        gmtime_r(&now, &g_cached_tm);
+        g_cached_minute = minute;
+    }
+    out = g_cached_tm;
+    taskEXIT_CRITICAL(&g_mux);
+
+    out.tm_sec = (int)(now % 60);
+    return true;
+}
+
+bool deviceContextHourMinute(uint8_t& hour, uint8_t& minute) {
+    struct tm local_tm;
+    if (!deviceContextLocalTime(local_tm)) {
+        return false;
+    }
+    hour = local_tm.tm_hour;
+    minute = local_tm.tm_min;
+    return true;
+}
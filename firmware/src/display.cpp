@@ -8,27 +8,35 @@
 #include "drinks.h"
 #include "calibration.h"
 #include "aquavate.h"
+#include "power_mgmt.h"
+#include "ui_sequence.h"
+#include "device_context.h"
+#include "sprites.h"
+#include "activity_stats.h"
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
 #include <sys/time.h>
 #include <time.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 
 // External dependencies from main.cpp
 extern Adafruit_NAU7802 nau;
 extern bool nauReady;
 extern CalibrationData g_calibration;
 extern bool g_calibrated;
-extern int8_t g_timezone_offset;
 extern bool g_time_valid;
 extern uint8_t g_daily_intake_display_mode;
 
-// External battery functions (defined in main.cpp for Adafruit Feather)
-#if defined(BOARD_ADAFRUIT_FEATHER)
-extern float getBatteryVoltage();
-extern int getBatteryPercent(float voltage);
-#endif
 
 // Display state (internal to this module)
 static DisplayState g_display_state;
-static ThinkInk_213_Mono_GDEY0213B74* g_display_ptr = nullptr;
+static AquavateDisplay* g_display_ptr = nullptr;
+
+// Direct frame buffer access for the packed 1bpp primitives (buf == nullptr: GFX only)
+static RasterTarget g_raster = {};
 
 // Daily goal for hydration graphic (synced from BLE config, persisted to NVS)
 static uint16_t g_daily_goal_ml = DRINK_DAILY_GOAL_DEFAULT_ML;
@@ -46,6 +54,86 @@ RTC_DATA_ATTR uint8_t rtc_display_battery = 0;
 RTC_DATA_ATTR uint32_t rtc_wake_count = 0;
 RTC_DATA_ATTR uint16_t rtc_display_daily_goal = 0;
 
+// Hash of the last frame buffer pushed to the panel (identical renders skip the refresh)
+RTC_DATA_ATTR static uint32_t rtc_panel_hash = 0;
+RTC_DATA_ATTR static bool rtc_panel_hash_valid = false;
+
+// How much a main-screen change matters to the user (the refresh governor's ranking)
+enum RefreshPriority : uint8_t {
+    REFRESH_PRIORITY_NONE = 0,
+    REFRESH_PRIORITY_COSMETIC,      // Clock or battery icon tick
+    REFRESH_PRIORITY_LEVEL,         // Bottle level
+    REFRESH_PRIORITY_INTAKE,        // Daily total or first draw - never held back
+};
+
+#if ENABLE_REFRESH_GOVERNOR
+// Refresh budget token bucket (thousandths of a refresh, refilled from the RTC clock so
+// sleep time counts)
+RTC_DATA_ATTR static uint32_t rtc_refresh_tokens = 0;
+RTC_DATA_ATTR static uint32_t rtc_refresh_refill_time = 0;  // time() of the last refill (0 = fill to cap)
+
+// Change waiting for the governor (RAM only - a wake re-detects it)
+static RefreshPriority g_refresh_pending = REFRESH_PRIORITY_NONE;
+static uint32_t g_refresh_pending_since = 0;    // millis() when the pending change was first seen
+static bool g_refresh_pending_counted = false;  // Held over budget - counted as deferred once
+#endif
+
+#if ENABLE_DEFERRED_RENDER
+// g_display_state holds changes the panel doesn't show yet (displayDeferUpdate)
+static bool g_render_deferred = false;
+static uint32_t g_render_deferred_last_ms = 0;  // millis() of the newest held change
+#endif
+
+#if defined(BOARD_ADAFRUIT_FEATHER)
+// Everything the main screen shows. A partial refresh re-renders the frame the panel
+// currently shows into the controller's old-image RAM, so only this (not a 4KB copy
+// of the image) has to survive deep sleep.
+struct MainScreenFrame {
+    float water_ml;
+    uint16_t daily_total_ml;
+    uint16_t daily_goal_ml;
+    uint8_t battery_percent;
+    uint8_t intake_display_mode;
+    bool time_valid;
+    char time_text[16];
+};
+
+RTC_DATA_ATTR static MainScreenFrame rtc_panel_frame;
+RTC_DATA_ATTR static bool rtc_panel_frame_valid = false;    // Panel shows rtc_panel_frame
+RTC_DATA_ATTR static uint8_t rtc_partial_count = 0;         // Partials since the last full refresh
+RTC_DATA_ATTR static uint32_t rtc_last_full_refresh = 0;    // Unix time of the last full refresh (0 = unknown)
+
+// Both controller RAMs hold the image on the panel (set by a partial, cleared by a full
+// refresh) - partials then only send the rows of the changed widgets
+static bool g_controller_ram_synced = false;
+
+// Main-screen refresh task (drawMainScreen() posts frames to it)
+static void displayTaskStart();
+
+// Main-screen widgets. Two frames render identical pixels inside a widget's bounds
+// when the widget's quantised inputs (fill rows, text, battery bars) match.
+enum MainWidget : uint8_t {
+    MAIN_WIDGET_BOTTLE = 0,
+    MAIN_WIDGET_INTAKE,
+    MAIN_WIDGET_BATTERY,
+    MAIN_WIDGET_TIME,
+    MAIN_WIDGET_DAILY,
+    MAIN_WIDGET_COUNT
+};
+
+static const char* const MAIN_WIDGET_NAMES[MAIN_WIDGET_COUNT] = {
+    "bottle", "intake", "battery", "time", "daily"
+};
+
+static const DisplayRect MAIN_WIDGET_BOUNDS[MAIN_WIDGET_COUNT] = {
+    { 10, 23, 40, 90 },     // Bottle graphic (incl. "?")
+    { 60, 53, 130, 24 },    // Intake text, size 3 (up to 7 chars)
+    { 220, 5, 23, 12 },     // Battery icon
+    { 75, 5, 100, 8 },      // Time text, size 1
+    { 185, 23, 54, 93 },    // Human figure (185,26 54x90) or glass grid (195,23 40x88)
+};
+#endif
+
 // Bitmap data (moved from main.cpp)
 // Water drop icon bitmap (60x60 pixels)
 const unsigned char water_drop_bitmap[] PROGMEM = {
@@ -336,11 +424,8 @@ static void formatTimeForDisplay(char* buffer, size_t buffer_size) {
         return;
     }
 
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
     struct tm timeinfo;
-    gmtime_r(&now, &timeinfo);
+    deviceContextLocalTime(timeinfo);
 
     const char* day = getDayName(timeinfo.tm_wday);
     int hour_12 = timeinfo.tm_hour % 12;
@@ -353,9 +438,18 @@ static void formatTimeForDisplay(char* buffer, size_t buffer_size) {
 #if defined(BOARD_ADAFRUIT_FEATHER)
 // Helper: Draw battery icon
 static void drawBatteryIcon(int x, int y, int percent) {
+    int fillWidth = (percent * 16) / 100;
+    if (g_raster.buf != nullptr) {
+        rasterDrawRect(g_raster, x, y, 20, 12, true);
+        rasterFillRect(g_raster, x + 20, y + 3, 3, 6, true);
+        if (fillWidth > 0) {
+            rasterFillRect(g_raster, x + 2, y + 2, fillWidth, 8, true);
+        }
+        return;
+    }
+
     g_display_ptr->drawRect(x, y, 20, 12, EPD_BLACK);
     g_display_ptr->fillRect(x + 20, y + 3, 3, 6, EPD_BLACK);
-    int fillWidth = (percent * 16) / 100;
     if (fillWidth > 0) {
         g_display_ptr->fillRect(x + 2, y + 2, fillWidth, 8, EPD_BLACK);
     }
@@ -363,35 +457,44 @@ static void drawBatteryIcon(int x, int y, int percent) {
 
 // Note: Zzzz sleep indicator removed - backpack mode screen replaces it (Issue #38)
 
+#define BOTTLE_BODY_HEIGHT 70
+
 // Helper: Draw bottle graphic (exported for calibration UI)
 void drawBottleGraphic(int16_t x, int16_t y, float fill_percent, bool show_question_mark) {
     int bottle_width = 40;
     int bottle_height = 90;
-    int bottle_body_height = 70;
+    int bottle_body_height = BOTTLE_BODY_HEIGHT;
     int neck_height = 10;
     int cap_height = 10;
 
     int fill_height = (int)(bottle_body_height * fill_percent);
-
-    g_display_ptr->fillRoundRect(x, y + cap_height + neck_height,
-                                 bottle_width, bottle_body_height, 8, EPD_BLACK);
-    g_display_ptr->fillRoundRect(x + 2, y + cap_height + neck_height + 2,
-                                 bottle_width - 4, bottle_body_height - 4, 6, EPD_WHITE);
-
     int neck_width = bottle_width - 12;
     int neck_x = x + 6;
-    g_display_ptr->fillRect(neck_x, y + cap_height, neck_width, neck_height, EPD_BLACK);
-    g_display_ptr->fillRect(neck_x + 2, y + cap_height + 2, neck_width - 4, neck_height - 4, EPD_WHITE);
-
     int cap_width = neck_width - 4;
     int cap_x = neck_x + 2;
-    g_display_ptr->fillRect(cap_x, y, cap_width, cap_height, EPD_BLACK);
+    int water_y = y + cap_height + neck_height + bottle_body_height - fill_height;
+
+    if (g_raster.buf != nullptr) {
+        rasterBlitSprite(g_raster, x, y, SPRITE_BOTTLE);
+        if (fill_height > 0) {
+            rasterFillRoundRect(g_raster, x + 4, water_y, bottle_width - 8, fill_height - 2, 4, true);
+        }
+    } else {
+        g_display_ptr->fillRoundRect(x, y + cap_height + neck_height,
+                                     bottle_width, bottle_body_height, 8, EPD_BLACK);
+        g_display_ptr->fillRoundRect(x + 2, y + cap_height + neck_height + 2,
+                                     bottle_width - 4, bottle_body_height - 4, 6, EPD_WHITE);
+
+        g_display_ptr->fillRect(neck_x, y + cap_height, neck_width, neck_height, EPD_BLACK);
+        g_display_ptr->fillRect(neck_x + 2, y + cap_height + 2, neck_width - 4, neck_height - 4, EPD_WHITE);
+
+        g_display_ptr->fillRect(cap_x, y, cap_width, cap_height, EPD_BLACK);
 
-    // Draw water fill if needed
-    if (fill_height > 0) {
-        int water_y = y + cap_height + neck_height + bottle_body_height - fill_height;
-        g_display_ptr->fillRoundRect(x + 4, water_y,
-                                     bottle_width - 8, fill_height - 2, 4, EPD_BLACK);
+        // Draw water fill if needed
+        if (fill_height > 0) {
+            g_display_ptr->fillRoundRect(x + 4, water_y,
+                                         bottle_width - 8, fill_height - 2, 4, EPD_BLACK);
+        }
     }
 
     // Draw question mark on top if requested
@@ -410,6 +513,13 @@ void drawBottleGraphic(int16_t x, int16_t y, float fill_percent, bool show_quest
 static void drawHumanFigure(int x, int y, float fill_percent, bool goal_reached) {
     (void)goal_reached;  // Reserved for future use (e.g., smiley face when goal reached)
     int fill_start_row = (int)(HUMAN_FIGURE_HEIGHT * (1.0f - fill_percent));
+
+    if (g_raster.buf != nullptr) {
+        // Filled sprite for rows at or below fill level, outline for rows above
+        rasterBlitSprite(g_raster, x, y, SPRITE_FIGURE_OUTLINE, &SPRITE_FIGURE_FILLED, fill_start_row);
+        return;
+    }
+
     int bytes_per_row = (HUMAN_FIGURE_WIDTH + 7) / 8;
 
     for (int row = 0; row < HUMAN_FIGURE_HEIGHT; row++) {
@@ -433,10 +543,13 @@ static void drawHumanFigure(int x, int y, float fill_percent, bool goal_reached)
     }
 }
 
+#define GLASS_GRID_COUNT 10         // 2 columns x 5 rows
+#define GLASS_FILL_ROWS 14          // Fillable rows per glass (GLASS_HEIGHT - 2)
+
 // Helper: Draw tumbler grid
 static void drawGlassGrid(int x, int y, float fill_percent) {
     const int GLASS_WIDTH = 18;
-    const int GLASS_HEIGHT = 16;
+    const int GLASS_HEIGHT = GLASS_FILL_ROWS + 2;
     const int GLASS_SPACING_X = 4;
     const int GLASS_SPACING_Y = 2;
     const int COLS = 2;
@@ -460,24 +573,34 @@ static void drawGlassGrid(int x, int y, float fill_percent) {
                 glass_fill = total_fill - glass_index;
             }
 
-            g_display_ptr->drawLine(glass_x, glass_y, glass_x + 3, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
-            g_display_ptr->drawLine(glass_x + GLASS_WIDTH - 1, glass_y, glass_x + GLASS_WIDTH - 4, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
-            g_display_ptr->drawLine(glass_x, glass_y, glass_x + GLASS_WIDTH - 1, glass_y, EPD_BLACK);
-            g_display_ptr->drawLine(glass_x + 3, glass_y + GLASS_HEIGHT - 1, glass_x + GLASS_WIDTH - 4, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
-
-            if (glass_fill > 0.0f) {
-                int fill_height = (int)((GLASS_HEIGHT - 2) * glass_fill);
-                int fill_start_row = GLASS_HEIGHT - 1 - fill_height;
-
-                for (int i = fill_start_row; i < GLASS_HEIGHT - 1; i++) {
-                    float ratio = (float)i / (float)(GLASS_HEIGHT - 1);
-                    int top_inset = 1;
-                    int bottom_inset = 4;
-                    int current_inset = top_inset + (int)(ratio * (bottom_inset - top_inset));
-
-                    int line_start = glass_x + current_inset;
-                    int line_end = glass_x + GLASS_WIDTH - 1 - current_inset;
-                    g_display_ptr->drawLine(line_start, glass_y + i, line_end, glass_y + i, EPD_BLACK);
+            if (g_raster.buf != nullptr) {
+                // Outline rows from the empty tumbler, fill rows from the full one
+                int fill_start_row = GLASS_HEIGHT;
+                if (glass_fill > 0.0f) {
+                    fill_start_row = GLASS_HEIGHT - 1 - (int)((GLASS_HEIGHT - 2) * glass_fill);
+                }
+                rasterBlitSprite(g_raster, glass_x, glass_y, SPRITE_GLASS_EMPTY,
+                                 &SPRITE_GLASS_FULL, fill_start_row);
+            } else {
+                g_display_ptr->drawLine(glass_x, glass_y, glass_x + 3, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
+                g_display_ptr->drawLine(glass_x + GLASS_WIDTH - 1, glass_y, glass_x + GLASS_WIDTH - 4, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
+                g_display_ptr->drawLine(glass_x, glass_y, glass_x + GLASS_WIDTH - 1, glass_y, EPD_BLACK);
+                g_display_ptr->drawLine(glass_x + 3, glass_y + GLASS_HEIGHT - 1, glass_x + GLASS_WIDTH - 4, glass_y + GLASS_HEIGHT - 1, EPD_BLACK);
+
+                if (glass_fill > 0.0f) {
+                    int fill_height = (int)((GLASS_HEIGHT - 2) * glass_fill);
+                    int fill_start_row = GLASS_HEIGHT - 1 - fill_height;
+
+                    for (int i = fill_start_row; i < GLASS_HEIGHT - 1; i++) {
+                        float ratio = (float)i / (float)(GLASS_HEIGHT - 1);
+                        int top_inset = 1;
+                        int bottom_inset = 4;
+                        int current_inset = top_inset + (int)(ratio * (bottom_inset - top_inset));
+
+                        int line_start = glass_x + current_inset;
+                        int line_end = glass_x + GLASS_WIDTH - 1 - current_inset;
+                        g_display_ptr->drawLine(line_start, glass_y + i, line_end, glass_y + i, EPD_BLACK);
+                    }
                 }
             }
 
@@ -489,7 +612,7 @@ static void drawGlassGrid(int x, int y, float fill_percent) {
 
 // Public API Implementation
 
-void displayInit(ThinkInk_213_Mono_GDEY0213B74& display_ref) {
+void displayInit(AquavateDisplay& display_ref) {
     g_display_ptr = &display_ref;
     g_display_state.initialized = false;
     g_display_state.water_ml = 0.0f;
@@ -501,6 +624,16 @@ void displayInit(ThinkInk_213_Mono_GDEY0213B74& display_ref) {
     g_display_state.last_time_check_ms = 0;
     g_display_state.last_battery_check_ms = 0;
 
+    // Rotation is set by now - map the frame buffer for the packed 1bpp primitives
+    if (display_ref.rasterProbe(g_raster)) {
+        DEBUG_PRINTF(g_debug_display, "Display: Raster target %dx%d (x_step=%ld, y_step=%d)\n",
+                     g_raster.width, g_raster.height, (long)g_raster.x_step, g_raster.y_step);
+    } else {
+        DEBUG_PRINTLN(g_debug_display, "Display: No direct frame buffer access - GFX drawing");
+    }
+
+    displayTaskStart();
+
     DEBUG_PRINTLN(g_debug_display, "Display: Initialized state tracking");
 }
 
@@ -520,11 +653,145 @@ bool displayCheckGoalChanged() {
     return false;
 }
 
+// Keep the highest-priority change seen by one displayNeedsUpdate() check
+static void noteChange(RefreshPriority& change, RefreshPriority priority) {
+    if (priority > change) change = priority;
+}
+
+#if ENABLE_REFRESH_GOVERNOR
+#define REFRESH_TOKEN           1000    // Token units per refresh
+
+// Budget tightens as the battery falls
+static uint8_t refreshBudgetPerHour() {
+    uint8_t percent = deviceContextBatteryPercent();
+    if (percent >= REFRESH_BUDGET_MID_BATTERY) return REFRESH_BUDGET_HIGH_PER_HOUR;
+    if (percent >= REFRESH_BUDGET_LOW_BATTERY) return REFRESH_BUDGET_MID_PER_HOUR;
+    return REFRESH_BUDGET_LOW_PER_HOUR;
+}
+
+// Add the tokens earned since the last refill; at most one hour's budget is banked
+static void refreshGovernorRefill() {
+    uint32_t budget = refreshBudgetPerHour();
+    uint32_t cap = budget * REFRESH_TOKEN;
+    uint32_t now = (uint32_t)time(nullptr);
+
+    if (rtc_refresh_refill_time == 0 || now < rtc_refresh_refill_time) {
+        // First use since power-on, or the clock was set backwards
+        if (rtc_refresh_refill_time == 0) rtc_refresh_tokens = cap;
+        rtc_refresh_refill_time = now;
+        return;
+    }
+
+    uint32_t elapsed = now - rtc_refresh_refill_time;
+    if (elapsed > 3600) elapsed = 3600;     // A full hour refills the bucket anyway
+    uint32_t earned = elapsed * budget * REFRESH_TOKEN / 3600;
+    if (earned == 0) {
+        return;     // Keep accumulating elapsed time
+    }
+
+    rtc_refresh_tokens = (rtc_refresh_tokens + earned > cap) ? cap : rtc_refresh_tokens + earned;
+    rtc_refresh_refill_time = now;
+}
+
+// Decide whether a detected change refreshes now. Held changes stay pending - the
+// caller's interval flags aren't reset, so the next check offers them again.
+static bool refreshGovernorAllow(RefreshPriority priority) {
+    if (priority == REFRESH_PRIORITY_NONE) {
+        g_refresh_pending = REFRESH_PRIORITY_NONE;
+        g_refresh_pending_counted = false;
+        return false;
+    }
+
+    uint32_t now_ms = millis();
+    if (g_refresh_pending == REFRESH_PRIORITY_NONE) {
+        g_refresh_pending_since = now_ms;
+    }
+    if (priority > g_refresh_pending) {
+        g_refresh_pending = priority;
+    }
+
+    // The user just drank and is looking at the bottle
+    if (g_refresh_pending >= REFRESH_PRIORITY_INTAKE) {
+        return true;
+    }
+
+    // Let changes arriving close together land in one refresh
+    if (now_ms - g_refresh_pending_since < REFRESH_COALESCE_MS) {
+        DEBUG_PRINTLN(g_debug_display, "Display: Governor coalescing change");
+        return false;
+    }
+
+    refreshGovernorRefill();
+    uint32_t needed = REFRESH_TOKEN;
+    if (g_refresh_pending == REFRESH_PRIORITY_COSMETIC) {
+        needed += REFRESH_COSMETIC_RESERVE * REFRESH_TOKEN;
+    }
+    if (rtc_refresh_tokens >= needed) {
+        return true;
+    }
+
+    if (!g_refresh_pending_counted) {
+        g_refresh_pending_counted = true;
+        activityStatsRecordDisplayDeferred();
+    }
+    DEBUG_PRINTF(g_debug_display, "Display: Governor holding %s change (%lu.%02lu tokens, %u/h)\n",
+                 g_refresh_pending == REFRESH_PRIORITY_COSMETIC ? "cosmetic" : "level",
+                 (unsigned long)(rtc_refresh_tokens / REFRESH_TOKEN),
+                 (unsigned long)(rtc_refresh_tokens % REFRESH_TOKEN / 10), refreshBudgetPerHour());
+    return false;
+}
+
+// A main-screen update is going out - spend its token and clear the pending change
+static void refreshGovernorSpend() {
+    refreshGovernorRefill();
+    rtc_refresh_tokens = (rtc_refresh_tokens >= REFRESH_TOKEN) ? rtc_refresh_tokens - REFRESH_TOKEN : 0;
+    g_refresh_pending = REFRESH_PRIORITY_NONE;
+    g_refresh_pending_counted = false;
+}
+#endif
+
+void displayRefreshStatsPrint() {
+    Serial.println("\n=== DISPLAY REFRESHES ===");
+#if ENABLE_REFRESH_GOVERNOR
+    refreshGovernorRefill();
+    Serial.printf("Budget: %u/hour at %u%% battery, %lu.%02lu tokens banked\n",
+                  refreshBudgetPerHour(), deviceContextBatteryPercent(),
+                  (unsigned long)(rtc_refresh_tokens / REFRESH_TOKEN),
+                  (unsigned long)(rtc_refresh_tokens % REFRESH_TOKEN / 10));
+    Serial.printf("Pending: %s\n",
+                  g_refresh_pending == REFRESH_PRIORITY_NONE ? "none" :
+                  g_refresh_pending == REFRESH_PRIORITY_COSMETIC ? "cosmetic" :
+                  g_refresh_pending == REFRESH_PRIORITY_LEVEL ? "level" : "intake");
+#else
+    Serial.println("Governor: disabled");
+#endif
+#if ENABLE_DEFERRED_RENDER
+    Serial.printf("Deferred render: %s\n", g_render_deferred ? "change held" : "nothing held");
+#endif
+
+    DisplayRefreshDay days[DISPLAY_REFRESH_DAY_COUNT];
+    uint8_t count = activityStatsGetDisplayDays(days, DISPLAY_REFRESH_DAY_COUNT);
+    if (count == 0) {
+        Serial.println("No refreshes recorded since power-on");
+    } else {
+        Serial.println("  day         full  partial  deferred");
+        for (uint8_t i = 0; i < count; i++) {
+            time_t day_start = days[i].day_start;
+            struct tm day_tm;
+            gmtime_r(&day_start, &day_tm);
+            Serial.printf("  %04d-%02d-%02d  %4u  %7u  %8u\n",
+                          day_tm.tm_year + 1900, day_tm.tm_mon + 1, day_tm.tm_mday,
+                          days[i].full_refreshes, days[i].partial_refreshes, days[i].deferred);
+        }
+    }
+    Serial.println("=========================\n");
+}
+
 bool displayNeedsUpdate(float current_water_ml,
                        uint16_t current_daily_ml,
                        bool time_interval_elapsed,
                        bool battery_interval_elapsed) {
-    bool needs_update = false;
+    RefreshPriority change = REFRESH_PRIORITY_NONE;
 
     // Check if water level is valid (ADC stabilized after power-on)
     bool water_valid = (current_water_ml >= -100.0f && current_water_ml <= 1000.0f);
@@ -538,11 +805,11 @@ bool displayNeedsUpdate(float current_water_ml,
     // 1. Water level check (5ml threshold)
     if (!g_display_state.initialized) {
         DEBUG_PRINTF(g_debug_display, "Display: Not initialized - forcing update\n");
-        needs_update = true;
+        noteChange(change, REFRESH_PRIORITY_INTAKE);
     } else if (fabs(current_water_ml - g_display_state.water_ml) >= DISPLAY_UPDATE_THRESHOLD_ML) {
         DEBUG_PRINTF(g_debug_display, "Display: Water level changed (%.1fml -> %.1fml)\n",
                      g_display_state.water_ml, current_water_ml);
-        needs_update = true;
+        noteChange(change, REFRESH_PRIORITY_LEVEL);
     }
 
     // 2. Daily intake check (50ml threshold)
@@ -550,44 +817,42 @@ bool displayNeedsUpdate(float current_water_ml,
         DRINK_DISPLAY_UPDATE_THRESHOLD_ML) {
         DEBUG_PRINTF(g_debug_display, "Display: Daily intake changed (%dml -> %dml)\n",
                      g_display_state.daily_total_ml, current_daily_ml);
-        needs_update = true;
+        noteChange(change, REFRESH_PRIORITY_INTAKE);
     }
 
     // 3. Time check (always check if time is valid, update if hour changed or 15+ min elapsed)
-    if (g_time_valid) {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-        struct tm timeinfo;
-        gmtime_r(&now, &timeinfo);
-
+    struct tm timeinfo;
+    if (deviceContextLocalTime(timeinfo)) {
         // Update if: hour changed OR 15+ minutes elapsed since last check
         if (timeinfo.tm_hour != g_display_state.hour ||
             (time_interval_elapsed && abs(timeinfo.tm_min - (int)g_display_state.minute) >= DISPLAY_TIME_UPDATE_THRESHOLD_MIN)) {
             DEBUG_PRINTF(g_debug_display, "Display: Time changed (%d:%02d -> %d:%02d)\n",
                          g_display_state.hour, g_display_state.minute,
                          timeinfo.tm_hour, timeinfo.tm_min);
-            needs_update = true;
+            noteChange(change, REFRESH_PRIORITY_COSMETIC);
         }
     }
 
     // 4. Battery check (if interval elapsed)
 #if defined(BOARD_ADAFRUIT_FEATHER)
     if (battery_interval_elapsed) {
-        float voltage = getBatteryVoltage();
-        int raw_percent = getBatteryPercent(voltage);
-        uint8_t quantized = quantizeBatteryPercent(raw_percent);
+        // Filtered level - ADC noise alone can't cross a quantisation step
+        uint8_t quantized = quantizeBatteryPercent(deviceContextBatteryPercent());
 
         if (abs((int)quantized - (int)g_display_state.battery_percent) >=
             DISPLAY_BATTERY_UPDATE_THRESHOLD) {
             DEBUG_PRINTF(g_debug_display, "Display: Battery changed (%d%% -> %d%%)\n",
                          g_display_state.battery_percent, quantized);
-            needs_update = true;
+            noteChange(change, REFRESH_PRIORITY_COSMETIC);
         }
     }
 #endif
 
-    return needs_update;
+#if ENABLE_REFRESH_GOVERNOR
+    return refreshGovernorAllow(change);
+#else
+    return change != REFRESH_PRIORITY_NONE;
+#endif
 }
 
 void displayUpdate(float water_ml, uint16_t daily_total_ml,
@@ -611,6 +876,13 @@ void displayUpdate(float water_ml, uint16_t daily_total_ml,
     g_display_state.last_update_ms = millis();
     g_display_state.initialized = true;
 
+#if ENABLE_REFRESH_GOVERNOR
+    refreshGovernorSpend();
+#endif
+#if ENABLE_DEFERRED_RENDER
+    g_render_deferred = false;  // This render carries any held change
+#endif
+
     // Render the main screen
     drawMainScreen();
 }
@@ -623,11 +895,258 @@ void displayForceUpdate(float water_ml, uint16_t daily_total_ml,
     displayUpdate(water_ml, daily_total_ml, hour, minute, battery_percent, sleeping);
 }
 
+void displayDeferUpdate(float water_ml, uint16_t daily_total_ml,
+                        uint8_t hour, uint8_t minute, uint8_t battery_percent) {
+#if ENABLE_DEFERRED_RENDER
+    if (g_display_ptr != nullptr && g_display_state.initialized) {
+        DEBUG_PRINTF(g_debug_display, "Display: Holding change (water=%.1fml, daily=%dml) for one render\n",
+                     water_ml, daily_total_ml);
+
+        // Later checks compare against the held values, so each change is only taken once
+        g_display_state.water_ml = water_ml;
+        g_display_state.daily_total_ml = daily_total_ml;
+        g_display_state.hour = hour;
+        g_display_state.minute = minute;
+        g_display_state.battery_percent = battery_percent;
+        g_display_state.sleeping = false;
+        g_render_deferred = true;
+        g_render_deferred_last_ms = millis();
+        return;
+    }
+#endif
+    // Splash screen still up - the first main screen can't wait
+    displayUpdate(water_ml, daily_total_ml, hour, minute, battery_percent, false);
+}
+
+bool displayDeferredDue() {
+#if ENABLE_DEFERRED_RENDER
+    return g_render_deferred && millis() - g_render_deferred_last_ms >= DISPLAY_DEFER_QUIET_MS;
+#else
+    return false;
+#endif
+}
+
+void displayFlushDeferred() {
+#if ENABLE_DEFERRED_RENDER
+    if (!g_render_deferred) {
+        return;
+    }
+
+    DEBUG_PRINTF(g_debug_display, "Display: Rendering held changes (%lums since the last)\n",
+                 (unsigned long)(millis() - g_render_deferred_last_ms));
+    displayUpdate(g_display_state.water_ml, g_display_state.daily_total_ml,
+                  g_display_state.hour, g_display_state.minute,
+                  g_display_state.battery_percent, false);
+#endif
+}
+
 // Get current display state (for sleep mode to reuse last valid values)
 DisplayState displayGetState() {
     return g_display_state;
 }
 
+// Push the frame buffer to the panel with the display power lock held (false if the frame hash matches)
+bool displayPushBuffer(AquavateDisplay& display_ref) {
+    uint32_t hash = 0;
+    bool hashed = false;
+#if ENABLE_EPD_FRAME_HASH
+    hashed = display_ref.frameBufferHash(hash);
+    if (hashed && rtc_panel_hash_valid && hash == rtc_panel_hash) {
+        DEBUG_PRINTF(g_debug_display, "Display: Frame unchanged (hash %08lX) - refresh skipped\n",
+                     (unsigned long)hash);
+        return false;
+    }
+#endif
+
+    {
+        PowerLockGuard lock(POWER_LOCK_DISPLAY);
+#if ENABLE_ENERGY_LEDGER
+        EnergyOverlayScope energy(ENERGY_OVERLAY_EPD_REFRESH);
+#endif
+        display_ref.display();
+    }
+    activityStatsRecordDisplayRefresh(false);
+    rtc_panel_hash = hash;
+    rtc_panel_hash_valid = hashed;
+
+#if defined(BOARD_ADAFRUIT_FEATHER)
+    // Panel no longer shows a known main screen - next main screen needs a full refresh
+    rtc_panel_frame_valid = false;
+    g_controller_ram_synced = false;
+#endif
+    return true;
+}
+
+// SSD1680 commands used by the partial-refresh path
+#define SSD1680_CMD_MASTER_ACTIVATE     0x20
+#define SSD1680_CMD_DISP_CTRL1          0x21
+#define SSD1680_CMD_DISP_CTRL2          0x22
+#define SSD1680_CMD_WRITE_BORDER        0x3C
+#define SSD1680_CMD_SET_RAMYCOUNT       0x4F
+
+void AquavateDisplay::partialBegin(bool controller_ready) {
+    if (!controller_ready) {
+        powerUp();
+    }
+
+    // Use both RAMs as written (the mono init bypasses the old-image RAM)
+    const uint8_t disp_ctrl1[] = { 0x00, 0x80 };
+    EPD_command(SSD1680_CMD_DISP_CTRL1, disp_ctrl1, sizeof(disp_ctrl1));
+
+    // Border follows VCOM so it does not flash
+    const uint8_t border[] = { 0x80 };
+    EPD_command(SSD1680_CMD_WRITE_BORDER, border, sizeof(border));
+}
+
+void AquavateDisplay::writeRAMFramebufferToEPD(uint8_t* buffer, uint32_t buffer_size,
+                                                uint8_t location, bool invertdata) {
+    if (invertdata) {
+        // Bulk write sends the buffer as-is - inverting needs the per-byte path
+        ThinkInk_213_Mono_GDEY0213B74::writeRAMFramebufferToEPD(buffer, buffer_size, location, invertdata);
+        return;
+    }
+
+    writeRAMCommand(location);
+    dcHigh();
+    spi_dev->write(buffer, buffer_size);
+    csHigh();
+}
+
+bool AquavateDisplay::frameBufferHash(uint32_t& hash) {
+    if (use_sram || buffer1 == nullptr) {
+        return false;
+    }
+
+    // 32-bit FNV-1a (~40us for the 4KB plane)
+    uint32_t h = 2166136261UL;
+    for (uint32_t i = 0; i < buffer1_size; i++) {
+        h ^= buffer1[i];
+        h *= 16777619UL;
+    }
+    hash = h;
+    return true;
+}
+
+// Linear bit (MSB-first) changed by drawing one black pixel into a clear buffer
+static bool probePixel(AquavateDisplay& epd, uint8_t* buf, uint32_t size, int16_t x, int16_t y,
+                       int32_t& bit, bool& ink_sets_bits) {
+    epd.clearBuffer();
+    uint8_t blank = buf[0];
+    epd.drawPixel(x, y, EPD_BLACK);
+
+    for (uint32_t i = 0; i < size; i++) {
+        uint8_t diff = buf[i] ^ blank;
+        if (diff == 0) continue;
+        if ((diff & (diff - 1)) != 0) return false;  // More than one bit changed
+
+        uint8_t bit_index = 0;
+        while ((diff >> bit_index) != 1) bit_index++;
+        bit = (int32_t)i * 8 + (7 - bit_index);
+        ink_sets_bits = (buf[i] & diff) != 0;
+        return true;
+    }
+    return false;
+}
+
+bool AquavateDisplay::rasterProbe(RasterTarget& target) {
+    target.buf = nullptr;
+    if (use_sram || buffer1 == nullptr) {
+        return false;
+    }
+
+    int32_t origin;
+    int32_t below;
+    int32_t right;
+    bool ink_sets_bits = false;
+    bool ok = probePixel(*this, buffer1, buffer1_size, 0, 0, origin, ink_sets_bits) &&
+              probePixel(*this, buffer1, buffer1_size, 0, 1, below, ink_sets_bits) &&
+              probePixel(*this, buffer1, buffer1_size, 1, 0, right, ink_sets_bits);
+    clearBuffer();
+    if (!ok) {
+        return false;
+    }
+
+    RasterTarget probed;
+    probed.buf = buffer1;
+    probed.size_bytes = buffer1_size;
+    probed.origin_bit = origin;
+    probed.x_step = right - origin;
+    probed.y_step = (int8_t)(below - origin);
+    probed.ink_sets_bits = ink_sets_bits;
+    probed.width = width();
+    probed.height = height();
+
+    // Columns must be contiguous runs, and every corner must land in the buffer
+    if (below - origin != 1 && below - origin != -1) {
+        return false;
+    }
+    for (uint8_t corner = 0; corner < 4; corner++) {
+        int32_t bit = origin;
+        if (corner & 1) bit += (int32_t)(probed.width - 1) * probed.x_step;
+        if (corner & 2) bit += (int32_t)(probed.height - 1) * probed.y_step;
+        if (bit < 0 || bit >= (int32_t)buffer1_size * 8) {
+            return false;
+        }
+    }
+
+    target = probed;
+    return true;
+}
+
+void AquavateDisplay::gateRowsFor(const DisplayRect& area, uint16_t& first_row, uint16_t& last_row) {
+    // Frame buffer row r holds panel x' = WIDTH - 1 - r (see Adafruit_EPD::drawPixel)
+    int32_t lo;
+    int32_t hi;
+    switch (getRotation()) {
+        case 0:  lo = WIDTH - area.x - area.w;  hi = WIDTH - 1 - area.x;  break;
+        case 1:  lo = area.y;                   hi = area.y + area.h - 1; break;
+        case 2:  lo = area.x;                   hi = area.x + area.w - 1; break;
+        default: lo = WIDTH - area.y - area.h;  hi = WIDTH - 1 - area.y;  break;
+    }
+    if (lo < 0) lo = 0;
+    if (hi > WIDTH - 1) hi = WIDTH - 1;
+    if (hi < lo) hi = lo;
+    first_row = (uint16_t)lo;
+    last_row = (uint16_t)hi;
+}
+
+void AquavateDisplay::partialWriteFrame(bool previous, const DisplayRect* area) {
+    uint8_t location = previous ? 1 : 0;  // 0 = RAM1 (0x24, new image), 1 = RAM2 (0x26, old image)
+    uint32_t bytes_per_row = buffer1_size / WIDTH;
+
+    uint16_t first_row = 0;
+    uint16_t last_row = WIDTH - 1;
+    if (area != nullptr) {
+        gateRowsFor(*area, first_row, last_row);
+    }
+    uint32_t offset = first_row * bytes_per_row;
+    uint32_t length = (uint32_t)(last_row - first_row + 1) * bytes_per_row;
+
+    // X counter back to the row start, then Y counter to the first gate row
+    setRAMAddress(0, 0);
+    const uint8_t y_count[] = { (uint8_t)(first_row & 0xFF), (uint8_t)(first_row >> 8) };
+    EPD_command(SSD1680_CMD_SET_RAMYCOUNT, y_count, sizeof(y_count));
+
+    if (use_sram) {
+        writeSRAMFramebufferToEPD(buffer1_addr + offset, length, location);
+    } else {
+        writeRAMFramebufferToEPD(buffer1 + offset, length, location);
+    }
+}
+
+void AquavateDisplay::partialRefresh() {
+    // Clock + analog on, load temperature and the mode 2 (differential) LUT, display
+    const uint8_t update_sequence[] = { 0xFC };
+    EPD_command(SSD1680_CMD_DISP_CTRL2, update_sequence, sizeof(update_sequence));
+    EPD_command(SSD1680_CMD_MASTER_ACTIVATE);
+
+    if (_busy_pin >= 0) {
+        busy_wait();
+    } else {
+        delay(EPD_PARTIAL_REFRESH_MS);  // Yields - only the display task waits
+    }
+}
+
 // Mark display as initialized without reading sensors
 // Used when waking from deep sleep - e-paper retains image, so no update needed
 // IMPORTANT: We don't read sensors here because bottle may be tilted/unstable during wake
@@ -652,6 +1171,9 @@ void displayMarkInitialized() {
 
 // Save display state to RTC memory before entering deep sleep
 void displaySaveToRTC() {
+    // An in-flight refresh has to finish before the panel loses power
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);
+
     rtc_display_water_ml = g_display_state.water_ml;
     rtc_display_daily_ml = g_display_state.daily_total_ml;
     rtc_display_hour = g_display_state.hour;
@@ -693,6 +1215,7 @@ bool displayRestoreFromRTC() {
 // Display backpack mode screen with user instructions (Issue #38)
 void displayBackpackMode() {
     if (g_display_ptr == nullptr) return;
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);  // Frame buffer is the refresh task's until then
 
     g_display_ptr->clearBuffer();
     g_display_ptr->setTextColor(EPD_BLACK);
@@ -724,12 +1247,13 @@ void displayBackpackMode() {
     g_display_ptr->setCursor((250 - note_width) / 2, 105);
     g_display_ptr->print(note);
 
-    g_display_ptr->display();
+    displayPushBuffer(*g_display_ptr);
 }
 
 // Display full-screen low battery lockout screen (Issue #68)
 void displayLowBattery() {
     if (g_display_ptr == nullptr) return;
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);  // Frame buffer is the refresh task's until then
 
     g_display_ptr->clearBuffer();
     g_display_ptr->setTextColor(EPD_BLACK);
@@ -768,12 +1292,13 @@ void displayLowBattery() {
     g_display_ptr->setCursor((250 - note_width) / 2, 105);
     g_display_ptr->print(note);
 
-    g_display_ptr->display();
+    displayPushBuffer(*g_display_ptr);
 }
 
 // Display immediate feedback when waking from tap (shows "waking" text)
 void displayTapWakeFeedback() {
     if (g_display_ptr == nullptr) return;
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);  // Frame buffer is the refresh task's until then
 
     // Show "waking" text centered with "please wait" below
     g_display_ptr->clearBuffer();
@@ -795,7 +1320,7 @@ void displayTapWakeFeedback() {
     g_display_ptr->setCursor(subtext_x, 72);
     g_display_ptr->print(subtext);
 
-    g_display_ptr->display();
+    displayPushBuffer(*g_display_ptr);
 
     DEBUG_PRINTLN(g_debug_display, "Display: Tap wake feedback shown (waking)");
 }
@@ -803,6 +1328,7 @@ void displayTapWakeFeedback() {
 // Display NVS storage warning screen (shown when drink save fails)
 void displayNVSWarning() {
     if (g_display_ptr == nullptr) return;
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);  // Frame buffer is the refresh task's until then
 
     DEBUG_PRINTLN(g_debug_display, "Display: Showing NVS warning");
 
@@ -820,82 +1346,146 @@ void displayNVSWarning() {
     g_display_ptr->setCursor((250 - w2) / 2, 70);
     g_display_ptr->print(line2);
 
-    g_display_ptr->display();  // Full refresh
-    delay(3000);               // Show for 3 seconds
+    displayPushBuffer(*g_display_ptr);  // Full refresh
 
-    // Redraw main screen
-    drawMainScreen();
+    // Redraw main screen from loop() after the hold (sensors/BLE keep running)
+    uiSequenceHold(INFO_SCREEN_DISPLAY_MS, drawMainScreen);
 }
 
 #if defined(BOARD_ADAFRUIT_FEATHER)
-void drawMainScreen() {
-    if (g_display_ptr == nullptr) return;
+// Bottle fill (0.0-1.0) shown for a frame
+static float mainBottleFill(const MainScreenFrame& frame) {
+    // Clamp to valid range for display
+    float display_ml = frame.water_ml;
+    if (display_ml < 0) display_ml = 0;  // Clamp negative values for fill calculation
+    if (display_ml > 830) display_ml = 830;
+    return display_ml / 830.0f;
+}
 
-    DEBUG_PRINTLN(g_debug_display, "Drawing main screen...");
-    g_display_ptr->clearBuffer();
-    g_display_ptr->setTextColor(EPD_BLACK);
+// Check if weight is significantly negative (needs tare or cap is off)
+// Using same -50ml threshold as gestures.cpp for UPRIGHT_STABLE detection
+static bool mainBottleQuestion(const MainScreenFrame& frame) {
+    return frame.water_ml < -50.0f;
+}
 
-    // Get current water level
-    float water_ml = g_display_state.water_ml;
+// Daily intake visualization fill (0.0-1.0) - empty until time is valid
+static float mainDailyFill(const MainScreenFrame& frame) {
+    if (!frame.time_valid) return 0.0f;
+    float daily_fill = (float)frame.daily_total_ml / (float)frame.daily_goal_ml;
+    return daily_fill > 1.0f ? 1.0f : daily_fill;
+}
 
-    // Check if weight is significantly negative (needs tare or cap is off)
-    // Using same -50ml threshold as gestures.cpp for UPRIGHT_STABLE detection
-    bool show_question_mark = (water_ml < -50.0f);
+// Quantised widget input - same arithmetic as the draw helpers, so equal keys mean
+// equal pixels (text widgets are compared separately)
+static int32_t mainWidgetKey(const MainScreenFrame& frame, MainWidget widget) {
+    switch (widget) {
+        case MAIN_WIDGET_BOTTLE: {
+            float fill = mainBottleFill(frame);
+            int32_t key = (int32_t)(BOTTLE_BODY_HEIGHT * fill);
+            if (mainBottleQuestion(frame)) {
+                key |= (fill > 0.5f) ? 0x300 : 0x100;  // "?" and its colour
+            }
+            return key;
+        }
+        case MAIN_WIDGET_BATTERY:
+            return (frame.battery_percent * 16) / 100;
+        case MAIN_WIDGET_DAILY: {
+            float fill = mainDailyFill(frame);
+            if (frame.intake_display_mode == 0) {
+                return (int32_t)(HUMAN_FIGURE_HEIGHT * (1.0f - fill));
+            }
+            float total_fill = fill * GLASS_GRID_COUNT;
+            int32_t full = (int32_t)total_fill;
+            return 0x10000 | (full * GLASS_FILL_ROWS +
+                              (int32_t)(GLASS_FILL_ROWS * (total_fill - full)));
+        }
+        default:
+            return 0;
+    }
+}
 
-    // Clamp to valid range for display
-    float display_ml = water_ml;
-    if (display_ml < 0) display_ml = 0;  // Clamp negative values for fill calculation
-    if (display_ml > 830) display_ml = 830;
+static bool mainWidgetChanged(const MainScreenFrame& a, const MainScreenFrame& b, MainWidget widget) {
+    switch (widget) {
+        case MAIN_WIDGET_INTAKE:
+            return a.daily_total_ml != b.daily_total_ml;
+        case MAIN_WIDGET_TIME:
+            return strcmp(a.time_text, b.time_text) != 0;
+        default:
+            return mainWidgetKey(a, widget) != mainWidgetKey(b, widget);
+    }
+}
+
+// Collect the bounds of widgets whose pixels differ between the two frames
+// @return Number of dirty rectangles written to dirty[]
+static uint8_t mainScreenDirtyRects(const MainScreenFrame& shown, const MainScreenFrame& next,
+                                    DisplayRect dirty[MAIN_WIDGET_COUNT]) {
+    uint8_t count = 0;
+    for (uint8_t w = 0; w < MAIN_WIDGET_COUNT; w++) {
+        if (mainWidgetChanged(shown, next, (MainWidget)w)) {
+            dirty[count++] = MAIN_WIDGET_BOUNDS[w];
+            DEBUG_PRINTF(g_debug_display, "Display: Widget %s dirty\n", MAIN_WIDGET_NAMES[w]);
+        }
+    }
+    return count;
+}
+
+// Render a main-screen frame into the frame buffer
+static void renderMainScreen(const MainScreenFrame& frame) {
+    g_display_ptr->clearBuffer();
+    g_display_ptr->setTextColor(EPD_BLACK);
 
     // Draw vertical bottle graphic on left side (shifted down 3px)
     int bottle_x = 10;
     int bottle_y = 23;
-    float fill_percent = display_ml / 830.0f;
-    drawBottleGraphic(bottle_x, bottle_y, fill_percent, show_question_mark);
+    drawBottleGraphic(bottle_x, bottle_y, mainBottleFill(frame), mainBottleQuestion(frame));
 
     // Draw large text showing daily intake (center, shifted down 3px)
     g_display_ptr->setTextSize(3);
     char intake_text[16];
-    snprintf(intake_text, sizeof(intake_text), "%dml", g_display_state.daily_total_ml);
+    snprintf(intake_text, sizeof(intake_text), "%dml", frame.daily_total_ml);
 
     int intake_text_width = strlen(intake_text) * 18;
     int available_width = 185 - 60;
     int intake_x = 60 + (available_width - intake_text_width) / 2;
 
-    g_display_ptr->setCursor(intake_x, 53);
-    g_display_ptr->print(intake_text);
-
     // Draw "today" label below (shifted down 3px)
-    g_display_ptr->setTextSize(2);
     int today_width = 5 * 12;
     int today_x = 60 + (available_width - today_width) / 2;
-    g_display_ptr->setCursor(today_x, 78);
-    g_display_ptr->print("today");
+
+    if (g_raster.buf != nullptr) {
+        for (int i = 0; intake_text[i] != '\0'; i++) {
+            const RasterSprite* glyph = spriteLargeGlyph(intake_text[i]);
+            if (glyph != nullptr) {
+                rasterBlitSprite(g_raster, intake_x + i * SPRITE_LARGE_ADVANCE, 53, *glyph);
+            }
+        }
+        rasterBlitSprite(g_raster, today_x, 78, SPRITE_TODAY);
+    } else {
+        g_display_ptr->setCursor(intake_x, 53);
+        g_display_ptr->print(intake_text);
+
+        g_display_ptr->setTextSize(2);
+        g_display_ptr->setCursor(today_x, 78);
+        g_display_ptr->print("today");
+    }
 
     // Draw battery status in top-right corner
-    drawBatteryIcon(220, 5, g_display_state.battery_percent);
+    drawBatteryIcon(220, 5, frame.battery_percent);
 
     // Draw time centered at top
-    char time_text[16];
-    formatTimeForDisplay(time_text, sizeof(time_text));
     g_display_ptr->setTextSize(1);
 
-    int text_width = strlen(time_text) * 6;
+    int text_width = strlen(frame.time_text) * 6;
     int center_x = (250 - text_width) / 2;
     g_display_ptr->setCursor(center_x, 5);
-    g_display_ptr->print(time_text);
+    g_display_ptr->print(frame.time_text);
 
     // Draw daily intake visualization (if time is valid)
-    float daily_fill = 0.0f;
-    bool goal_reached = false;
-    if (g_time_valid) {
-        daily_fill = (float)g_display_state.daily_total_ml / (float)g_daily_goal_ml;
-        if (daily_fill > 1.0f) daily_fill = 1.0f;
-        goal_reached = (g_display_state.daily_total_ml >= g_daily_goal_ml);
-    }
+    float daily_fill = mainDailyFill(frame);
+    bool goal_reached = frame.time_valid && (frame.daily_total_ml >= frame.daily_goal_ml);
 
     // Use runtime display mode instead of compile-time constant (shifted down 3px)
-    if (g_daily_intake_display_mode == 0) {
+    if (frame.intake_display_mode == 0) {
         int figure_x = 185;
         int figure_y = 26;  // Human figure shifted down additional 3px (total 6px from original)
         drawHumanFigure(figure_x, figure_y, daily_fill, goal_reached);
@@ -904,7 +1494,193 @@ void drawMainScreen() {
         int grid_y = 23;
         drawGlassGrid(grid_x, grid_y, daily_fill);
     }
+}
+
+// Partial refresh unless the panel content is unknown or the ghosting budget is spent
+static bool mainScreenPartialAllowed() {
+#if ENABLE_EPD_PARTIAL_REFRESH
+    if (!rtc_panel_frame_valid) return false;
+    if (rtc_partial_count >= EPD_PARTIAL_MAX_BEFORE_FULL) return false;
+    if (g_time_valid && rtc_last_full_refresh != 0 &&
+        (uint32_t)time(nullptr) - rtc_last_full_refresh >= EPD_FULL_REFRESH_MAX_AGE_SEC) {
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+// @param area Union of the dirty widget bounds
+static void pushMainScreenPartial(const MainScreenFrame& frame, const DisplayRect& area) {
+    PowerLockGuard lock(POWER_LOCK_DISPLAY);
+#if ENABLE_ENERGY_LEDGER
+    EnergyOverlayScope energy(ENERGY_OVERLAY_EPD_REFRESH);
+#endif
+    // Controller RAM only matches the panel after a partial this boot - otherwise
+    // load the whole frame the panel shows into the old-image RAM first
+    bool synced = g_controller_ram_synced;
+    const DisplayRect* rows = synced ? &area : nullptr;
+
+    g_display_ptr->partialBegin(synced);
+    if (!synced) {
+        renderMainScreen(rtc_panel_frame);
+        g_display_ptr->partialWriteFrame(true);
+    }
+    renderMainScreen(frame);
+    g_display_ptr->partialWriteFrame(false, rows);
+    g_display_ptr->partialRefresh();
+    activityStatsRecordDisplayRefresh(true);
+
+    // Old-image RAM = panel again, so the next partial only needs its own rows
+    g_display_ptr->partialWriteFrame(true, rows);
+    g_controller_ram_synced = true;
+
+    rtc_panel_hash_valid = g_display_ptr->frameBufferHash(rtc_panel_hash);
+}
+
+// Render + refresh one main-screen frame (display task, or inline without it)
+static void presentMainScreen(const MainScreenFrame& frame) {
+    if (rtc_panel_frame_valid) {
+        DisplayRect dirty[MAIN_WIDGET_COUNT];
+        uint8_t dirty_count = mainScreenDirtyRects(rtc_panel_frame, frame, dirty);
+
+        if (dirty_count == 0) {
+            // Same pixels - keep the newer inputs, skip the panel transfer
+            DEBUG_PRINTLN(g_debug_display, "Display: No widget changed - refresh skipped");
+            rtc_panel_frame = frame;
+            return;
+        }
+
+        if (mainScreenPartialAllowed()) {
+            DisplayRect area = dirty[0];
+            for (uint8_t i = 1; i < dirty_count; i++) {
+                int16_t x1 = area.x + area.w;
+                int16_t y1 = area.y + area.h;
+                if (dirty[i].x + dirty[i].w > x1) x1 = dirty[i].x + dirty[i].w;
+                if (dirty[i].y + dirty[i].h > y1) y1 = dirty[i].y + dirty[i].h;
+                if (dirty[i].x < area.x) area.x = dirty[i].x;
+                if (dirty[i].y < area.y) area.y = dirty[i].y;
+                area.w = x1 - area.x;
+                area.h = y1 - area.y;
+            }
+
+            DEBUG_PRINTF(g_debug_display, "Drawing main screen (partial %d/%d, %d widgets)...\n",
+                         rtc_partial_count + 1, EPD_PARTIAL_MAX_BEFORE_FULL, dirty_count);
+            pushMainScreenPartial(frame, area);
+            rtc_partial_count++;
+            rtc_panel_frame = frame;
+            return;
+        }
+    }
+
+    DEBUG_PRINTLN(g_debug_display, "Drawing main screen (full refresh)...");
+    renderMainScreen(frame);
+    if (displayPushBuffer(*g_display_ptr)) {
+        rtc_partial_count = 0;
+        rtc_last_full_refresh = g_time_valid ? (uint32_t)time(nullptr) : 0;
+    }
 
-    g_display_ptr->display();
+    rtc_panel_frame = frame;
+    rtc_panel_frame_valid = true;
+}
+
+// ==================== Display task ====================
+// The refresh waits (fixed delays - the FeatherWing has no BUSY line) block whoever
+// calls display(), so main-screen renders run on their own task: the loop snapshots
+// the frame, posts it and carries on sampling, detecting gestures and serving BLE.
+// Depth-1 mailbox - a frame posted while another is waiting replaces it.
+
+struct DisplayRequest {
+    MainScreenFrame frame;
+    uint32_t sequence;
+};
+
+static TaskHandle_t g_display_task = nullptr;
+static QueueHandle_t g_display_mailbox = nullptr;
+static portMUX_TYPE g_display_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t g_display_posted = 0;       // Sequence of the newest posted frame (g_display_mux)
+static uint32_t g_display_completed = 0;    // Sequence of the last frame on the panel (g_display_mux)
+
+#define DISPLAY_TASK_STACK      4096
+
+static void displayTask(void* param) {
+    (void)param;
+    DisplayRequest request;
+
+    for (;;) {
+        if (xQueueReceive(g_display_mailbox, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        presentMainScreen(request.frame);
+
+        taskENTER_CRITICAL(&g_display_mux);
+        g_display_completed = request.sequence;
+        taskEXIT_CRITICAL(&g_display_mux);
+    }
+}
+
+static void displayTaskStart() {
+#if ENABLE_DISPLAY_TASK
+    if (g_display_task) return;
+
+    g_display_mailbox = xQueueCreate(1, sizeof(DisplayRequest));
+    if (g_display_mailbox == nullptr ||
+        xTaskCreatePinnedToCore(displayTask, "display", DISPLAY_TASK_STACK, nullptr,
+                                DISPLAY_TASK_PRIORITY, &g_display_task, DISPLAY_TASK_CORE) != pdPASS) {
+        Serial.println("ERROR: Display task creation failed - refreshing inline");
+        g_display_task = nullptr;
+    }
+#endif
+}
+
+void drawMainScreen() {
+    if (g_display_ptr == nullptr) return;
+
+    MainScreenFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.water_ml = g_display_state.water_ml;
+    frame.daily_total_ml = g_display_state.daily_total_ml;
+    frame.daily_goal_ml = g_daily_goal_ml;
+    frame.battery_percent = g_display_state.battery_percent;
+    frame.intake_display_mode = g_daily_intake_display_mode;
+    frame.time_valid = g_time_valid;
+    formatTimeForDisplay(frame.time_text, sizeof(frame.time_text));
+
+    if (!g_display_task) {
+        presentMainScreen(frame);
+        return;
+    }
+
+    DisplayRequest request;
+    request.frame = frame;
+    taskENTER_CRITICAL(&g_display_mux);
+    request.sequence = ++g_display_posted;
+    taskEXIT_CRITICAL(&g_display_mux);
+
+    if (uxQueueMessagesWaiting(g_display_mailbox) > 0) {
+        DEBUG_PRINTLN(g_debug_display, "Display: Replacing a frame not yet rendered");
+    }
+    xQueueOverwrite(g_display_mailbox, &request);
+}
+
+bool displayBusy() {
+    taskENTER_CRITICAL(&g_display_mux);
+    bool busy = g_display_completed != g_display_posted;
+    taskEXIT_CRITICAL(&g_display_mux);
+    return busy;
+}
+
+bool displayWaitIdle(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    while (displayBusy()) {
+        if (millis() - start >= timeout_ms) {
+            Serial.println("ERROR: Timed out waiting for the display refresh");
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
 }
 #endif
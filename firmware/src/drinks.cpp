@@ -9,6 +9,9 @@
 #include "config.h"
 #include "calibration.h"
 #include "display.h"
+#if ENABLE_SLEEP_SCHEDULER
+#include "sleep_scheduler.h"
+#endif
 #include <sys/time.h>
 #include <time.h>
 
@@ -258,6 +261,9 @@ bool drinksUpdate(int32_t current_adc, const CalibrationData& cal) {
 
         // Try to save drink record to NVS
         bool record_saved = storageSaveDrinkRecord(record);
+#if ENABLE_SLEEP_SCHEDULER
+        sleepSchedulerRecordDrink(record.timestamp);
+#endif
 
         // Update baseline
         g_daily_state.last_recorded_adc = current_adc;
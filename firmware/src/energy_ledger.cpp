@@ -0,0 +1,202 @@
+// energy_ledger.cpp - Per-power-state energy accounting and battery-life estimate
+// Part of the Aquavate smart water bottle firmware
+
+#include "energy_ledger.h"
+
+#if ENABLE_ENERGY_LEDGER
+
+#include <esp_timer.h>
+#include <sys/time.h>
+
+#define RTC_MAGIC_ENERGY        0x454E5247  // "ENRG"
+#define ENERGY_WINDOW_US        (86400ULL * 1000000ULL)     // One day per window
+#define ENERGY_MAX_SLEEP_US     (30ULL * 86400ULL * 1000000ULL)  // Reject bogus sleep spans
+
+// Per-bucket current (uA) - base states then overlays, same order as the enums
+static const uint32_t BUCKET_CURRENT_UA[ENERGY_BUCKET_COUNT] = {
+    ENERGY_CURRENT_SLEEP_NORMAL_UA,
+    ENERGY_CURRENT_SLEEP_EXTENDED_UA,
+    ENERGY_CURRENT_AWAKE_IDLE_UA,
+    ENERGY_CURRENT_ADVERTISING_UA,
+    ENERGY_CURRENT_CONNECTED_UA,
+    ENERGY_CURRENT_SYNCING_UA,
+    ENERGY_CURRENT_EPD_REFRESH_UA,
+    ENERGY_CURRENT_FLASH_WRITE_UA,
+    ENERGY_CURRENT_NAU_ACTIVE_UA,
+};
+
+// RTC ledger - survives deep sleep, lost on power cycle
+struct EnergyLedgerRtc {
+    uint32_t magic;
+    uint64_t time_us[ENERGY_BUCKET_COUNT];  // Current window
+    uint64_t window_us;                     // Base-state time in the current window
+    float    mah_per_day;                   // Rolling estimate (0 = no full window yet)
+    int64_t  sleep_start_us;                // gettimeofday() at sleep entry
+    bool     sleep_pending;                 // Sleep entered, not yet accounted
+    bool     sleep_extended;
+};
+RTC_DATA_ATTR static EnergyLedgerRtc rtc_energy;
+
+static const char* const BUCKET_NAMES[ENERGY_BUCKET_COUNT] = {
+    "sleep_normal",
+    "sleep_extended",
+    "awake_idle",
+    "advertising",
+    "ble_connected",
+    "ble_syncing",
+    "+epd_refresh",
+    "+flash_write",
+    "+nau_active",
+};
+
+static int64_t g_last_tick_us = 0;
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static int64_t wallClockUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+static float windowChargeMah(const EnergyLedgerRtc& ledger) {
+    double uah = 0;
+    for (uint8_t i = 0; i < ENERGY_BUCKET_COUNT; i++) {
+        uah += (double)ledger.time_us[i] * BUCKET_CURRENT_UA[i] / 3600e6;
+    }
+    return (float)(uah / 1000.0);
+}
+
+// Caller holds g_mux
+static void addBaseTime(EnergyState state, uint64_t duration_us) {
+    rtc_energy.time_us[state] += duration_us;
+    rtc_energy.window_us += duration_us;
+
+    // NAU7802 is never powered down - it converts through every state, sleep included
+    rtc_energy.time_us[ENERGY_STATE_COUNT + ENERGY_OVERLAY_NAU_ACTIVE] += duration_us;
+}
+
+// Roll the window once a full day has been accounted
+static void rollWindow() {
+    taskENTER_CRITICAL(&g_mux);
+    if (rtc_energy.window_us < ENERGY_WINDOW_US) {
+        taskEXIT_CRITICAL(&g_mux);
+        return;
+    }
+
+    float day_mah = windowChargeMah(rtc_energy) * (float)((double)ENERGY_WINDOW_US / rtc_energy.window_us);
+    if (rtc_energy.mah_per_day <= 0.0f) {
+        rtc_energy.mah_per_day = day_mah;
+    } else {
+        // Smooth day-to-day variation (weekday vs weekend use)
+        rtc_energy.mah_per_day = rtc_energy.mah_per_day * (1.0f - ENERGY_ROLLING_WEIGHT) +
+                                 day_mah * ENERGY_ROLLING_WEIGHT;
+    }
+
+    memset(rtc_energy.time_us, 0, sizeof(rtc_energy.time_us));
+    rtc_energy.window_us = 0;
+    taskEXIT_CRITICAL(&g_mux);
+
+    Serial.printf("Energy: day closed at %.2f mAh, rolling %.2f mAh/day\n",
+                  day_mah, rtc_energy.mah_per_day);
+}
+
+void energyLedgerInit() {
+    if (rtc_energy.magic != RTC_MAGIC_ENERGY) {
+        memset(&rtc_energy, 0, sizeof(rtc_energy));
+        rtc_energy.magic = RTC_MAGIC_ENERGY;
+        Serial.println("Energy: ledger reset (power cycle)");
+    }
+
+    // Account the deep sleep that just ended (includes wake-stub handled wakes)
+    if (rtc_energy.sleep_pending) {
+        int64_t slept_us = wallClockUs() - rtc_energy.sleep_start_us;
+        if (slept_us > 0 && (uint64_t)slept_us < ENERGY_MAX_SLEEP_US) {
+            // Single task this early in setup() - no lock needed
+            addBaseTime(rtc_energy.sleep_extended ? ENERGY_STATE_SLEEP_EXTENDED
+                                                  : ENERGY_STATE_SLEEP_NORMAL,
+                        (uint64_t)slept_us);
+        }
+        rtc_energy.sleep_pending = false;
+        rollWindow();
+    }
+
+    // Time since reset (ROM, bootloader, setup so far) is counted as awake idle
+    g_last_tick_us = 0;
+}
+
+void energyLedgerTick(EnergyState state) {
+    if (state >= ENERGY_STATE_COUNT) {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    taskENTER_CRITICAL(&g_mux);
+    addBaseTime(state, (uint64_t)(now - g_last_tick_us));
+    taskEXIT_CRITICAL(&g_mux);
+    g_last_tick_us = now;
+
+    rollWindow();
+}
+
+void energyLedgerAddOverlay(EnergyOverlay overlay, uint32_t duration_us) {
+    if (overlay >= ENERGY_OVERLAY_COUNT) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&g_mux);
+    rtc_energy.time_us[ENERGY_STATE_COUNT + overlay] += duration_us;
+    taskEXIT_CRITICAL(&g_mux);
+}
+
+void energyLedgerEnterSleep(bool extended) {
+    energyLedgerTick(ENERGY_STATE_AWAKE_IDLE);  // Tail since the last loop
+
+    rtc_energy.sleep_start_us = wallClockUs();
+    rtc_energy.sleep_extended = extended;
+    rtc_energy.sleep_pending = true;
+}
+
+void energyLedgerGetSummary(uint8_t battery_percent, EnergySummary& out) {
+    taskENTER_CRITICAL(&g_mux);
+    EnergyLedgerRtc snap = rtc_energy;
+    taskEXIT_CRITICAL(&g_mux);
+
+    for (uint8_t i = 0; i < ENERGY_BUCKET_COUNT; i++) {
+        out.time_sec[i] = (uint32_t)(snap.time_us[i] / 1000000ULL);
+        out.charge_uah[i] = (uint32_t)((double)snap.time_us[i] * BUCKET_CURRENT_UA[i] / 3600e6);
+    }
+    out.window_sec = (uint32_t)(snap.window_us / 1000000ULL);
+    out.estimate_complete = (snap.mah_per_day > 0.0f);
+
+    if (out.estimate_complete) {
+        out.mah_per_day = snap.mah_per_day;
+    } else if (snap.window_us > 0) {
+        // First day: extrapolate the partial window
+        out.mah_per_day = windowChargeMah(snap) * (float)((double)ENERGY_WINDOW_US / snap.window_us);
+    } else {
+        out.mah_per_day = 0.0f;
+    }
+
+    float remaining_mah = BATTERY_CAPACITY_MAH * battery_percent / 100.0f;
+    out.days_remaining = (out.mah_per_day > 0.0f) ? remaining_mah / out.mah_per_day : 0.0f;
+}
+
+void energyLedgerPrint(uint8_t battery_percent) {
+    EnergySummary summary;
+    energyLedgerGetSummary(battery_percent, summary);
+
+    Serial.println("\n=== ENERGY LEDGER ===");
+    Serial.printf("Estimate: %.2f mAh/day (%s)\n", summary.mah_per_day,
+                  summary.estimate_complete ? "rolling" : "first day, extrapolated");
+    Serial.printf("Battery: %d%% of %dmAh -> %.1f days remaining\n",
+                  battery_percent, BATTERY_CAPACITY_MAH, summary.days_remaining);
+    Serial.printf("Current window: %.2f h\n", summary.window_sec / 3600.0f);
+    Serial.println("  bucket              time(s)   charge(uAh)");
+    for (uint8_t i = 0; i < ENERGY_BUCKET_COUNT; i++) {
+        Serial.printf("  %-16s %10lu  %10lu\n", BUCKET_NAMES[i],
+                      (unsigned long)summary.time_sec[i], (unsigned long)summary.charge_uah[i]);
+    }
+    Serial.println("=====================\n");
+}
+
+#endif // ENABLE_ENERGY_LEDGER
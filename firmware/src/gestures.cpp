@@ -129,6 +129,14 @@ GestureType gesturesUpdate(float weight_ml) {
     // Read accelerometer
     int16_t x, y, z;
     g_adxl->getXYZ(x, y, z);
+    return gesturesUpdateFromSample(x, y, z, weight_ml);
+}
+
+GestureType gesturesUpdateFromSample(int16_t x, int16_t y, int16_t z, float weight_ml) {
+    if (!g_initialized) {
+        return GESTURE_NONE;
+    }
+
     g_current_x = rawToGs(x);
     g_current_y = rawToGs(y);
     g_current_z = rawToGs(z);
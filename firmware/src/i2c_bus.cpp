@@ -0,0 +1,299 @@
+// i2c_bus.cpp - Asynchronous I2C bus manager
+// Part of the Aquavate smart water bottle firmware
+//
+// Wire (arduino-esp32 2.x) installs the legacy ESP-IDF I2C driver on I2C_NUM_0.
+// The worker task issues its own command links on the same port; the driver's
+// per-port mutex serialises them against any Wire traffic from other code.
+
+#include "i2c_bus.h"
+#include "power_mgmt.h"
+#include <Wire.h>
+#include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+// External debug flag from main.cpp
+extern bool g_debug_accelerometer;
+
+#define I2C_BUS_PORT            I2C_NUM_0   // Wire
+#define I2C_BUS_TASK_STACK      3072
+
+// One bus operation after merging (a read burst or a write)
+struct I2CBurst {
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t len;
+    bool is_write;
+    uint8_t first_segment;
+    uint8_t segment_count;
+    uint8_t buf[I2C_BUS_MAX_BURST];
+};
+
+static QueueHandle_t g_queue = nullptr;
+static TaskHandle_t g_task = nullptr;
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+static I2CBusStats g_stats = {};
+
+// Worker-only scratch (no allocation per transaction)
+static I2CBurst g_bursts[I2C_BUS_MAX_SEGMENTS];
+static uint8_t g_cmd_buf[I2C_LINK_RECOMMENDED_SIZE(I2C_BUS_MAX_SEGMENTS * 2)];
+
+// Fold segments into bursts: consecutive reads from one device whose register
+// ranges are contiguous (or nearly) become a single auto-increment read.
+static uint8_t i2cBusPlan(const I2CTransaction& txn) {
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < txn.segment_count; i++) {
+        const I2CSegment& seg = txn.segments[i];
+
+        if (count > 0 && !seg.is_write) {
+            I2CBurst& prev = g_bursts[count - 1];
+            uint16_t prev_end = prev.reg + prev.len;
+            uint16_t new_len = (uint16_t)seg.reg + seg.len - prev.reg;
+
+            if (!prev.is_write && prev.addr == seg.addr &&
+                seg.reg >= prev_end && seg.reg - prev_end <= I2C_BUS_MERGE_GAP &&
+                new_len <= I2C_BUS_MAX_BURST) {
+                prev.len = new_len;
+                prev.segment_count++;
+                g_stats.merged_segments++;
+                continue;
+            }
+        }
+
+        I2CBurst& burst = g_bursts[count++];
+        burst.addr = seg.addr;
+        burst.reg = seg.reg;
+        burst.len = seg.len;
+        burst.is_write = seg.is_write;
+        burst.first_segment = i;
+        burst.segment_count = 1;
+        if (seg.is_write) {
+            memcpy(burst.buf, seg.data, seg.len);
+        }
+    }
+
+    return count;
+}
+
+static esp_err_t i2cBusExecute(I2CTransaction& txn) {
+    uint8_t burst_count = i2cBusPlan(txn);
+    if (burst_count == 0) {
+        return ESP_OK;
+    }
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(g_cmd_buf, sizeof(g_cmd_buf));
+    if (cmd == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = ESP_OK;
+    for (uint8_t b = 0; b < burst_count && err == ESP_OK; b++) {
+        I2CBurst& burst = g_bursts[b];
+
+        // Repeated start between bursts - one STOP at the end of the link
+        err = i2c_master_start(cmd);
+        if (err == ESP_OK) err = i2c_master_write_byte(cmd, (burst.addr << 1) | I2C_MASTER_WRITE, true);
+        if (err == ESP_OK) err = i2c_master_write_byte(cmd, burst.reg, true);
+
+        if (burst.is_write) {
+            if (err == ESP_OK) err = i2c_master_write(cmd, burst.buf, burst.len, true);
+        } else {
+            if (err == ESP_OK) err = i2c_master_start(cmd);
+            if (err == ESP_OK) err = i2c_master_write_byte(cmd, (burst.addr << 1) | I2C_MASTER_READ, true);
+            if (err == ESP_OK) err = i2c_master_read(cmd, burst.buf, burst.len, I2C_MASTER_LAST_NACK);
+        }
+    }
+    if (err == ESP_OK) err = i2c_master_stop(cmd);
+
+    if (err == ESP_OK) {
+        PowerLockGuard lock(POWER_LOCK_I2C);
+        uint32_t start_us = micros();
+        err = i2c_master_cmd_begin(I2C_BUS_PORT, cmd, pdMS_TO_TICKS(I2C_BUS_TIMEOUT_MS));
+        g_stats.bus_time_us += micros() - start_us;
+    }
+    i2c_cmd_link_delete_static(cmd);
+
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // Scatter burst data back into the caller's segment buffers
+    for (uint8_t b = 0; b < burst_count; b++) {
+        const I2CBurst& burst = g_bursts[b];
+        if (burst.is_write) {
+            continue;
+        }
+        for (uint8_t s = 0; s < burst.segment_count; s++) {
+            I2CSegment& seg = txn.segments[burst.first_segment + s];
+            memcpy(seg.data, &burst.buf[seg.reg - burst.reg], seg.len);
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void i2cBusTask(void* param) {
+    (void)param;
+    I2CTransaction* txn = nullptr;
+
+    for (;;) {
+        if (xQueueReceive(g_queue, &txn, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        esp_err_t err = i2cBusExecute(*txn);
+        txn->result = err;
+        g_stats.transactions++;
+        if (err != ESP_OK) {
+            g_stats.errors++;
+            DEBUG_PRINTF(g_debug_accelerometer, "I2C bus: transaction failed (%s)\n", esp_err_to_name(err));
+        }
+
+        // Callback sees the results before done is published
+        if (txn->callback) {
+            txn->callback(*txn, txn->ctx);
+        }
+
+        TaskHandle_t waiter;
+        taskENTER_CRITICAL(&g_mux);
+        txn->done = true;
+        waiter = (TaskHandle_t)txn->waiter;
+        txn->waiter = nullptr;
+        taskEXIT_CRITICAL(&g_mux);
+
+        if (waiter) {
+            xTaskNotifyGive(waiter);
+        }
+    }
+}
+
+bool i2cBusInit() {
+    if (g_task) {
+        return true;
+    }
+
+    Wire.setClock(I2C_BUS_CLOCK_HZ);
+
+    g_queue = xQueueCreate(I2C_BUS_QUEUE_DEPTH, sizeof(I2CTransaction*));
+    if (g_queue == nullptr) {
+        Serial.println("ERROR: I2C bus queue allocation failed");
+        return false;
+    }
+
+    if (xTaskCreate(i2cBusTask, "i2c_bus", I2C_BUS_TASK_STACK, nullptr,
+                    I2C_BUS_TASK_PRIORITY, &g_task) != pdPASS) {
+        Serial.println("ERROR: I2C bus worker task creation failed");
+        vQueueDelete(g_queue);
+        g_queue = nullptr;
+        g_task = nullptr;
+        return false;
+    }
+
+    DEBUG_PRINTF(g_debug_accelerometer, "I2C bus: %lu Hz, worker started\n", (unsigned long)I2C_BUS_CLOCK_HZ);
+    return true;
+}
+
+bool i2cBusIsReady() {
+    return g_task != nullptr;
+}
+
+void i2cBusTransactionInit(I2CTransaction& txn, I2CBusCallback callback, void* ctx) {
+    txn.segment_count = 0;
+    txn.callback = callback;
+    txn.ctx = ctx;
+    txn.done = false;
+    txn.result = ESP_OK;
+    txn.waiter = nullptr;
+}
+
+static bool i2cBusAddSegment(I2CTransaction& txn, uint8_t addr, uint8_t reg,
+                             uint8_t* buf, uint8_t len, bool is_write) {
+    if (txn.segment_count >= I2C_BUS_MAX_SEGMENTS || len == 0 || len > I2C_BUS_MAX_BURST) {
+        return false;
+    }
+
+    I2CSegment& seg = txn.segments[txn.segment_count++];
+    seg.addr = addr;
+    seg.reg = reg;
+    seg.len = len;
+    seg.is_write = is_write;
+    seg.data = buf;
+    return true;
+}
+
+bool i2cBusAddRead(I2CTransaction& txn, uint8_t addr, uint8_t reg, uint8_t* buf, uint8_t len) {
+    return i2cBusAddSegment(txn, addr, reg, buf, len, false);
+}
+
+bool i2cBusAddWrite(I2CTransaction& txn, uint8_t addr, uint8_t reg, uint8_t* buf, uint8_t len) {
+    return i2cBusAddSegment(txn, addr, reg, buf, len, true);
+}
+
+bool i2cBusSubmit(I2CTransaction& txn) {
+    if (!g_queue) {
+        return false;
+    }
+
+    txn.done = false;
+    txn.result = ESP_FAIL;
+    txn.waiter = nullptr;
+
+    I2CTransaction* ptr = &txn;
+    if (xQueueSend(g_queue, &ptr, 0) != pdTRUE) {
+        g_stats.queue_full++;
+        txn.done = true;
+        return false;
+    }
+    return true;
+}
+
+bool i2cBusWait(I2CTransaction& txn, uint32_t timeout_ms) {
+    // Drop a notification left by an earlier transaction that completed after
+    // its wait had timed out - it must not end this wait
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    taskENTER_CRITICAL(&g_mux);
+    bool done = txn.done;
+    if (!done) {
+        txn.waiter = xTaskGetCurrentTaskHandle();
+    }
+    taskEXIT_CRITICAL(&g_mux);
+
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    while (!done) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+
+        // Only this transaction's done flag counts, not the notification itself
+        taskENTER_CRITICAL(&g_mux);
+        done = txn.done;
+        taskEXIT_CRITICAL(&g_mux);
+    }
+
+    if (!done) {
+        // On timeout, make sure the worker will not notify us later
+        taskENTER_CRITICAL(&g_mux);
+        done = txn.done;
+        txn.waiter = nullptr;
+        taskEXIT_CRITICAL(&g_mux);
+    }
+
+    return done && txn.result == ESP_OK;
+}
+
+bool i2cBusTransfer(I2CTransaction& txn, uint32_t timeout_ms) {
+    if (!i2cBusSubmit(txn)) {
+        return false;
+    }
+    return i2cBusWait(txn, timeout_ms);
+}
+
+I2CBusStats i2cBusGetStats() {
+    return g_stats;
+}
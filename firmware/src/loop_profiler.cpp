@@ -0,0 +1,135 @@
+// loop_profiler.cpp - loop() stage timing and period jitter profiler
+// Part of the Aquavate smart water bottle firmware
+
+#include "loop_profiler.h"
+
+#if ENABLE_LOOP_PROFILER
+
+// Execution time statistics for one stage (or the loop period / jitter)
+struct LoopTimingStats {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t hist[LOOP_PROFILE_BUCKETS];    // Bucket n: 2^n..2^(n+1)-1 us (last is open-ended)
+};
+
+static LoopTimingStats g_stages[LOOP_STAGE_COUNT];
+static LoopTimingStats g_period;
+static LoopTimingStats g_jitter;            // |period - SENSOR_TASK_INTERVAL_MS|
+static uint32_t g_last_tick_us = 0;
+static bool g_have_tick = false;
+static uint32_t g_since_us = 0;             // Start of the profiled span
+
+static const char* const STAGE_NAMES[LOOP_STAGE_COUNT] = {
+    "sample_wait",
+    "body",
+    "serial",
+    "ble",
+    "gestures",
+    "drinks",
+    "display",
+    "unsynced_count",
+    "debug_print",
+};
+
+static uint8_t bucketFor(uint32_t us) {
+    uint8_t bucket = 0;
+    while (us > 1 && bucket < LOOP_PROFILE_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void addSample(LoopTimingStats& stats, uint32_t us) {
+    if (stats.count == 0 || us < stats.min_us) stats.min_us = us;
+    if (us > stats.max_us) stats.max_us = us;
+    stats.count++;
+    stats.total_us += us;
+    stats.hist[bucketFor(us)]++;
+}
+
+void loopProfilerLoopTick() {
+    uint32_t now = micros();
+    if (g_have_tick) {
+        uint32_t period = now - g_last_tick_us;
+        uint32_t nominal = SENSOR_TASK_INTERVAL_MS * 1000UL;
+        addSample(g_period, period);
+        addSample(g_jitter, period > nominal ? period - nominal : nominal - period);
+    } else {
+        g_since_us = now;
+        g_have_tick = true;
+    }
+    g_last_tick_us = now;
+}
+
+void loopProfilerRecord(LoopStage stage, uint32_t duration_us) {
+    if (stage < LOOP_STAGE_COUNT) {
+        addSample(g_stages[stage], duration_us);
+    }
+}
+
+void loopProfilerReset() {
+    memset(g_stages, 0, sizeof(g_stages));
+    memset(&g_period, 0, sizeof(g_period));
+    memset(&g_jitter, 0, sizeof(g_jitter));
+    g_have_tick = false;
+}
+
+static void printStatsRow(const char* name, const LoopTimingStats& stats, uint32_t span_us) {
+    if (stats.count == 0) {
+        Serial.printf("  %-15s %7s\n", name, "-");
+        return;
+    }
+    Serial.printf("  %-15s %7lu %8lu %8lu %8lu %9.1f %6.2f\n", name,
+                  (unsigned long)stats.count, (unsigned long)stats.min_us,
+                  (unsigned long)(stats.total_us / stats.count), (unsigned long)stats.max_us,
+                  stats.total_us / 1000.0f,
+                  span_us ? stats.total_us * 100.0f / span_us : 0.0f);
+}
+
+static void printHistogram(const char* name, const LoopTimingStats& stats) {
+    if (stats.count == 0) {
+        return;
+    }
+    Serial.printf("  %-15s", name);
+    for (uint8_t b = 0; b < LOOP_PROFILE_BUCKETS; b++) {
+        if (stats.hist[b] == 0) {
+            continue;
+        }
+        if (b == LOOP_PROFILE_BUCKETS - 1) {
+            Serial.printf(" >=%lu:%lu", 1UL << b, (unsigned long)stats.hist[b]);
+        } else {
+            Serial.printf(" %lu-%lu:%lu", b ? (1UL << b) : 0UL, (2UL << b) - 1,
+                          (unsigned long)stats.hist[b]);
+        }
+    }
+    Serial.println();
+}
+
+void loopProfilerPrint() {
+    uint32_t span_us = g_have_tick ? micros() - g_since_us : 0;
+
+    Serial.printf("\n=== LOOP PROFILE (%.1fs, %lu loops) ===\n", span_us / 1e6f,
+                  (unsigned long)g_period.count);
+    Serial.println("Stage times in us (inclusive - body contains the others)");
+    Serial.println("  stage             count      min      avg      max  total(ms)  %span");
+    for (uint8_t s = 0; s < LOOP_STAGE_COUNT; s++) {
+        printStatsRow(STAGE_NAMES[s], g_stages[s], span_us);
+    }
+
+    Serial.printf("\nLoop period (nominal %dms)\n", SENSOR_TASK_INTERVAL_MS);
+    printStatsRow("period", g_period, 0);
+    printStatsRow("jitter", g_jitter, 0);
+
+    Serial.println("\nHistograms (us range:count)");
+    for (uint8_t s = 0; s < LOOP_STAGE_COUNT; s++) {
+        printHistogram(STAGE_NAMES[s], g_stages[s]);
+    }
+    printHistogram("period", g_period);
+    printHistogram("jitter", g_jitter);
+    Serial.println("====================================\n");
+}
+
+#endif // ENABLE_LOOP_PROFILER
@@ -13,6 +13,9 @@
 // Calibration system includes
 #include "gestures.h"
 #include "weight.h"
+#include "i2c_bus.h"
+#include "sensor_sampler.h"
+#include "app_tasks.h"
 #include "storage.h"
 #include "calibration.h"
 #include "ui_calibration.h"  // Always include - has uiShowBottleEmptied for shake-to-empty
@@ -35,16 +38,48 @@
 // Activity stats tracking
 #include "activity_stats.h"
 
+// Deep-sleep wake stub (backpack-mode timer wakes handled without booting)
+#include "wake_stub.h"
+
+// Placement wake for normal sleep (ADXL343 link mode)
+#include "placement_wake.h"
+
+// Boot/wake phase profiler
+#include "boot_profile.h"
+
+// Awake-mode power management (DFS, light sleep, PM locks)
+#include "power_mgmt.h"
+
 // BLE service (conditional)
 #if ENABLE_BLE
 #include "ble_service.h"
 #endif
 
+// Sensor trace recorder (conditional)
+#if ENABLE_TRACE_RECORDER
+#include "trace_recorder.h"
+#endif
+
+// Per-power-state energy accounting (conditional)
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
+
+// Learned usage-pattern sleep scheduler (conditional)
+#if ENABLE_SLEEP_SCHEDULER
+#include "sleep_scheduler.h"
+#endif
+
+#include "loop_profiler.h"  // Probes compile out when ENABLE_LOOP_PROFILER is 0
+#include "ui_sequence.h"
+#include "device_context.h"
+
 
 // FIX Bug #4: Sensor snapshot to prevent multiple reads per loop
 struct SensorSnapshot {
     uint32_t timestamp;
     int32_t adc_reading;
+    bool adc_fresh;         // New NAU7802 sample this loop
     float water_ml;
     GestureType gesture;
 };
@@ -55,6 +90,14 @@ RTC_DS3231 rtc;  // DS3231 external RTC
 bool nauReady = false;
 bool adxlReady = false;
 
+// NAU7802 bring-up runs in parallel with the rest of setup()
+static TaskHandle_t g_nau_boot_task = nullptr;
+static TaskHandle_t g_nau_boot_waiter = nullptr;
+static bool g_nau_boot_done = false;        // Task is about to publish (guarded by g_nau_boot_mux)
+static bool g_nau_boot_cancelled = false;   // Join timed out - task must not publish
+static portMUX_TYPE g_nau_boot_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool g_first_weight_logged = false;
+
 unsigned long wakeTime = 0;
 
 // Extended deep sleep tracking (Plan 034: renamed for clarity)
@@ -79,6 +122,8 @@ RTC_DATA_ATTR uint8_t rtc_low_battery_threshold = LOW_BATTERY_LOCKOUT_PCT_DEFAUL
 // Sync timeout tracking - regular variable, set at wake time
 // Only extend timeout if NEW drinks recorded during this wake session
 uint16_t g_unsynced_at_wake = 0;
+bool g_sync_window_wake = false;    // Timer wake aimed at the phone's usual sync hour
+bool g_sync_window_held = false;    // Sync window (extended timeout) applied this wake
 
 // Magic number for validating RTC memory after deep sleep
 #define RTC_EXTENDED_SLEEP_MAGIC 0x45585400  // "EXT\0" in ASCII
@@ -121,26 +166,39 @@ uint8_t g_daily_intake_display_mode = DAILY_INTAKE_DISPLAY_MODE;
 // Runtime activity timeout control (0 = disabled, non-persistent)
 uint32_t g_sleep_timeout_ms = ACTIVITY_TIMEOUT_MS;  // Default 30 seconds
 
-#if defined(BOARD_ADAFRUIT_FEATHER)
-#include "Adafruit_ThinkInk.h"
-
-// 2.13" Mono E-Paper display (GDEY0213B74 variant - no 8-pixel shift)
-ThinkInk_213_Mono_GDEY0213B74 display(EPD_DC, EPD_RESET, EPD_CS, SRAM_CS, EPD_BUSY);
+// Activity timeout in effect: the sync window while records wait for the phone,
+// otherwise g_sleep_timeout_ms - both adjusted for the hour when learned
+static uint32_t getActivityTimeoutMs(bool sync_window) {
+#if ENABLE_SLEEP_SCHEDULER
+    return sync_window ? sleepSchedulerSyncTimeoutMs(ACTIVITY_TIMEOUT_EXTENDED_MS)
+                       : sleepSchedulerActivityTimeoutMs(g_sleep_timeout_ms);
+#else
+    return sync_window ? ACTIVITY_TIMEOUT_EXTENDED_MS : g_sleep_timeout_ms;
+#endif
+}
 
-float getBatteryVoltage() {
-    float voltage = analogReadMilliVolts(VBAT_PIN);
-    voltage *= 2;     // Voltage divider, multiply back
-    voltage /= 1000;  // Convert to volts
-    return voltage;
+// Backpack-mode (time since stable) threshold in effect
+static uint32_t getBackpackThresholdSec() {
+#if ENABLE_SLEEP_SCHEDULER
+    return sleepSchedulerBackpackThresholdSec(g_time_since_stable_threshold_sec);
+#else
+    return g_time_since_stable_threshold_sec;
+#endif
 }
 
-int getBatteryPercent(float voltage) {
-    // LiPo: BATTERY_VOLTAGE_FULL = 100%, BATTERY_VOLTAGE_EMPTY = 0%
-    int percent = (voltage - BATTERY_VOLTAGE_EMPTY) / (BATTERY_VOLTAGE_FULL - BATTERY_VOLTAGE_EMPTY) * 100;
-    if (percent > 100) percent = 100;
-    if (percent < 0) percent = 0;
-    return percent;
+#if ENABLE_BLE
+// Unsynced drink record count (walks the record file - timed as its own loop stage)
+static uint16_t getUnsyncedCount() {
+    LOOP_PROFILE_SCOPE(LOOP_STAGE_UNSYNCED_COUNT);
+    return storageGetUnsyncedCount();
 }
+#endif
+
+#if defined(BOARD_ADAFRUIT_FEATHER)
+#include "Adafruit_ThinkInk.h"
+
+// 2.13" Mono E-Paper display (GDEY0213B74 variant - no 8-pixel shift)
+AquavateDisplay display(EPD_DC, EPD_RESET, EPD_CS, EPD_FRAMEBUFFER_SRAM_CS, EPD_BUSY);
 
 // Drawing helper functions moved to display.cpp
 #endif
@@ -386,6 +444,26 @@ void configureADXL343TapWake() {
                   TAP_WAKE_THRESHOLD * 0.0625f);
 }
 
+#if ENABLE_PLACEMENT_WAKE
+// Configure ADXL343 to wake on placement (normal sleep wake)
+// Link mode serialises the detectors: after activity (bottle picked up) the chip
+// looks for inactivity, which only fires once X and Z stay below the threshold for
+// PLACEMENT_INACT_TIME - i.e. the bottle is back upright and still. Activity is
+// routed to the unconnected INT2 so carrying the bottle around never wakes the CPU.
+// Arming takes up to PLACEMENT_ARM_TIMEOUT_MS (see placement_wake.h).
+void configureADXL343PlacementWake() {
+    // Set interrupt pin mode
+    pinMode(PIN_ACCEL_INT, INPUT_PULLDOWN);  // Active-high interrupt
+
+    bool armed = placementWakeArm();
+
+    // Unconditional one-line summary
+    Serial.printf("ADXL343: Placement wake configured (upright <%.2fg X/Z for %ds after motion)%s\n",
+                  PLACEMENT_INACT_THRESHOLD * 0.0625f, PLACEMENT_INACT_TIME,
+                  armed ? "" : " - not still yet, wakes on next placement");
+}
+#endif
+
 // Save extended sleep state to RTC memory
 void extendedSleepSaveToRTC() {
     rtc_extended_sleep_magic = RTC_EXTENDED_SLEEP_MAGIC;
@@ -424,12 +502,15 @@ void enterExtendedDeepSleep() {
     // Only show backpack mode screen on first entry
     if (!rtc_backpack_screen_shown) {
         Serial.println("Displaying Backpack Mode screen...");
+        uiSequenceCancel();  // Backpack Mode screen replaces any held info screen
         displayBackpackMode();
         rtc_backpack_screen_shown = true;
-        delay(1000);  // Brief pause to ensure display updates
     } else {
         Serial.println("Backpack Mode screen already shown - skipping display refresh");
+        uiSequenceFinish();
     }
+#else
+    uiSequenceFinish();  // Don't sleep with a held info screen up
 #endif
 
     // Stop BLE advertising before sleep (Plan 034: awake = advertising, asleep = not)
@@ -439,22 +520,36 @@ void enterExtendedDeepSleep() {
 
     // Record entering extended sleep for activity tracking
     activityStatsRecordExtendedSleep();
+#if ENABLE_SLEEP_SCHEDULER
+    sleepSchedulerRecordSleep(g_sync_window_held);
+#endif
 
     // Save state to RTC memory before sleeping
+    bootProfileCommit();
     displaySaveToRTC();
     drinksSaveToRTC();
     extendedSleepSaveToRTC();
     activityStatsSaveToRTC();
+#if ENABLE_TRACE_RECORDER
+    traceRecorderFlush();
+#endif
 
     // Configure for tap wake (replaces timer wake for battery efficiency)
     configureADXL343TapWake();
     rtc_tap_wake_enabled = true;
 
     // Add periodic health-check timer (ESP32 supports multiple wake sources)
-    uint64_t timer_us = (uint64_t)HEALTH_CHECK_WAKE_INTERVAL_SEC * 1000000ULL;
+    uint32_t timer_sec = HEALTH_CHECK_WAKE_INTERVAL_SEC;
+    bool sync_wake = false;
+#if ENABLE_SLEEP_SCHEDULER && ENABLE_BLE
+    // Records waiting: wake at the phone's usual sync hour instead, if it comes first
+    sync_wake = sleepSchedulerPlanExtendedWake(HEALTH_CHECK_WAKE_INTERVAL_SEC,
+                                               storageGetUnsyncedCount() > 0, timer_sec);
+#endif
+    uint64_t timer_us = (uint64_t)timer_sec * 1000000ULL;
     esp_sleep_enable_timer_wakeup(timer_us);
     rtc_health_check_wake = true;
-    Serial.printf("Health-check timer set: %d seconds\n", HEALTH_CHECK_WAKE_INTERVAL_SEC);
+    Serial.printf("Health-check timer set: %lu seconds\n", (unsigned long)timer_sec);
 
     Serial.println("Entering extended sleep - wake on double-tap or health-check timer");
     Serial.flush();
@@ -462,6 +557,17 @@ void enterExtendedDeepSleep() {
     // Configure tap interrupt as wake source (alongside timer)
     esp_sleep_enable_ext0_wakeup((gpio_num_t)PIN_ACCEL_INT, 1);  // Wake on HIGH
 
+    // Routine health-check wakes go straight back to sleep from the wake stub
+    // (a sync-window wake has to boot and advertise)
+    if (!sync_wake) {
+        wakeStubArm(HEALTH_CHECK_WAKE_INTERVAL_SEC, getSecondsUntilRollover());
+    }
+    Serial.flush();
+
+#if ENABLE_ENERGY_LEDGER
+    energyLedgerEnterSleep(true);
+#endif
+
     // Enter deep sleep
     esp_deep_sleep_start();
 }
@@ -471,13 +577,34 @@ void enterDeepSleep() {
 
     // Record entering normal sleep for activity tracking
     activityStatsRecordNormalSleep();
+#if ENABLE_SLEEP_SCHEDULER
+    sleepSchedulerRecordSleep(g_sync_window_held);
+#endif
+
+    // A held info screen gets its main-screen step now, and main-screen
+    // changes held this wake get their one refresh
+    uiSequenceFinish();
+    displayFlushDeferred();
 
     // Save state to RTC memory before sleeping
+    bootProfileCommit();
     displaySaveToRTC();
     drinksSaveToRTC();
     extendedSleepSaveToRTC();
     activityStatsSaveToRTC();
+#if ENABLE_TRACE_RECORDER
+    traceRecorderFlush();
+#endif
 
+#if ENABLE_PLACEMENT_WAKE
+    // Wake only when the bottle is next set down upright and still
+    if (adxlReady) {
+        configureADXL343PlacementWake();
+        if (digitalRead(PIN_ACCEL_INT) == HIGH) {
+            Serial.println("  WARNING: INT pin still HIGH - may wake immediately!");
+        }
+    }
+#else
     // CRITICAL FIX: Ensure ADXL343 interrupt is cleared before sleeping
     // Wait for bottle to return upright (|Y| > 0.81g) so interrupt clears
     if (adxlReady) {
@@ -509,11 +636,12 @@ void enterDeepSleep() {
             Serial.println("  WARNING: INT pin still HIGH - may not wake properly!");
         }
     }
+#endif
 
     Serial.flush();
 
     // Configure wake-up interrupt from ADXL343 INT1 pin
-    // Wake on HIGH level (interrupt pin goes HIGH when tilted)
+    // Wake on HIGH level (tilt, or placement when ENABLE_PLACEMENT_WAKE)
     esp_sleep_enable_ext0_wakeup((gpio_num_t)PIN_ACCEL_INT, 1);
 
     // Configure timer wake: use minimum of rollover time and health-check interval
@@ -537,6 +665,10 @@ void enterDeepSleep() {
     Serial.printf("Sleep timer set: %lu seconds (%s)\n", timer_seconds,
                   rtc_health_check_wake ? "health check" : "rollover");
 
+#if ENABLE_ENERGY_LEDGER
+    energyLedgerEnterSleep(false);
+#endif
+
     // Enter deep sleep
     esp_deep_sleep_start();
 }
@@ -567,11 +699,8 @@ void formatTimeForDisplay(char* buffer, size_t buffer_size) {
         return;
     }
 
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
     struct tm timeinfo;
-    gmtime_r(&now, &timeinfo);
+    deviceContextLocalTime(timeinfo);
 
     const char* day_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "---"};
     const char* day = (timeinfo.tm_wday >= 0 && timeinfo.tm_wday <=  6) ?
@@ -603,7 +732,7 @@ void drawWelcomeScreen() {
     display.drawBitmap(drop_x, drop_y, water_drop_bitmap,
                       WATER_DROP_WIDTH, WATER_DROP_HEIGHT, EPD_BLACK);
 
-    display.display();
+    displayPushBuffer(display);
 }
 
 // Helper function to force display refresh (called by serial commands like TARE)
@@ -615,7 +744,11 @@ void forceDisplayRefresh() {
     }
 
     // Read current sensor values
-    int32_t current_adc = nau.read();
+    int32_t current_adc;
+    {
+        SensorPauseScope pause;
+        current_adc = nau.read();
+    }
     float water_ml = calibrationGetWaterWeight(current_adc, g_calibration);
 
     // Get current daily total (computed from records)
@@ -623,20 +756,10 @@ void forceDisplayRefresh() {
 
     // Get current time
     uint8_t time_hour = 0, time_minute = 0;
-    if (g_time_valid) {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-        struct tm timeinfo;
-        gmtime_r(&now, &timeinfo);
-        time_hour = timeinfo.tm_hour;
-        time_minute = timeinfo.tm_min;
-    }
+    deviceContextHourMinute(time_hour, time_minute);
 
     // Get battery percent
-    uint8_t battery_pct = 50;
-    float voltage = getBatteryVoltage();
-    battery_pct = getBatteryPercent(voltage);
+    uint8_t battery_pct = deviceContextBatteryPercent();
 
     Serial.println("Forcing display refresh...");
     displayForceUpdate(water_ml, daily_total,
@@ -645,9 +768,110 @@ void forceDisplayRefresh() {
 }
 #endif
 
+// True when USB power is present (serial console may be attached)
+static bool usbPowerPresent() {
+#ifdef PIN_VBUS
+    return analogReadMilliVolts(PIN_VBUS) > USB_VBUS_PRESENT_MV;
+#else
+    return true;  // No VBUS sense - assume attached (keeps the old behaviour)
+#endif
+}
+
+// NAU7802 reset, power-up and configuration (true on success)
+static bool nauBringUp() {
+    if (!nau.begin()) {
+        return false;
+    }
+    nau.setLDO(NAU7802_3V3);
+    nau.setGain(NAU7802_GAIN_128);
+    nau.setRate(NAU7802_RATE_10SPS);
+    return true;
+}
+
+static void nauPublishReady(bool ok) {
+    nauReady = ok;
+    if (ok) {
+        bootProfileMark(BOOT_PHASE_NAU_READY);
+    }
+}
+
+// One-shot task: the library's power-up wait dominates boot time, so run
+// nauBringUp() here and let it overlap with display/storage init. After a
+// join timeout the result is dropped - nothing published, no stray notification.
+static void nauBootTask(void* param) {
+    (void)param;
+    bool ok = nauBringUp();
+
+    taskENTER_CRITICAL(&g_nau_boot_mux);
+    bool cancelled = g_nau_boot_cancelled;
+    g_nau_boot_done = !cancelled;
+    taskEXIT_CRITICAL(&g_nau_boot_mux);
+
+    if (!cancelled) {
+        nauPublishReady(ok);
+        xTaskNotifyGive(g_nau_boot_waiter);
+    }
+    vTaskDelete(nullptr);
+}
+
+static void nauBootStart() {
+    g_nau_boot_waiter = xTaskGetCurrentTaskHandle();
+    if (xTaskCreate(nauBootTask, "nau_boot", 3072, nullptr,
+                    NAU_BOOT_TASK_PRIORITY, &g_nau_boot_task) != pdPASS) {
+        g_nau_boot_task = nullptr;  // Fall back to inline init at join
+    }
+}
+
+// Wait for the NAU7802 bring-up started by nauBootStart()
+static void nauBootJoin() {
+    if (g_nau_boot_task == nullptr) {
+        nauPublishReady(nauBringUp());  // Task creation failed - bring up inline
+    } else if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(NAU_BOOT_TIMEOUT_MS)) == 0) {
+        taskENTER_CRITICAL(&g_nau_boot_mux);
+        bool done = g_nau_boot_done;
+        g_nau_boot_cancelled = !done;
+        taskEXIT_CRITICAL(&g_nau_boot_mux);
+
+        if (done) {
+            // Finished just as we timed out - its notification is on the way
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else {
+            Serial.println("ERROR: NAU7802 bring-up timed out");
+        }
+    }
+    g_nau_boot_task = nullptr;
+    Serial.println(nauReady ? "NAU7802: OK" : "NAU7802: FAILED");
+}
+
 void setup() {
+    esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
+    bool from_deep_sleep = (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0 ||
+                            wakeup_reason == ESP_SLEEP_WAKEUP_TIMER);
+    bootProfileBegin(wakeup_reason == ESP_SLEEP_WAKEUP_EXT0 ? WAKE_REASON_MOTION :
+                     wakeup_reason == ESP_SLEEP_WAKEUP_TIMER ? WAKE_REASON_TIMER :
+                     wakeup_reason == ESP_SLEEP_WAKEUP_UNDEFINED ? WAKE_REASON_POWER_ON :
+                     WAKE_REASON_OTHER);
+
+    // Start the load cell first - it settles slowest. I2C bus comes up with it.
+    Wire.begin();
+    bool i2c_bus_async = i2cBusInit();
+    bootProfileMark(BOOT_PHASE_I2C_UP);
+    nauBootStart();
+
     Serial.begin(115200);
-    delay(1000);
+    if (!from_deep_sleep || usbPowerPresent()) {
+        delay(SERIAL_ATTACH_DELAY_MS);
+    }
+    bootProfileMark(BOOT_PHASE_SERIAL_UP);
+
+    // DFS + automatic light sleep while awake (light sleep would stall the USB console)
+    powerMgmtInit(!usbPowerPresent());
+#if ENABLE_ENERGY_LEDGER
+    energyLedgerInit();     // Accounts the deep sleep that just ended
+#endif
+    if (!i2c_bus_async) {
+        Serial.println("I2C bus: async worker unavailable - using blocking reads");
+    }
 
     wakeTime = millis();
 
@@ -656,7 +880,7 @@ void setup() {
     digitalWrite(PIN_LED, LOW);
 
     // Print wake reason with detailed diagnostics
-    esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
+    uint16_t stub_handled_wakes = wakeStubDisarm();
     Serial.println("=================================");
     switch(wakeup_reason) {
         case ESP_SLEEP_WAKEUP_EXT0:
@@ -676,6 +900,9 @@ void setup() {
             Serial.println(wakeup_reason);
             break;
     }
+    if (stub_handled_wakes > 0) {
+        Serial.printf("Wake stub handled %d timer wakes since last boot\n", stub_handled_wakes);
+    }
     Serial.println("=================================");
 
     // Handle extended sleep mode wake logic
@@ -699,6 +926,12 @@ void setup() {
     } else if (wakeup_reason == ESP_SLEEP_WAKEUP_TIMER) {
         if (rtc_health_check_wake) {
             Serial.println("Timer wake detected (health check)");
+#if ENABLE_SLEEP_SCHEDULER
+            g_sync_window_wake = sleepSchedulerTakeSyncWake();
+            if (g_sync_window_wake) {
+                Serial.println("  (aimed at the phone's usual sync hour - will advertise)");
+            }
+#endif
             // Health check: go through normal boot, will auto-sleep after inactivity timeout
             if (rtc_tap_wake_enabled) {
                 // Was in extended sleep - stay in backpack mode context
@@ -742,8 +975,8 @@ void setup() {
     }
 
     // Print battery info
-    float batteryV = getBatteryVoltage();
-    int batteryPct = getBatteryPercent(batteryV);
+    float batteryV = deviceContextBatteryVoltage();
+    int batteryPct = deviceContextBatteryPercent();
     Serial.printf("Battery: %.2fV (%d%%)\n", batteryV, batteryPct);
 
     Serial.println("E-Paper: OK");
@@ -773,6 +1006,9 @@ void setup() {
             rtc_health_check_wake = true;
             Serial.printf("Low battery sleep: %d seconds until next check\n", LOW_BATTERY_CHECK_INTERVAL_SEC);
             Serial.flush();
+#if ENABLE_ENERGY_LEDGER
+            energyLedgerEnterSleep(false);
+#endif
             esp_deep_sleep_start();
         }
     } else if (batteryPct < rtc_low_battery_threshold) {
@@ -789,21 +1025,14 @@ void setup() {
         rtc_health_check_wake = true;
         Serial.printf("Low battery sleep: %d seconds until next check\n", LOW_BATTERY_CHECK_INTERVAL_SEC);
         Serial.flush();
+#if ENABLE_ENERGY_LEDGER
+        energyLedgerEnterSleep(false);
+#endif
         esp_deep_sleep_start();
     }
 #endif
 
-    // Initialize I2C and NAU7802
-    Wire.begin();
-    if (nau.begin()) {
-        nau.setLDO(NAU7802_3V3);
-        nau.setGain(NAU7802_GAIN_128);
-        nau.setRate(NAU7802_RATE_10SPS);
-        nauReady = true;
-        Serial.println("NAU7802: OK");
-    } else {
-        Serial.println("NAU7802: FAILED");
-    }
+    // I2C (400kHz, async bus worker) and NAU7802 were started at the top of setup()
 
     // Initialize ADXL343 accelerometer
     if (adxl.begin(I2C_ADDR_ADXL343)) {
@@ -824,10 +1053,14 @@ void setup() {
             // Read INT_SOURCE to clear the interrupt (ADXL343 auto-clears, but read for diagnostics)
             uint8_t int_source = readAccelReg(0x30);  // INT_SOURCE register
             DEBUG_PRINTF(g_debug_accelerometer, "  INT_SOURCE: 0x%02X (cleared)\n", int_source);
+            if (int_source & 0x08) {
+                DEBUG_PRINTLN(g_debug_accelerometer, "  Placement wake (set down upright and still)");
+            }
         }
 
         // Configure interrupt for wake-on-tilt (or restore after tap wake)
         configureADXL343Interrupt();
+        bootProfileMark(BOOT_PHASE_ADXL_CONFIGURED);
 
         // Clear tap wake flag after restoring motion detection
         if (rtc_tap_wake_enabled) {
@@ -866,7 +1099,16 @@ void setup() {
         // Initialize LittleFS for drink record storage
         if (!storageInitDrinkFS()) {
             Serial.println("WARNING: Drink storage (LittleFS) initialization failed");
+        } else {
+            bootProfileMark(BOOT_PHASE_LITTLEFS_MOUNTED);
+        }
+
+#if ENABLE_TRACE_RECORDER
+        // Sensor trace ring shares the LittleFS partition (opt-in, off by default)
+        if (storageInitDrinkFS()) {
+            traceRecorderInit();
         }
+#endif
 
         // Load calibration from NVS
         g_calibrated = storageLoadCalibration(g_calibration);
@@ -905,6 +1147,7 @@ void setup() {
         // Load extended sleep threshold from NVS (tap-to-wake replaced timer wake)
         g_time_since_stable_threshold_sec = storageLoadExtendedSleepThreshold();
         DEBUG_PRINTF(g_debug_calibration, "Extended sleep threshold: %u seconds\n", g_time_since_stable_threshold_sec);
+        bootProfileMark(BOOT_PHASE_NVS_LOADED);
 
         if (g_time_valid) {
             // Only restore from NVS on cold boot (not wake from deep sleep)
@@ -956,11 +1199,17 @@ void setup() {
     }
 
     // Initialize weight measurement
+    nauBootJoin();
     if (nauReady) {
         weightInit(nau);
         DEBUG_PRINTLN(g_debug_calibration, "Weight measurement initialized");
     }
 
+    // Per-loop sensor reads go through the async I2C bus, driven by the
+    // sensor task; deferred flash writes go to the storage task
+    sensorSamplerInit(nauReady ? &nau : nullptr, adxlReady ? &adxl : nullptr);
+    appTasksInit();
+
     // Handle timer wake (rollover or extended sleep)
     if (wakeup_reason == ESP_SLEEP_WAKEUP_TIMER) {
         // Check if this is a rollover wake (4am daily reset)
@@ -969,12 +1218,8 @@ void setup() {
             rtc_rollover_wake_pending = false;  // Clear flag
 
             // Verify we're near 4am (within 10 minutes after rollover time)
-            if (g_time_valid) {
-                uint32_t current_time = getCurrentUnixTime();
-                time_t current_t = current_time;
-                struct tm current_tm;
-                gmtime_r(&current_t, &current_tm);
-
+            struct tm current_tm;
+            if (deviceContextLocalTime(current_tm)) {
                 // Check if within 10 minutes after 4am
                 if (current_tm.tm_hour == DRINK_DAILY_RESET_HOUR && current_tm.tm_min <= 10) {
                     is_rollover_wake = true;
@@ -1029,7 +1274,7 @@ void setup() {
         display.print("Hold bottle inverted");
         display.setCursor(10, 100);
         display.print("for 5 seconds");
-        display.display();
+        displayPushBuffer(display);
     }
 #endif
 #endif // ENABLE_STANDALONE_CALIBRATION
@@ -1038,6 +1283,7 @@ void setup() {
     if (g_time_valid) {
         drinksInit();
         DEBUG_PRINTLN(g_debug_drink_tracking, "Drink tracking system initialized");
+        bootProfileMark(BOOT_PHASE_DRINKS_INIT);
 
         // Dump buffer metadata for diagnostics
         CircularBufferMetadata meta;
@@ -1053,6 +1299,45 @@ void setup() {
         Serial.println("WARNING: Drink tracking not initialized - time not set");
     }
 
+    // Initialize NVS (required by ESP-IDF BLE)
+    // BLE comes up before the display module restores so advertising (NimBLE
+    // host task) runs while the rest of setup() finishes
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        Serial.println("NVS: Erasing and reinitializing...");
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+
+    // Initialize BLE service (conditional)
+#if ENABLE_BLE
+    bool ble_ready = bleInit();
+    if (ble_ready) {
+        // Start advertising on motion wake (not timer wake)
+        if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0) {
+            Serial.println("BLE initialized (advertising)");
+            bleStartAdvertising();
+        } else if (wakeup_reason == ESP_SLEEP_WAKEUP_UNDEFINED) {
+            Serial.println("BLE initialized (advertising)");
+            bleStartAdvertising();
+        } else if (g_sync_window_wake) {
+            Serial.println("BLE initialized (advertising - sync window wake)");
+            bleStartAdvertising();
+        } else {
+            Serial.println("BLE initialized (not advertising - timer wake)");
+        }
+        bootProfileMark(BOOT_PHASE_BLE_ADVERTISING);
+    } else {
+        Serial.println("BLE: FAILED");
+    }
+
+    // Snapshot unsynced count at wake time
+    // Only extend timeout if NEW drinks recorded during this wake session
+    g_unsynced_at_wake = storageGetUnsyncedCount();
+    Serial.printf("Unsynced records: %d\n", g_unsynced_at_wake);
+#endif
+
     // Initialize display state tracking module
 #if defined(BOARD_ADAFRUIT_FEATHER)
     displayInit(display);
@@ -1072,6 +1357,9 @@ void setup() {
     if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0 || wakeup_reason == ESP_SLEEP_WAKEUP_TIMER) {
         bool display_restored = displayRestoreFromRTC();
         bool activity_restored = activityStatsRestoreFromRTC();
+        if (activity_restored) {
+            activityStatsAddTimerWakes(stub_handled_wakes);
+        }
 
         if (display_restored && drinks_restored) {
             DEBUG_PRINTLN(g_debug_display, "State restored from RTC memory (wake from sleep)");
@@ -1099,19 +1387,10 @@ void setup() {
 
                 // Get current time
                 uint8_t hour = 0, minute = 0;
-                if (g_time_valid) {
-                    struct timeval tv;
-                    gettimeofday(&tv, NULL);
-                    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                    struct tm timeinfo;
-                    gmtime_r(&now, &timeinfo);
-                    hour = timeinfo.tm_hour;
-                    minute = timeinfo.tm_min;
-                }
+                deviceContextHourMinute(hour, minute);
 
                 // Get battery level
-                float voltage = getBatteryVoltage();
-                uint8_t battery_pct = getBatteryPercent(voltage);
+                uint8_t battery_pct = deviceContextBatteryPercent();
 
                 // Force display update with current values (not sleeping)
                 displayForceUpdate(water_ml, daily_total, hour, minute, battery_pct, false);
@@ -1134,41 +1413,21 @@ void setup() {
     // Note: Display will update on first stable check to ensure correct values shown
 #endif
 
-    // Initialize NVS (required by ESP-IDF BLE)
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        Serial.println("NVS: Erasing and reinitializing...");
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    ESP_ERROR_CHECK(ret);
-
-    // Initialize BLE service (conditional)
 #if ENABLE_BLE
-    if (bleInit()) {
-        // Sync daily goal from BLE config to display
+    // Sync daily goal from BLE config to display - after the RTC restore, so only
+    // a goal that differs from the one on screen counts as a change
+    if (ble_ready) {
         displaySetDailyGoal(bleGetDailyGoalMl());
-
-        // Start advertising on motion wake (not timer wake)
-        if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0) {
-            Serial.println("BLE initialized (advertising)");
-            bleStartAdvertising();
-        } else if (wakeup_reason == ESP_SLEEP_WAKEUP_UNDEFINED) {
-            Serial.println("BLE initialized (advertising)");
-            bleStartAdvertising();
-        } else {
-            Serial.println("BLE initialized (not advertising - timer wake)");
-        }
-    } else {
-        Serial.println("BLE: FAILED");
     }
+#endif
+    bootProfileMark(BOOT_PHASE_DISPLAY_RESTORED);
 
-    // Snapshot unsynced count at wake time
-    // Only extend timeout if NEW drinks recorded during this wake session
-    g_unsynced_at_wake = storageGetUnsyncedCount();
-    Serial.printf("Unsynced records: %d\n", g_unsynced_at_wake);
+#if ENABLE_SLEEP_SCHEDULER
+    // After activity stats - the scheduler learns from the MotionWakeEvent history
+    sleepSchedulerInit();
 #endif
 
+
     // Handle daily rollover wake (4am) - refresh display and return to sleep
     if (g_rollover_wake_pending) {
         g_rollover_wake_pending = false;
@@ -1184,18 +1443,11 @@ void setup() {
         // Get current time for display
         uint8_t time_hour = DRINK_DAILY_RESET_HOUR;
         uint8_t time_minute = 0;
-        if (g_time_valid) {
-            uint32_t current_time = getCurrentUnixTime();
-            time_t current_t = current_time;
-            struct tm current_tm;
-            gmtime_r(&current_t, &current_tm);
-            time_hour = current_tm.tm_hour;
-            time_minute = current_tm.tm_min;
-        }
+        deviceContextHourMinute(time_hour, time_minute);
 
         // Get battery level
-        float batteryV = getBatteryVoltage();
-        int batteryPct = getBatteryPercent(batteryV);
+        float batteryV = deviceContextBatteryVoltage();
+        int batteryPct = deviceContextBatteryPercent();
 
         // Get last water level from RTC state (bottle hasn't moved)
         DisplayState last_state = displayGetState();
@@ -1210,71 +1462,156 @@ void setup() {
         // Return to deep sleep immediately (no user activity, no BLE)
         Serial.println("Rollover complete - returning to sleep");
         Serial.flush();
-        delay(100);  // Ensure display update completes
         enterDeepSleep();
         // Will not return from deep sleep
     }
 
+    bootProfileMark(BOOT_PHASE_SETUP_DONE);
     Serial.printf("Setup complete! Activity timeout: %ds\n", ACTIVITY_TIMEOUT_MS / 1000);
 }
 
-void loop() {
-    // Check for serial commands (conditional)
-#if ENABLE_SERIAL_COMMANDS
-    serialCommandsUpdate();
-#endif
+// Latest calibrated water reading from loop(), for redraws run as ui_sequence steps
+static float g_loop_water_ml = 0.0f;
 
-    // Update BLE service (conditional)
-#if ENABLE_BLE
-    bleUpdate();
+#if defined(BOARD_ADAFRUIT_FEATHER)
+// Return to the main screen with current values (end of an info screen hold)
+static void showMainScreenNow() {
+    float water_ml = g_loop_water_ml;
+    if (water_ml < 0) water_ml = 0;
+    if (water_ml > 830) water_ml = 830;
 
-    // Check for BLE data activity (sync, commands) and reset activity timeout
-    // This ensures device stays awake during active BLE communication
-    // Also reset extended sleep timer so 180s threshold doesn't fire during BLE sync
-    // (Plan 067: prevents 180s backpack mode timer from firing during active BLE session)
-    if (bleCheckDataActivity()) {
-        wakeTime = millis();
-        g_time_since_stable_start = millis();
-    }
+    uint16_t daily_total = drinksGetDailyTotal();
+
+    uint8_t time_hour = 0, time_minute = 0;
+    deviceContextHourMinute(time_hour, time_minute);
+
+    uint8_t battery_pct = deviceContextBatteryPercent();
+
+    displayForceUpdate(water_ml, daily_total,
+                      time_hour, time_minute, battery_pct, false);
+}
 #endif
 
-    // Handle BLE commands (Phase 3C - conditional)
+void loop() {
+    // Wait for the next sample from the sensor task - this paces the loop
+    // (replaces the old delay(200)). If the task isn't running, sample inline.
+    loopProfilerLoopTick();
+    PublishedSample published;
+    {
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_SAMPLE_WAIT);
+        if (!appTasksWaitSample(published, SENSOR_TASK_INTERVAL_MS * 2)) {
+            if (appTasksSensorRunning()) {
+                // Sensor task late (bus stall, paused) - carry on with the previous
+                // sample marked stale so serial, BLE and the sleep timers still run
+                if (!appTasksGetLatestSample(published)) {
+                    memset(&published, 0, sizeof(published));
+                }
+                published.sample.adc_fresh = false;
+                published.sample.int_source = 0;    // Its flags were already handled
+            } else {
+                delay(SENSOR_TASK_INTERVAL_MS);
+                sensorSamplerGet(published.sample);
+                published.timestamp = millis();
+            }
+        }
+    }
+    const SensorSample& sample = published.sample;
+    LOOP_PROFILE_SCOPE(LOOP_STAGE_BODY);  // Rest of loop() - busy time per iteration
+
+    // Wake-to-first-valid-weight (boot latency of the fast resume path)
+    if (!g_first_weight_logged && sample.adc_fresh) {
+        g_first_weight_logged = true;
+        bootProfileMark(BOOT_PHASE_FIRST_WEIGHT);
+        Serial.printf("First weight sample: %lums after boot\n", (unsigned long)published.timestamp);
+    }
+    bootProfileLoopTick();
+
+#if ENABLE_ENERGY_LEDGER
+    // Charge the time since the last loop to the current power state
+    EnergyState energy_state = ENERGY_STATE_AWAKE_IDLE;
 #if ENABLE_BLE
-    if (bleCheckResetDailyRequested()) {
-        Serial.println("BLE Command: RESET_DAILY");
-        drinksResetDaily();
-        wakeTime = millis(); // Reset sleep timer
+    if (bleIsSyncing()) {
+        energy_state = ENERGY_STATE_BLE_SYNCING;
+    } else if (bleIsConnected()) {
+        energy_state = ENERGY_STATE_BLE_CONNECTED;
+    } else if (bleIsAdvertising()) {
+        energy_state = ENERGY_STATE_AWAKE_ADVERTISING;
     }
+#endif
+    energyLedgerTick(energy_state);
+#endif
 
-    if (bleCheckClearHistoryRequested()) {
-        Serial.println("BLE Command: CLEAR_HISTORY");
-        drinksClearAll();
-        wakeTime = millis(); // Reset sleep timer
+#if ENABLE_SLEEP_SCHEDULER && ENABLE_BLE
+    if (bleIsConnected()) {
+        sleepSchedulerRecordConnect();  // Counted once per wake
     }
+#endif
 
-    // Note: SET_DAILY_TOTAL command deprecated - daily totals computed from records
-    uint16_t setDailyValue;
-    if (bleCheckSetDailyTotalRequested(setDailyValue)) {
-        Serial.printf("BLE Command: SET_DAILY_TOTAL ignored (deprecated) - value was %dml\n", setDailyValue);
-        // This command is no longer supported since daily totals are computed from records
-        wakeTime = millis(); // Reset sleep timer
+    // Battery sample at its fixed cadence (device_context.h)
+    deviceContextUpdate();
+
+    // Check for serial commands (conditional)
+#if ENABLE_SERIAL_COMMANDS
+    {
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_SERIAL);
+        serialCommandsUpdate();
     }
+#endif
 
-    // Note: TARE_NOW command will be handled below in the weight reading section
+    // Update BLE service and handle BLE commands (Phase 3C - conditional)
+#if ENABLE_BLE
+    {
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_BLE);
+        bleUpdate();
+
+        // Check for BLE data activity (sync, commands) and reset activity timeout
+        // This ensures device stays awake during active BLE communication
+        // Also reset extended sleep timer so 180s threshold doesn't fire during BLE sync
+        // (Plan 067: prevents 180s backpack mode timer from firing during active BLE session)
+        if (bleCheckDataActivity()) {
+            wakeTime = millis();
+            g_time_since_stable_start = millis();
+        }
+
+        if (bleCheckResetDailyRequested()) {
+            Serial.println("BLE Command: RESET_DAILY");
+            drinksResetDaily();
+            wakeTime = millis(); // Reset sleep timer
+        }
+
+        if (bleCheckClearHistoryRequested()) {
+            Serial.println("BLE Command: CLEAR_HISTORY");
+            drinksClearAll();
+            wakeTime = millis(); // Reset sleep timer
+        }
+
+        // Note: SET_DAILY_TOTAL command deprecated - daily totals computed from records
+        uint16_t setDailyValue;
+        if (bleCheckSetDailyTotalRequested(setDailyValue)) {
+            Serial.printf("BLE Command: SET_DAILY_TOTAL ignored (deprecated) - value was %dml\n", setDailyValue);
+            // This command is no longer supported since daily totals are computed from records
+            wakeTime = millis(); // Reset sleep timer
+        }
+
+        // Note: TARE_NOW command will be handled below in the weight reading section
+    }
 #endif
 
     // FIX Bug #4: READ SENSORS ONCE - create snapshot for this loop iteration
     SensorSnapshot sensors;
-    sensors.timestamp = millis();
+    sensors.timestamp = published.timestamp;
     sensors.adc_reading = 0;
+    sensors.adc_fresh = false;
     sensors.water_ml = 0.0f;
     sensors.gesture = GESTURE_NONE;
 
     // Read load cell
-    if (nauReady && nau.available()) {
-        sensors.adc_reading = nau.read();
+    if (nauReady && sample.adc_fresh) {
+        sensors.adc_reading = sample.adc;
+        sensors.adc_fresh = true;
         if (g_calibrated) {
             sensors.water_ml = calibrationGetWaterWeight(sensors.adc_reading, g_calibration);
+            g_loop_water_ml = sensors.water_ml;
         }
     }
 
@@ -1289,6 +1626,7 @@ void loop() {
         // Save updated calibration to NVS
         if (storageSaveCalibration(g_calibration)) {
             Serial.println("BLE Command: Tare complete, calibration updated");
+            bleLoadBottleConfig();
         } else {
             Serial.println("BLE Command: Tare failed - could not save calibration");
         }
@@ -1298,13 +1636,15 @@ void loop() {
 
     // Read accelerometer and get gesture (ONCE)
     if (adxlReady) {
-        sensors.gesture = gesturesUpdate(sensors.water_ml);
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_GESTURES);
+        sensors.gesture = gesturesUpdateFromSample(sample.accel_x, sample.accel_y, sample.accel_z,
+                                                   sensors.water_ml);
 
         // Check for hardware double-tap (ADXL343 INT_SOURCE bit 5)
         // Reading INT_SOURCE clears all interrupt flags - safe during awake mode
         // since the interrupt pin is only used as a wake source from deep sleep
-        uint8_t int_source = readAccelReg(0x30);  // INT_SOURCE
-        if (int_source & 0x20) {  // Bit 5 = DOUBLE_TAP
+        // (read as part of the sampler's ADXL343 burst)
+        if (sample.int_source & 0x20) {  // Bit 5 = DOUBLE_TAP
             sensors.gesture = GESTURE_DOUBLE_TAP;
             Serial.println("=== DOUBLE-TAP DETECTED (hardware) ===");
         }
@@ -1315,6 +1655,9 @@ void loop() {
     float current_water_ml = sensors.water_ml;
     GestureType gesture = sensors.gesture;
 
+    // End a held info screen once its time is up (ui_sequence.h)
+    uiSequenceUpdate();
+
     // Handle shake-while-inverted gesture (shake to empty)
     // Can be disabled via iOS app settings (Issue #32)
     if (gesture == GESTURE_SHAKE_WHILE_INVERTED) {
@@ -1371,26 +1714,8 @@ void loop() {
 
 #if defined(BOARD_ADAFRUIT_FEATHER)
         uiShowBottleEmptied(display);
-        delay(3000);  // Show confirmation for 3 seconds
-
-        // Get current values for display update
-        uint16_t daily_total = drinksGetDailyTotal();
-
-        uint8_t time_hour = 0, time_minute = 0;
-        if (g_time_valid) {
-            struct timeval tv;
-            gettimeofday(&tv, NULL);
-            time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-            struct tm timeinfo;
-            gmtime_r(&now, &timeinfo);
-            time_hour = timeinfo.tm_hour;
-            time_minute = timeinfo.tm_min;
-        }
-
-        uint8_t battery_pct = getBatteryPercent(getBatteryVoltage());
-
-        displayForceUpdate(current_water_ml, daily_total,
-                          time_hour, time_minute, battery_pct, false);
+        // Show confirmation for 3 seconds, then redraw from loop()
+        uiSequenceHold(INFO_SCREEN_DISPLAY_MS, showMainScreenNow);
 #endif
         // Reset baseline to current level - this prevents drinksUpdate() from detecting a drink
         drinksResetBaseline(current_adc);
@@ -1409,6 +1734,7 @@ void loop() {
     if (bleCheckCalibrationStartRequested()) {
         if (cal_state == CAL_IDLE) {
             Serial.println("Main: BLE calibration start requested");
+            uiSequenceCancel();  // Calibration screens own the display now
             calibrationInit();
             calibrationStart();
             cal_state = calibrationGetState();
@@ -1427,6 +1753,7 @@ void loop() {
             // For BLE cancel, skip "Calibration Aborted" screen and go straight to main screen
             // (iOS provides the cancel feedback - user is watching their phone, not the bottle)
             float water_ml = 0.0f;
+            SensorPauseScope pause;
             if (nauReady && nau.available()) {
                 int32_t adc = nau.read();
                 water_ml = calibrationGetWaterWeight(adc, g_calibration);
@@ -1437,19 +1764,9 @@ void loop() {
             uint16_t daily_total = drinksGetDailyTotal();
 
             uint8_t time_hour = 0, time_minute = 0;
-            if (g_time_valid) {
-                struct timeval tv;
-                gettimeofday(&tv, NULL);
-                time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                struct tm timeinfo;
-                gmtime_r(&now, &timeinfo);
-                time_hour = timeinfo.tm_hour;
-                time_minute = timeinfo.tm_min;
-            }
+            deviceContextHourMinute(time_hour, time_minute);
 
-            uint8_t battery_pct = 50;
-            float voltage = getBatteryVoltage();
-            battery_pct = getBatteryPercent(voltage);
+            uint8_t battery_pct = deviceContextBatteryPercent();
 
             displayForceUpdate(water_ml, daily_total,
                               time_hour, time_minute, battery_pct, false);
@@ -1467,6 +1784,7 @@ void loop() {
         if (gesture == GESTURE_INVERTED_HOLD) {
             if (!g_cal_just_cancelled) {
                 Serial.println("Main: Calibration triggered!");
+                uiSequenceCancel();  // Calibration screens own the display now
                 calibrationStart();
                 cal_state = calibrationGetState();
 #if ENABLE_BLE
@@ -1526,43 +1844,14 @@ void loop() {
                 Serial.print("Main: Calibration error: ");
                 Serial.println(result.error_message);
 
-                // Show error screen for 3 seconds (matches other info screens)
-                delay(CAL_STARTED_DISPLAY_DURATION);
-
-                // Return to IDLE and redraw main screen
+                // Return to IDLE now - the error screen stays up for 3 seconds
+                // (matches other info screens) while sensors and BLE keep running
                 calibrationCancel();
                 g_last_cal_state = CAL_IDLE;
                 wakeTime = millis();  // Reset sleep timer - give user 30 more seconds
                 Serial.println("Main: Returning to main screen after error");
 #if defined(BOARD_ADAFRUIT_FEATHER)
-                // Get current values for force update
-                float water_ml = 0.0f;
-                if (nauReady && nau.available()) {
-                    int32_t adc = nau.read();
-                    water_ml = calibrationGetWaterWeight(adc, g_calibration);
-                    if (water_ml < 0) water_ml = 0;
-                    if (water_ml > 830) water_ml = 830;
-                }
-
-                uint16_t daily_total = drinksGetDailyTotal();
-
-                uint8_t time_hour = 0, time_minute = 0;
-                if (g_time_valid) {
-                    struct timeval tv;
-                    gettimeofday(&tv, NULL);
-                    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                    struct tm timeinfo;
-                    gmtime_r(&now, &timeinfo);
-                    time_hour = timeinfo.tm_hour;
-                    time_minute = timeinfo.tm_min;
-                }
-
-                uint8_t battery_pct = 50;
-                float voltage = getBatteryVoltage();
-                battery_pct = getBatteryPercent(voltage);
-
-                displayForceUpdate(water_ml, daily_total,
-                                  time_hour, time_minute, battery_pct, false);
+                uiSequenceHold(CAL_STARTED_DISPLAY_DURATION, showMainScreenNow);
 #endif
                 return;  // Exit early - don't update g_last_cal_state
             }
@@ -1574,38 +1863,9 @@ void loop() {
                 g_last_cal_state = CAL_IDLE;
 
 #if defined(BOARD_ADAFRUIT_FEATHER)
-                // Show "Calibration Aborted" screen for 3 seconds
+                // Show "Calibration Aborted" screen for 3 seconds, then the main screen
                 uiCalibrationShowAborted();
-                delay(CAL_STARTED_DISPLAY_DURATION);
-
-                // Then redraw main screen
-                float water_ml = 0.0f;
-                if (nauReady && nau.available()) {
-                    int32_t adc = nau.read();
-                    water_ml = calibrationGetWaterWeight(adc, g_calibration);
-                    if (water_ml < 0) water_ml = 0;
-                    if (water_ml > 830) water_ml = 830;
-                }
-
-                uint16_t daily_total = drinksGetDailyTotal();
-
-                uint8_t time_hour = 0, time_minute = 0;
-                if (g_time_valid) {
-                    struct timeval tv;
-                    gettimeofday(&tv, NULL);
-                    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                    struct tm timeinfo;
-                    gmtime_r(&now, &timeinfo);
-                    time_hour = timeinfo.tm_hour;
-                    time_minute = timeinfo.tm_min;
-                }
-
-                uint8_t battery_pct = 50;
-                float voltage = getBatteryVoltage();
-                battery_pct = getBatteryPercent(voltage);
-
-                displayForceUpdate(water_ml, daily_total,
-                                  time_hour, time_minute, battery_pct, false);
+                uiSequenceHold(CAL_STARTED_DISPLAY_DURATION, showMainScreenNow);
 #endif
                 return;  // Exit early
             }
@@ -1617,44 +1877,18 @@ void loop() {
                     Serial.println("Main: Calibration completed successfully!");
                     g_calibration = result.data;
                     g_calibrated = true;
+#if ENABLE_BLE
+                    bleLoadBottleConfig();
+#endif
 
-                    // Show complete screen for 3 seconds (matches other info screens)
-                    delay(CAL_STARTED_DISPLAY_DURATION);
-
-                    // Return to IDLE and redraw main screen
+                    // Return to IDLE now - the complete screen stays up for 3 seconds
+                    // (matches other info screens) before the main screen is redrawn
                     calibrationCancel();
                     g_last_cal_state = CAL_IDLE;
                     wakeTime = millis();  // Reset sleep timer - give user 30 more seconds
                     Serial.println("Main: Returning to main screen");
 #if defined(BOARD_ADAFRUIT_FEATHER)
-                // Get current values for force update
-                float water_ml = 0.0f;
-                if (nauReady && nau.available()) {
-                    int32_t adc = nau.read();
-                    water_ml = calibrationGetWaterWeight(adc, g_calibration);
-                    if (water_ml < 0) water_ml = 0;
-                    if (water_ml > 830) water_ml = 830;
-                }
-
-                uint16_t daily_total = drinksGetDailyTotal();
-
-                uint8_t time_hour = 0, time_minute = 0;
-                if (g_time_valid) {
-                    struct timeval tv;
-                    gettimeofday(&tv, NULL);
-                    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                    struct tm timeinfo;
-                    gmtime_r(&now, &timeinfo);
-                    time_hour = timeinfo.tm_hour;
-                    time_minute = timeinfo.tm_min;
-                }
-
-                uint8_t battery_pct = 50;
-                float voltage = getBatteryVoltage();
-                battery_pct = getBatteryPercent(voltage);
-
-                displayForceUpdate(water_ml, daily_total,
-                                  time_hour, time_minute, battery_pct, false);
+                    uiSequenceHold(CAL_STARTED_DISPLAY_DURATION, showMainScreenNow);
 #endif
                 }
                 return;  // Exit early - don't update g_last_cal_state
@@ -1728,7 +1962,11 @@ void loop() {
                 // Process drink tracking (we're already UPRIGHT_STABLE)
                 // Only track drinks if weight is valid (>= -50ml threshold)
                 if (g_time_valid && display_water_ml >= -50.0f) {
+                    LOOP_PROFILE_SCOPE(LOOP_STAGE_DRINKS);
                     bool drink_recorded = drinksUpdate(current_adc, g_calibration);
+#if ENABLE_TRACE_RECORDER
+                    traceRecorderNoteDrinkCheck(drink_recorded);
+#endif
                     if (drink_recorded) {
                         // Reset extended sleep timer - drink is unambiguous user interaction
                         g_time_since_stable_start = millis();
@@ -1744,24 +1982,14 @@ void loop() {
 
                 // Get current time
                 uint8_t time_hour = 0, time_minute = 0;
-                if (g_time_valid) {
-                    struct timeval tv;
-                    gettimeofday(&tv, NULL);
-                    time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-                    struct tm timeinfo;
-                    gmtime_r(&now, &timeinfo);
-                    time_hour = timeinfo.tm_hour;
-                    time_minute = timeinfo.tm_min;
-                }
+                deviceContextHourMinute(time_hour, time_minute);
 
                 // Get battery percent
-                uint8_t battery_pct = 50;  // Default
-                float voltage = getBatteryVoltage();
-                battery_pct = getBatteryPercent(voltage);
+                uint8_t battery_pct = deviceContextBatteryPercent();
 
                 // Check for BLE force display refresh (e.g., after SET_DAILY_TOTAL command)
 #if ENABLE_BLE
-                bool ble_force_refresh = bleCheckForceDisplayRefresh();
+                bool ble_force_refresh = !uiSequenceActive() && bleCheckForceDisplayRefresh();
 #else
                 bool ble_force_refresh = false;
 #endif
@@ -1769,9 +1997,13 @@ void loop() {
                 // Check if display needs update (water, daily intake, time, or battery changed)
                 // OR if we need to clear Zzzz indicator after extended sleep
                 // OR if BLE command requested a forced refresh
-                if (g_force_display_clear_sleep || ble_force_refresh ||
-                    displayNeedsUpdate(display_water_ml, daily_total,
-                                      time_interval_elapsed, battery_interval_elapsed)) {
+                // Held info screens (ui_sequence.h) are left up until their step runs
+                bool forced_refresh = g_force_display_clear_sleep || ble_force_refresh;
+                if (!uiSequenceActive() &&
+                    (forced_refresh ||
+                     displayNeedsUpdate(display_water_ml, daily_total,
+                                       time_interval_elapsed, battery_interval_elapsed))) {
+                    LOOP_PROFILE_SCOPE(LOOP_STAGE_DISPLAY);
 
                     if (g_force_display_clear_sleep) {
                         Serial.println("Extended sleep: Clearing Zzzz indicator");
@@ -1781,8 +2013,14 @@ void loop() {
                         Serial.println("BLE: Forced display refresh");
                     }
 
-                    displayUpdate(display_water_ml, daily_total,
-                                 time_hour, time_minute, battery_pct, false);
+                    // Sensor-driven changes may be held for one render (ENABLE_DEFERRED_RENDER)
+                    if (forced_refresh) {
+                        displayUpdate(display_water_ml, daily_total,
+                                     time_hour, time_minute, battery_pct, false);
+                    } else {
+                        displayDeferUpdate(display_water_ml, daily_total,
+                                           time_hour, time_minute, battery_pct);
+                    }
 
                     // Reset interval timers if they triggered the update
                     if (time_interval_elapsed) last_time_check = millis();
@@ -1807,6 +2045,7 @@ void loop() {
 #if ENABLE_BLE
                     bleStopAdvertising();
 #endif
+                    uiSequenceCancel();  // Low-battery screen replaces any held info screen
                     displayLowBattery();
 
                     // Save state before sleeping
@@ -1814,6 +2053,9 @@ void loop() {
                     drinksSaveToRTC();
                     extendedSleepSaveToRTC();
                     activityStatsSaveToRTC();
+#if ENABLE_TRACE_RECORDER
+                    traceRecorderFlush();
+#endif
 
                     // Timer-only deep sleep (no motion wake)
                     uint64_t timer_us = (uint64_t)LOW_BATTERY_CHECK_INTERVAL_SEC * 1000000ULL;
@@ -1821,6 +2063,9 @@ void loop() {
                     rtc_health_check_wake = true;
                     Serial.printf("Low battery sleep: %d seconds until next check\n", LOW_BATTERY_CHECK_INTERVAL_SEC);
                     Serial.flush();
+#if ENABLE_ENERGY_LEDGER
+                    energyLedgerEnterSleep(false);
+#endif
                     esp_deep_sleep_start();
                 }
             }
@@ -1831,25 +2076,17 @@ void loop() {
     // Check for BLE config changes that require display update (e.g., daily goal changed)
     // This check is OUTSIDE the gesture block so display updates even when bottle isn't upright
 #if defined(BOARD_ADAFRUIT_FEATHER)
-    if (g_calibrated && cal_state == CAL_IDLE && displayCheckGoalChanged()) {
+    if (g_calibrated && cal_state == CAL_IDLE && !uiSequenceActive() && displayCheckGoalChanged()) {
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_DISPLAY);
         DEBUG_PRINTLN(g_debug_display, "Display: Goal changed via BLE - forcing update");
         DisplayState last_state = displayGetState();
 
         // Get current time
         uint8_t time_hour = 0, time_minute = 0;
-        if (g_time_valid) {
-            struct timeval tv;
-            gettimeofday(&tv, NULL);
-            time_t now = tv.tv_sec + (g_timezone_offset * 3600);
-            struct tm timeinfo;
-            gmtime_r(&now, &timeinfo);
-            time_hour = timeinfo.tm_hour;
-            time_minute = timeinfo.tm_min;
-        }
+        deviceContextHourMinute(time_hour, time_minute);
 
         // Get battery percent
-        float voltage = getBatteryVoltage();
-        uint8_t battery_pct = getBatteryPercent(voltage);
+        uint8_t battery_pct = deviceContextBatteryPercent();
 
         // Get daily total
         uint16_t daily_total = drinksGetDailyTotal();
@@ -1858,6 +2095,12 @@ void loop() {
         displayForceUpdate(last_state.water_ml, daily_total,
                           time_hour, time_minute, battery_pct, false);
     }
+
+    // Deferred render: held main-screen changes go out once nothing has changed for a while
+    if (g_calibrated && cal_state == CAL_IDLE && !uiSequenceActive() && displayDeferredDue()) {
+        LOOP_PROFILE_SCOPE(LOOP_STAGE_DISPLAY);
+        displayFlushDeferred();
+    }
 #endif
 
     // Send BLE updates during iOS calibration mode (even if bottle not yet calibrated)
@@ -1871,9 +2114,7 @@ void loop() {
             last_cal_ble_update = millis();
 
             // Get battery percent
-            uint8_t battery_pct = 50;  // Default
-            float voltage = getBatteryVoltage();
-            battery_pct = getBatteryPercent(voltage);
+            uint8_t battery_pct = deviceContextBatteryPercent();
 
             // Get daily total
             uint16_t daily_total = drinksGetDailyTotal();
@@ -1888,11 +2129,26 @@ void loop() {
     }
 #endif
 
+#if ENABLE_TRACE_RECORDER
+    // Record this loop's sensor frame (no-op unless TRACE ON)
+    {
+        uint8_t trace_flags = 0;
+        if (sensors.adc_fresh) trace_flags |= TRACE_FLAG_ADC_FRESH;
+        if (g_calibrated) trace_flags |= TRACE_FLAG_CALIBRATED;
+        if (g_cancel_drink_pending) trace_flags |= TRACE_FLAG_CANCEL_PENDING;
+#if ENABLE_STANDALONE_CALIBRATION
+        if (calibrationIsActive()) trace_flags |= TRACE_FLAG_CAL_ACTIVE;
+#endif
+        traceRecorderRecord(sensors.timestamp, sensors.adc_reading, sensors.gesture, trace_flags);
+    }
+#endif
+
     // Status line: gesture + mode + countdowns (always shown, every 3s)
     // Silenced by d0 (g_debug_enabled = false)
     if (g_debug_enabled) {
         static unsigned long last_status_print = 0;
         if (adxlReady && (millis() - last_status_print >= 3000)) {
+            LOOP_PROFILE_SCOPE(LOOP_STAGE_DEBUG_PRINT);
             last_status_print = millis();
 
             // Gesture name
@@ -1910,7 +2166,7 @@ void loop() {
             // Modes: NORM=normal 30s, SYNC=waiting for NEW unsynced drinks 4min, EXT=backpack/timer wake
             Serial.print("  [");
 #if ENABLE_BLE
-            uint16_t unsynced = storageGetUnsyncedCount();
+            uint16_t unsynced = getUnsyncedCount();
             bool has_new_unsynced = (unsynced > g_unsynced_at_wake);
 #else
             uint16_t unsynced = 0;
@@ -1932,10 +2188,7 @@ void loop() {
 
             // Activity timeout countdown (normal sleep)
             // Use the actual timeout that will be applied (extended only for NEW unsynced records)
-            uint32_t effective_timeout = g_sleep_timeout_ms;
-            if (has_new_unsynced) {
-                effective_timeout = ACTIVITY_TIMEOUT_EXTENDED_MS;
-            }
+            uint32_t effective_timeout = getActivityTimeoutMs(has_new_unsynced || (g_sync_window_wake && unsynced > 0));
             if (effective_timeout > 0) {
                 unsigned long elapsed = millis() - wakeTime;
                 if (elapsed < effective_timeout) {
@@ -1948,8 +2201,9 @@ void loop() {
 
             // Extended sleep timer countdown (time since last UPRIGHT_STABLE)
             unsigned long time_since_stable = (millis() - g_time_since_stable_start) / 1000;
-            unsigned long ext_remaining = (time_since_stable < g_time_since_stable_threshold_sec)
-                ? (g_time_since_stable_threshold_sec - time_since_stable) : 0;
+            unsigned long ext_threshold = getBackpackThresholdSec();
+            unsigned long ext_remaining = (time_since_stable < ext_threshold)
+                ? (ext_threshold - time_since_stable) : 0;
             Serial.print(" ext:");
             Serial.print(ext_remaining);
             Serial.print("s");
@@ -1962,6 +2216,7 @@ void loop() {
     if (g_debug_enabled && g_debug_accelerometer) {
         static unsigned long last_accel_print = 0;
         if (adxlReady && (millis() - last_accel_print >= 3000)) {
+            LOOP_PROFILE_SCOPE(LOOP_STAGE_DEBUG_PRINT);
             last_accel_print = millis();
 
             float x, y, z;
@@ -1979,15 +2234,12 @@ void loop() {
         static unsigned long last_time_save = 0;
         static int last_saved_hour = -1;
 
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        time_t now = tv.tv_sec + (g_timezone_offset * 3600);
         struct tm timeinfo;
-        gmtime_r(&now, &timeinfo);
+        deviceContextLocalTime(timeinfo);
 
         // Save on hour boundaries (e.g., 14:00, 15:00, etc.)
         if (timeinfo.tm_hour != last_saved_hour && timeinfo.tm_min == 0) {
-            storageSaveLastBootTime(tv.tv_sec);
+            storageSaveLastBootTime(time(nullptr));
             last_saved_hour = timeinfo.tm_hour;
             Serial.println("Time: Hourly timestamp saved to NVS");
         }
@@ -2010,13 +2262,14 @@ void loop() {
 #endif
     ) {
         unsigned long total_awake_time = millis() - g_time_since_stable_start;
-        if (total_awake_time >= (g_time_since_stable_threshold_sec * 1000)) {
+        uint32_t threshold_sec = getBackpackThresholdSec();
+        if (total_awake_time >= (threshold_sec * 1000)) {
             // Plan 034: Enter extended sleep regardless of BLE connection status
             // BLE connection alone is not user activity - same as activity timeout logic
             Serial.print("Extended sleep: Time since stable threshold exceeded (");
             Serial.print(total_awake_time / 1000);
             Serial.print("s >= ");
-            Serial.print(g_time_since_stable_threshold_sec);
+            Serial.print(threshold_sec);
             Serial.println("s)");
             Serial.println("Extended sleep: Switching to extended sleep mode");
             g_in_extended_sleep_mode = true;
@@ -2030,14 +2283,18 @@ void loop() {
     // Only extend if there are MORE unsynced records than when we last slept (new drinks)
     // This prevents waiting 4 minutes on every wake when iOS app isn't running
     // BLE data activity resets the timeout via bleCheckDataActivity() above
-    uint32_t timeout_ms = g_sleep_timeout_ms;
+    // Learned schedule: timeouts shift with the hour (sleep_scheduler.h)
+    bool sync_window = false;
 #if ENABLE_BLE
-    uint16_t unsynced = storageGetUnsyncedCount();
+    uint16_t unsynced = getUnsyncedCount();
     bool has_new_unsynced = (unsynced > g_unsynced_at_wake);
-    if (has_new_unsynced) {
-        timeout_ms = ACTIVITY_TIMEOUT_EXTENDED_MS;
+    // A timer wake aimed at the phone's usual sync hour holds the window too
+    sync_window = has_new_unsynced || (g_sync_window_wake && unsynced > 0);
+    if (sync_window) {
+        g_sync_window_held = true;
     }
 #endif
+    uint32_t timeout_ms = getActivityTimeoutMs(sync_window);
     if (g_sleep_timeout_ms > 0 && millis() - wakeTime >= timeout_ms) {
         bool sleep_blocked = false;
 
@@ -2084,8 +2341,6 @@ void loop() {
             displayUpdate(last_state.water_ml, last_state.daily_total_ml,
                          last_state.hour, last_state.minute,
                          last_state.battery_percent, true);
-
-            delay(1000); // Brief pause to ensure display updates
 #else
             Serial.println("Entering sleep without display update (DISPLAY_SLEEP_INDICATOR=0)");
 #endif
@@ -2119,6 +2374,5 @@ void loop() {
         }
     }
 
-    // Reduced delay for more responsive gesture detection
-    delay(200);
+    // No delay here - the next iteration blocks on the sensor task's sample
 }
@@ -0,0 +1,79 @@
+// placement_wake.cpp - ADXL343 placement wake for normal sleep
+// Part of the Aquavate smart water bottle firmware
+
+#include "placement_wake.h"
+#include "config.h"
+
+// External dependencies from main.cpp
+extern void writeAccelReg(uint8_t reg, uint8_t value);
+extern uint8_t readAccelReg(uint8_t reg);
+
+// ADXL343 Register Definitions for activity/inactivity
+#define ADXL_THRESH_ACT         0x24    // Activity threshold
+#define ADXL_THRESH_INACT       0x25    // Inactivity threshold
+#define ADXL_TIME_INACT         0x26    // Inactivity time
+#define ADXL_ACT_INACT_CTL      0x27    // Axis enable for activity/inactivity
+#define ADXL_POWER_CTL          0x2D    // Power control
+#define ADXL_INT_ENABLE         0x2E    // Interrupt enable
+#define ADXL_INT_MAP            0x2F    // Interrupt mapping
+#define ADXL_INT_SOURCE         0x30    // Interrupt source (read to clear)
+
+#define ADXL_INT_INACTIVITY     0x08
+
+bool placementWakeArm() {
+    DEBUG_PRINTLN(g_debug_accelerometer, "\n=== ADXL343 Placement Wake Configuration ===");
+
+    // Step 1: Standby while reconfiguring (also resets the link state machine)
+    writeAccelReg(ADXL_POWER_CTL, 0x00);
+    writeAccelReg(ADXL_INT_ENABLE, 0x00);
+    DEBUG_PRINTLN(g_debug_accelerometer, "1. Power mode: standby");
+
+    // Step 2: Activity threshold (arms the inactivity search, never wakes)
+    writeAccelReg(ADXL_THRESH_ACT, ACTIVITY_WAKE_THRESHOLD);
+    DEBUG_PRINTF(g_debug_accelerometer, "2. Activity threshold: 0x%02X (%.1fg)\n", ACTIVITY_WAKE_THRESHOLD, ACTIVITY_WAKE_THRESHOLD * 0.0625f);
+
+    // Step 3: Inactivity threshold and time
+    // Scale = 62.5 mg/LSB, 1 s/LSB
+    writeAccelReg(ADXL_THRESH_INACT, PLACEMENT_INACT_THRESHOLD);
+    writeAccelReg(ADXL_TIME_INACT, PLACEMENT_INACT_TIME);
+    DEBUG_PRINTF(g_debug_accelerometer, "3. Inactivity: <%.2fg for %ds\n", PLACEMENT_INACT_THRESHOLD * 0.0625f, PLACEMENT_INACT_TIME);
+
+    // Step 4: Activity AC-coupled on all axes, inactivity DC-coupled on X and Z
+    // Bits: 7=ACT_acdc(1=AC), 6-4=ACT_X/Y/Z, 3=INACT_acdc(0=DC), 2-0=INACT_X/Y/Z
+    writeAccelReg(ADXL_ACT_INACT_CTL, 0xF5);
+    DEBUG_PRINTLN(g_debug_accelerometer, "4. Axes: activity X/Y/Z (AC), inactivity X/Z (DC)");
+
+    // Step 5: Activity to INT2 (not connected), inactivity to INT1
+    writeAccelReg(ADXL_INT_MAP, 0x10);
+    DEBUG_PRINTLN(g_debug_accelerometer, "5. Interrupt routing: activity INT2, inactivity INT1");
+
+    // Step 6: Enable activity + inactivity interrupts
+    writeAccelReg(ADXL_INT_ENABLE, 0x18);
+    DEBUG_PRINTLN(g_debug_accelerometer, "6. Interrupt enable: activity + inactivity");
+
+    // Step 7: Link mode + measurement (bit 5 = link, bit 3 = measure)
+    writeAccelReg(ADXL_POWER_CTL, 0x28);
+    DEBUG_PRINTLN(g_debug_accelerometer, "7. Power mode: measurement, link");
+
+    // Step 8: Read INT_SOURCE to clear any pending interrupts
+    uint8_t int_source = readAccelReg(ADXL_INT_SOURCE);
+    DEBUG_PRINTF(g_debug_accelerometer, "8. Cleared INT_SOURCE: 0x%02X\n", int_source);
+
+    // Step 9: Link mode searches for inactivity first - a still bottle would wake
+    // us after PLACEMENT_INACT_TIME. Take that event here and clear it, so the
+    // chip moves on to waiting for a pickup before sleep starts.
+    bool armed = false;
+    uint32_t start = millis();
+    while (millis() - start < PLACEMENT_ARM_TIMEOUT_MS) {
+        if (readAccelReg(ADXL_INT_SOURCE) & ADXL_INT_INACTIVITY) {
+            armed = true;
+            break;
+        }
+        delay(PLACEMENT_ARM_POLL_MS);
+    }
+    DEBUG_PRINTF(g_debug_accelerometer, "9. Initial inactivity %s after %lums\n",
+                 armed ? "cleared" : "not seen", (unsigned long)(millis() - start));
+
+    DEBUG_PRINTLN(g_debug_accelerometer, "\n=== Placement Wake Configuration Complete ===\n");
+    return armed;
+}
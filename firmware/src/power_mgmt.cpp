@@ -0,0 +1,116 @@
+// power_mgmt.cpp - Awake-mode power management (DFS, automatic light sleep, PM locks)
+// Part of the Aquavate smart water bottle firmware
+
+#include "power_mgmt.h"
+#include <sdkconfig.h>
+
+#if ENABLE_POWER_MANAGEMENT && CONFIG_PM_ENABLE
+#include <esp_pm.h>
+
+#if CONFIG_IDF_TARGET_ESP32
+#include <esp32/pm.h>
+typedef esp_pm_config_esp32_t PowerPmConfig;
+#else
+typedef esp_pm_config_t PowerPmConfig;
+#endif
+
+static esp_pm_lock_handle_t g_locks[POWER_LOCK_COUNT] = {};
+#endif
+
+static bool g_dfs_active = false;
+static bool g_light_sleep_active = false;
+static bool g_held[POWER_LOCK_COUNT] = {};
+
+bool powerMgmtInit(bool allow_light_sleep) {
+#if ENABLE_POWER_MANAGEMENT && CONFIG_PM_ENABLE
+    PowerPmConfig pm_config = {};
+    pm_config.max_freq_mhz = POWER_CPU_MAX_MHZ;
+    pm_config.min_freq_mhz = POWER_CPU_MIN_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    pm_config.light_sleep_enable = allow_light_sleep;
+#else
+    (void)allow_light_sleep;    // Light sleep needs tickless idle in the core build
+#endif
+
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        Serial.printf("ERROR: esp_pm_configure failed (%d) - fixed %dMHz clock\n",
+                      err, POWER_CPU_MIN_MHZ);
+        setCpuFrequencyMhz(POWER_CPU_MIN_MHZ);
+        return false;
+    }
+
+    static const struct {
+        esp_pm_lock_type_t type;
+        const char* name;
+    } LOCKS[POWER_LOCK_COUNT] = {
+        { ESP_PM_APB_FREQ_MAX, "i2c" },
+        { ESP_PM_APB_FREQ_MAX, "display" },
+        { ESP_PM_CPU_FREQ_MAX, "ble_sync" },
+    };
+    for (uint8_t i = 0; i < POWER_LOCK_COUNT; i++) {
+        if (g_locks[i] == nullptr &&
+            esp_pm_lock_create(LOCKS[i].type, 0, LOCKS[i].name, &g_locks[i]) != ESP_OK) {
+            Serial.printf("ERROR: PM lock '%s' creation failed\n", LOCKS[i].name);
+            g_locks[i] = nullptr;
+        }
+    }
+
+    g_dfs_active = true;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    g_light_sleep_active = allow_light_sleep;
+#endif
+    Serial.printf("Power: DFS %d-%dMHz, light sleep %s\n", POWER_CPU_MIN_MHZ, POWER_CPU_MAX_MHZ,
+                  g_light_sleep_active ? "on" : "off");
+    return true;
+#else
+    (void)allow_light_sleep;
+#if ENABLE_POWER_MANAGEMENT
+    // No esp_pm in this core - nothing needs 240MHz while awake
+    setCpuFrequencyMhz(POWER_CPU_MIN_MHZ);
+    Serial.printf("Power: esp_pm not available - fixed %dMHz clock\n", POWER_CPU_MIN_MHZ);
+#endif
+    return false;
+#endif
+}
+
+void powerMgmtAcquire(PowerLock lock) {
+#if ENABLE_POWER_MANAGEMENT && CONFIG_PM_ENABLE
+    if (lock < POWER_LOCK_COUNT && g_locks[lock] != nullptr) {
+        esp_pm_lock_acquire(g_locks[lock]);
+    }
+#else
+    (void)lock;
+#endif
+}
+
+void powerMgmtRelease(PowerLock lock) {
+#if ENABLE_POWER_MANAGEMENT && CONFIG_PM_ENABLE
+    if (lock < POWER_LOCK_COUNT && g_locks[lock] != nullptr) {
+        esp_pm_lock_release(g_locks[lock]);
+    }
+#else
+    (void)lock;
+#endif
+}
+
+void powerMgmtSetHeld(PowerLock lock, bool held) {
+    if (lock >= POWER_LOCK_COUNT || g_held[lock] == held) {
+        return;
+    }
+
+    g_held[lock] = held;
+    if (held) {
+        powerMgmtAcquire(lock);
+    } else {
+        powerMgmtRelease(lock);
+    }
+}
+
+bool powerMgmtDfsActive() {
+    return g_dfs_active;
+}
+
+bool powerMgmtLightSleepActive() {
+    return g_light_sleep_active;
+}
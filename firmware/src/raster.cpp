@@ -0,0 +1,190 @@
+// raster.cpp - Packed 1bpp drawing primitives for the e-paper frame buffer
+// Part of the Aquavate smart water bottle firmware
+
+#include "raster.h"
+
+// Set or clear n linear bits from bit 'start' - masked head/tail bytes, memset between
+static void fillBits(uint8_t* buf, int32_t start, int32_t n, bool set) {
+    int32_t end = start + n - 1;
+    int32_t first = start >> 3;
+    int32_t last = end >> 3;
+    uint8_t head = 0xFF >> (start & 7);
+    uint8_t tail = (uint8_t)(0xFF << (7 - (end & 7)));
+
+    if (first == last) {
+        uint8_t mask = head & tail;
+        buf[first] = set ? (buf[first] | mask) : (buf[first] & ~mask);
+        return;
+    }
+
+    buf[first] = set ? (buf[first] | head) : (buf[first] & ~head);
+    if (last > first + 1) {
+        memset(&buf[first + 1], set ? 0xFF : 0x00, last - first - 1);
+    }
+    buf[last] = set ? (buf[last] | tail) : (buf[last] & ~tail);
+}
+
+// OR (set) or AND-NOT (clear) n bits of src, from bit s, into buf from linear bit d
+static void inkBits(uint8_t* buf, int32_t d, const uint8_t* src, int32_t s, int32_t n, bool set) {
+    while (n > 0) {
+        int32_t dst_bit = d & 7;
+        int32_t chunk = 8 - dst_bit;
+        if (chunk > n) chunk = n;
+
+        // Next 'chunk' source bits, aligned to the destination bit position
+        int32_t src_byte = s >> 3;
+        uint32_t window = (uint32_t)src[src_byte] << 8;
+        if (((s + chunk - 1) >> 3) != src_byte) {
+            window |= src[src_byte + 1];
+        }
+        uint8_t bits = (uint8_t)(window >> (8 - (s & 7)));
+        bits = (uint8_t)(bits & (0xFF << (8 - chunk))) >> dst_bit;
+
+        if (set) {
+            buf[d >> 3] |= bits;
+        } else {
+            buf[d >> 3] &= ~bits;
+        }
+        d += chunk;
+        s += chunk;
+        n -= chunk;
+    }
+}
+
+static uint8_t reverseBits(uint8_t b) {
+    static const uint8_t NIBBLE[16] = {
+        0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+    };
+    return (uint8_t)((NIBBLE[b & 0x0F] << 4) | NIBBLE[b >> 4]);
+}
+
+static inline int32_t linearBit(const RasterTarget& t, int16_t x, int16_t y) {
+    return t.origin_bit + (int32_t)x * t.x_step + (int32_t)y * t.y_step;
+}
+
+void rasterFillColumn(const RasterTarget& target, int16_t x, int16_t y, int16_t h, bool ink) {
+    if (x < 0 || x >= target.width) return;
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (y + h > target.height) h = target.height - y;
+    if (h <= 0) return;
+
+    // Runs go up the buffer when y_step is negative - start from the bottom pixel
+    int32_t start = linearBit(target, x, target.y_step > 0 ? y : y + h - 1);
+    fillBits(target.buf, start, h, ink == target.ink_sets_bits);
+}
+
+void rasterFillRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h, bool ink) {
+    for (int16_t col = x; col < x + w; col++) {
+        rasterFillColumn(target, col, y, h, ink);
+    }
+}
+
+void rasterDrawRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h, bool ink) {
+    if (w <= 0 || h <= 0) return;
+    rasterFillColumn(target, x, y, h, ink);
+    rasterFillColumn(target, x + w - 1, y, h, ink);
+    for (int16_t col = x + 1; col < x + w - 1; col++) {
+        rasterFillColumn(target, col, y, 1, ink);
+        rasterFillColumn(target, col, y + h - 1, 1, ink);
+    }
+}
+
+// Adafruit_GFX::fillCircleHelper with vertical runs (it already draws in columns)
+static void fillCircleColumns(const RasterTarget& target, int16_t x0, int16_t y0, int16_t r,
+                              uint8_t corners, int16_t delta, bool ink) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        if (x < (y + 1)) {
+            if (corners & 1) rasterFillColumn(target, x0 + x, y0 - y, 2 * y + delta, ink);
+            if (corners & 2) rasterFillColumn(target, x0 - x, y0 - y, 2 * y + delta, ink);
+        }
+        if (y != px) {
+            if (corners & 1) rasterFillColumn(target, x0 + py, y0 - px, 2 * px + delta, ink);
+            if (corners & 2) rasterFillColumn(target, x0 - py, y0 - px, 2 * px + delta, ink);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void rasterFillRoundRect(const RasterTarget& target, int16_t x, int16_t y, int16_t w, int16_t h,
+                         int16_t r, bool ink) {
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius) r = max_radius;
+
+    rasterFillRect(target, x + r, y, w - 2 * r, h, ink);
+    fillCircleColumns(target, x + w - r - 1, y + r, r, 1, h - 2 * r - 1, ink);
+    fillCircleColumns(target, x + r, y + r, r, 2, h - 2 * r - 1, ink);
+}
+
+void rasterBlitSprite(const RasterTarget& target, int16_t x, int16_t y, const RasterSprite& sprite,
+                      const RasterSprite* lower, int16_t lower_from_row) {
+    const int16_t h = sprite.height;
+    const uint8_t cb = sprite.column_bytes;
+    if (h > RASTER_MAX_SPRITE_HEIGHT) return;
+
+    // Visible rows of the sprite
+    int16_t row_first = (y < 0) ? -y : 0;
+    int16_t row_last = (y + h > target.height) ? target.height - 1 - y : h - 1;
+    if (row_first > row_last) return;
+
+    const bool set = target.ink_sets_bits;
+    const bool reversed = target.y_step < 0;
+    const int32_t pad = (int32_t)cb * 8 - h;   // Unused low bits of the last byte
+
+    uint8_t column[RASTER_MAX_SPRITE_HEIGHT / 8];
+    uint8_t flipped[RASTER_MAX_SPRITE_HEIGHT / 8];
+
+    for (int16_t c = 0; c < sprite.width; c++) {
+        int16_t dst_x = x + c;
+        if (dst_x < 0 || dst_x >= target.width) continue;
+
+        const uint8_t* upper_col = sprite.data + (size_t)c * cb;
+        const uint8_t* src = upper_col;
+        if (lower != nullptr) {
+            // Row-range mask: bits for rows >= lower_from_row come from 'lower'
+            const uint8_t* lower_col = lower->data + (size_t)c * cb;
+            for (uint8_t j = 0; j < cb; j++) {
+                int16_t row0 = j * 8;
+                uint8_t mask;
+                if (lower_from_row <= row0) mask = 0xFF;
+                else if (lower_from_row >= row0 + 8) mask = 0x00;
+                else mask = 0xFF >> (lower_from_row - row0);
+                column[j] = (upper_col[j] & ~mask) | (lower_col[j] & mask);
+            }
+            src = column;
+        }
+
+        if (reversed) {
+            // Bottom row first: reverse byte order and bits, skipping the padding
+            for (uint8_t j = 0; j < cb; j++) {
+                flipped[j] = reverseBits(src[cb - 1 - j]);
+            }
+            inkBits(target.buf, linearBit(target, dst_x, y + row_last), flipped,
+                    pad + (h - 1 - row_last), row_last - row_first + 1, set);
+        } else {
+            inkBits(target.buf, linearBit(target, dst_x, y + row_first), src,
+                    row_first, row_last - row_first + 1, set);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+// sensor_sampler.cpp - Per-loop sensor sample via the async I2C bus
+// Part of the Aquavate smart water bottle firmware
+
+#include "sensor_sampler.h"
+#include "i2c_bus.h"
+#include "aquavate.h"
+#include "config.h"
+#include <Wire.h>
+
+// NAU7802 registers
+#define NAU7802_REG_PU_CTRL     0x00
+#define NAU7802_REG_ADCO_B2     0x12    // ADC result MSB (B2, B1, B0 follow)
+#define NAU7802_PU_CTRL_CR      0x20    // Cycle ready
+
+// ADXL343 registers
+#define ADXL343_REG_INT_SOURCE  0x30
+#define ADXL343_REG_DATAX0      0x32    // X/Y/Z little-endian, 6 bytes
+
+static Adafruit_NAU7802* g_nau = nullptr;
+static Adafruit_ADXL343* g_adxl = nullptr;
+
+// One sample transaction and its buffers (written by the bus worker). Two slots, so a
+// transaction that timed out can finish in the background while a fresh one runs.
+struct SamplerSlot {
+    I2CTransaction txn;
+    bool pending;           // Submitted, worker may still own the buffers
+    bool stale;             // Timed out - result is discarded once the worker finishes
+    uint8_t nau_ctrl;
+    uint8_t nau_adc[3];
+    uint8_t accel_int;
+    uint8_t accel_data[6];
+};
+
+static SamplerSlot g_slots[2];
+static SamplerSlot* g_current = nullptr;    // Slot the next sensorSamplerGet() collects
+
+void sensorSamplerInit(Adafruit_NAU7802* nau, Adafruit_ADXL343* adxl) {
+    g_nau = nau;
+    g_adxl = adxl;
+    memset(g_slots, 0, sizeof(g_slots));
+    g_current = nullptr;
+}
+
+// A slot the worker is done with (releases timed-out slots that have since completed)
+static SamplerSlot* freeSlot() {
+    for (SamplerSlot& slot : g_slots) {
+        if (slot.pending && slot.stale && slot.txn.done) {
+            slot.pending = false;
+            slot.stale = false;
+        }
+        if (!slot.pending) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void sensorSamplerRequest() {
+    if (g_current || !i2cBusIsReady() || (!g_nau && !g_adxl)) {
+        return;
+    }
+
+    SamplerSlot* slot = freeSlot();
+    if (!slot) {
+        return;     // Both transactions still stuck on the bus - Get reads blocking
+    }
+
+    i2cBusTransactionInit(slot->txn);
+    if (g_adxl) {
+        i2cBusAddRead(slot->txn, I2C_ADDR_ADXL343, ADXL343_REG_INT_SOURCE, &slot->accel_int, 1);
+        i2cBusAddRead(slot->txn, I2C_ADDR_ADXL343, ADXL343_REG_DATAX0, slot->accel_data, sizeof(slot->accel_data));
+    }
+    if (g_nau) {
+        // Control byte first: the ADC bytes belong to the conversion it flags
+        i2cBusAddRead(slot->txn, I2C_ADDR_NAU7802, NAU7802_REG_PU_CTRL, &slot->nau_ctrl, 1);
+        i2cBusAddRead(slot->txn, I2C_ADDR_NAU7802, NAU7802_REG_ADCO_B2, slot->nau_adc, sizeof(slot->nau_adc));
+    }
+
+    slot->pending = i2cBusSubmit(slot->txn);
+    if (slot->pending) {
+        g_current = slot;
+    }
+}
+
+// Blocking fallback through the Adafruit drivers / Wire
+static void sensorSamplerReadBlocking(SensorSample& sample) {
+    if (g_nau && g_nau->available()) {
+        sample.adc = g_nau->read();
+        sample.adc_fresh = true;
+    }
+
+    if (g_adxl) {
+        g_adxl->getXYZ(sample.accel_x, sample.accel_y, sample.accel_z);
+
+        Wire.beginTransmission(I2C_ADDR_ADXL343);
+        Wire.write(ADXL343_REG_INT_SOURCE);
+        Wire.endTransmission();
+        Wire.requestFrom((uint8_t)I2C_ADDR_ADXL343, (uint8_t)1);
+        sample.int_source = Wire.read();
+    }
+}
+
+bool sensorSamplerGet(SensorSample& sample) {
+    memset(&sample, 0, sizeof(sample));
+
+    if (!g_nau && !g_adxl) {
+        return false;
+    }
+
+    sensorSamplerRequest();
+
+    bool ok = false;
+    SamplerSlot* slot = g_current;
+    if (slot) {
+        g_current = nullptr;
+        ok = i2cBusWait(slot->txn, I2C_BUS_TIMEOUT_MS * 2);
+        if (slot->txn.done) {
+            slot->pending = false;
+        } else {
+            // Its bytes would be old by the time it lands - never hand them out
+            slot->stale = true;
+        }
+    }
+
+    if (!ok) {
+        sensorSamplerReadBlocking(sample);
+        return true;
+    }
+
+    if (g_nau && (slot->nau_ctrl & NAU7802_PU_CTRL_CR)) {
+        uint32_t raw = ((uint32_t)slot->nau_adc[0] << 16) | ((uint32_t)slot->nau_adc[1] << 8) | slot->nau_adc[2];
+        if (raw & 0x800000) {
+            raw |= 0xFF000000;  // Sign-extend 24-bit
+        }
+        sample.adc = (int32_t)raw;
+        sample.adc_fresh = true;
+    }
+
+    if (g_adxl) {
+        sample.accel_x = (int16_t)((slot->accel_data[1] << 8) | slot->accel_data[0]);
+        sample.accel_y = (int16_t)((slot->accel_data[3] << 8) | slot->accel_data[2]);
+        sample.accel_z = (int16_t)((slot->accel_data[5] << 8) | slot->accel_data[4]);
+        sample.int_source = slot->accel_int;
+    }
+
+    return true;
+}
@@ -11,7 +11,27 @@
 #include "drinks.h"
 #include "storage_drinks.h"
 #include "weight.h"
+#include "device_context.h"
+#include "display.h"
 #include "config.h"
+#if ENABLE_BLE
+#include "ble_service.h"
+#endif
+#if ENABLE_TRACE_RECORDER
+#include "trace_recorder.h"
+#endif
+#if ENABLE_BOOT_PROFILE
+#include "boot_profile.h"
+#endif
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
+#if ENABLE_SLEEP_SCHEDULER
+#include "sleep_scheduler.h"
+#endif
+#if ENABLE_LOOP_PROFILER
+#include "loop_profiler.h"
+#endif
 #include <Preferences.h>
 #include <sys/time.h>
 #include <time.h>
@@ -601,6 +621,72 @@ static void handleDumpDrinks() {
     Serial.println();
 }
 
+#if ENABLE_TRACE_RECORDER
+// Handle TRACE ON / TRACE OFF commands - enable/disable sensor trace recording
+static void handleTraceEnable(bool enabled) {
+    if (!traceRecorderSetEnabled(enabled)) {
+        Serial.println("ERROR: Failed to change trace recording");
+        return;
+    }
+    Serial.printf("OK: Trace recording %s\n", enabled ? "enabled" : "disabled");
+}
+
+// Handle TRACE STATUS command - show recorder state and ring usage
+static void handleTraceStatus() {
+    uint32_t frames = traceRecorderGetFrameCount();
+    Serial.println("\n=== TRACE RECORDER ===");
+    Serial.printf("Recording: %s\n", traceRecorderIsEnabled() ? "ON" : "OFF");
+    Serial.printf("Frames stored: %u / %u\n", frames, (uint32_t)TRACE_MAX_FRAMES);
+    Serial.printf("Frame size: %u bytes, %u frames per %u byte block\n",
+                  (uint32_t)sizeof(TraceFrame), (uint32_t)TRACE_FRAMES_PER_BLOCK, TRACE_BLOCK_SIZE);
+    Serial.println("======================\n");
+}
+
+// Handle TRACE CLEAR command - erase the trace ring
+static void handleTraceClear() {
+    if (traceRecorderClear()) {
+        Serial.println("OK: Trace cleared");
+    }
+}
+
+// Handle DUMP TRACE command - print all frames as CSV (oldest first)
+// Output is bracketed by BEGIN/END markers so host tools can capture it from a log
+static void handleDumpTrace() {
+    uint32_t total = traceRecorderGetFrameCount();
+
+    Serial.printf("=== TRACE BEGIN frames=%u version=%u ===\n", total, TRACE_FORMAT_VERSION);
+
+    // Calibration lets the host replay harness convert ADC to ml like the bottle did
+    extern bool g_calibrated;
+    extern CalibrationData g_calibration;
+    if (g_calibrated) {
+        Serial.printf("# calibration scale_factor=%.4f empty_adc=%d\n",
+                      g_calibration.scale_factor, g_calibration.empty_bottle_adc);
+    }
+    Serial.println("timestamp_ms,adc,baseline_adc,accel_x,accel_y,accel_z,gesture,flags");
+
+    TraceFrame frames[16];
+    uint32_t index = 0;
+    while (index < total) {
+        uint16_t count = traceRecorderReadFrames(index, frames, 16);
+        if (count == 0) {
+            Serial.println("ERROR: Trace read failed");
+            break;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            const TraceFrame& f = frames[i];
+            Serial.printf("%u,%d,%d,%d,%d,%d,%u,0x%02X\n",
+                          f.timestamp_ms, f.adc, f.baseline_adc,
+                          f.accel_x, f.accel_y, f.accel_z,
+                          f.gesture, f.flags);
+        }
+        index += count;
+    }
+
+    Serial.println("=== TRACE END ===");
+}
+#endif // ENABLE_TRACE_RECORDER
+
 // Handle RESET DAILY INTAKE command - reset daily counter
 static void handleResetDailyIntake() {
     drinksResetDaily();
@@ -798,6 +884,10 @@ static void handleTare() {
                 Serial.printf("Updated scale factor: %.2f counts/g\n", cal.scale_factor);
             }
 
+#if ENABLE_BLE
+            bleLoadBottleConfig();
+#endif
+
             // Force display refresh to show updated water level
             extern void forceDisplayRefresh();
             forceDisplayRefresh();
@@ -815,6 +905,10 @@ static void handleTare() {
             Serial.printf("Tare ADC: %d\n", cal.empty_bottle_adc);
             Serial.println("Note: Full calibration still required (SET FULL BOTTLE)");
 
+#if ENABLE_BLE
+            bleLoadBottleConfig();
+#endif
+
             // Force display refresh to show updated water level
             extern void forceDisplayRefresh();
             forceDisplayRefresh();
@@ -864,6 +958,13 @@ static void handleGetLowBattery() {
     Serial.println("==========================\n");
 }
 
+#if ENABLE_ENERGY_LEDGER
+// Handle GET ENERGY command
+static void handleGetEnergy() {
+    energyLedgerPrint(deviceContextBatteryPercent());
+}
+#endif
+
 // Handle GET STATUS command - show all system status
 static void handleGetStatus() {
     extern bool g_calibrated;
@@ -890,11 +991,8 @@ static void handleGetStatus() {
         Serial.println(g_timezone_offset);
 
         // Show current time
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        time_t now = tv.tv_sec + (g_timezone_offset * 3600);
         struct tm timeinfo;
-        gmtime_r(&now, &timeinfo);
+        deviceContextLocalTime(timeinfo);
         Serial.printf("Current time: %04d-%02d-%02d %02d:%02d:%02d\n",
                      timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
                      timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
@@ -1175,6 +1273,18 @@ static void processCommand(char* cmd) {
             handleTare();
             return;
         }
+#if ENABLE_LOOP_PROFILER
+        const char* pattern2[] = {"PROFILE"};
+        if (matchWordsPrefix(words, word_count, pattern2, 1)) {
+            if (word_count >= 2 && strcmp(words[1], "RESET") == 0) {
+                loopProfilerReset();
+                Serial.println("Loop profile cleared");
+            } else {
+                loopProfilerPrint();
+            }
+            return;
+        }
+#endif
     }
 
     // Two-word commands (check if first 2 words match, even if more words present for arguments)
@@ -1229,6 +1339,59 @@ static void processCommand(char* cmd) {
             handleSetTimezone(reconstructArgs(words, word_count, 2, args));
             return;
         }
+#if ENABLE_TRACE_RECORDER
+        const char* pattern10[] = {"TRACE", "ON"};
+        if (matchWordsPrefix(words, word_count, pattern10, 2)) {
+            handleTraceEnable(true);
+            return;
+        }
+        const char* pattern11[] = {"TRACE", "OFF"};
+        if (matchWordsPrefix(words, word_count, pattern11, 2)) {
+            handleTraceEnable(false);
+            return;
+        }
+        const char* pattern12[] = {"TRACE", "STATUS"};
+        if (matchWordsPrefix(words, word_count, pattern12, 2)) {
+            handleTraceStatus();
+            return;
+        }
+        const char* pattern13[] = {"TRACE", "CLEAR"};
+        if (matchWordsPrefix(words, word_count, pattern13, 2)) {
+            handleTraceClear();
+            return;
+        }
+        const char* pattern14[] = {"DUMP", "TRACE"};
+        if (matchWordsPrefix(words, word_count, pattern14, 2)) {
+            handleDumpTrace();
+            return;
+        }
+#endif
+#if ENABLE_BOOT_PROFILE
+        const char* pattern15[] = {"BOOT", "PROFILE"};
+        if (matchWordsPrefix(words, word_count, pattern15, 2)) {
+            bootProfilePrint();
+            return;
+        }
+#endif
+#if ENABLE_ENERGY_LEDGER
+        const char* pattern16[] = {"GET", "ENERGY"};
+        if (matchWordsPrefix(words, word_count, pattern16, 2)) {
+            handleGetEnergy();
+            return;
+        }
+#endif
+#if ENABLE_SLEEP_SCHEDULER
+        const char* pattern17[] = {"GET", "SCHEDULE"};
+        if (matchWordsPrefix(words, word_count, pattern17, 2)) {
+            sleepSchedulerPrint();
+            return;
+        }
+#endif
+        const char* pattern18[] = {"GET", "REFRESHES"};
+        if (matchWordsPrefix(words, word_count, pattern18, 2)) {
+            displayRefreshStatsPrint();
+            return;
+        }
     }
     
     // Three-word commands (check if first 3 words match, even if more words present for arguments)
@@ -1320,8 +1483,28 @@ static void processCommand(char* cmd) {
     Serial.println("  SET EXTENDED SLEEP THRESHOLD sec - Awake threshold for extended mode (default=120)");
     Serial.println("  SET BATTERY LOCKOUT THRESHOLD pct - Low battery lockout (5-95, default=20)");
     Serial.println("  GET BATTERY                   - Show low battery lockout status");
+#if ENABLE_TRACE_RECORDER
+    Serial.println("\nSensor Trace:");
+    Serial.println("  TRACE ON | TRACE OFF  - Enable/disable binary sensor trace (persisted)");
+    Serial.println("  TRACE STATUS          - Show trace ring usage");
+    Serial.println("  DUMP TRACE            - Print all trace frames as CSV");
+    Serial.println("  TRACE CLEAR           - Erase trace ring");
+#endif
     Serial.println("\nSystem Status:");
     Serial.println("  GET STATUS            - Show all system status and settings");
+#if ENABLE_BOOT_PROFILE
+    Serial.println("  BOOT PROFILE          - Boot phase timings (min/avg/max, last wakes)");
+#endif
+#if ENABLE_ENERGY_LEDGER
+    Serial.println("  GET ENERGY            - Energy ledger: mAh/day, days remaining, per-state use");
+#endif
+#if ENABLE_SLEEP_SCHEDULER
+    Serial.println("  GET SCHEDULE          - Learned per-hour usage model and current sleep timeouts");
+#endif
+    Serial.println("  GET REFRESHES         - Display refresh budget and refreshes per day");
+#if ENABLE_LOOP_PROFILER
+    Serial.println("  PROFILE [RESET]       - loop() stage timing histograms and period jitter (since wake)");
+#endif
 }
 
 // Update serial command handler (call in loop())
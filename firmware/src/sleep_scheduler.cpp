@@ -0,0 +1,427 @@
+// sleep_scheduler.cpp - Learned usage-pattern sleep scheduler
+// Part of the Aquavate smart water bottle firmware
+
+#include "sleep_scheduler.h"
+
+#if ENABLE_SLEEP_SCHEDULER
+
+#include "activity_stats.h"
+#include "app_tasks.h"
+#include "drinks.h"
+#include "storage_drinks.h"
+#include <math.h>
+
+extern bool g_time_valid;
+
+#define RTC_MAGIC_SCHEDULER     0x53434844  // "SCHD"
+#define SCHED_HOURS             24
+#define SCHED_ONE               16          // Fixed-point 1.0 for hourly counts
+#define SCHED_MAX_DECAY_DAYS    60
+#define SCHED_SEED_MAX_AGE_DAYS 30
+#define SCHED_MIN_VALID_TIME    1600000000  // Earlier timestamps were taken without valid time
+
+// RTC model - survives deep sleep, lost on power cycle (re-seeded from drink records)
+// Counts are decayed fixed point (SCHED_ONE = one event), indexed by local hour
+struct SchedulerRtc {
+    uint32_t magic;
+    uint16_t drinks[SCHED_HOURS];       // Drink records created in the hour
+    uint16_t wakes[SCHED_HOURS];        // Motion/placement wakes starting in the hour
+    uint16_t sleeps[SCHED_HOURS];       // Normal sleeps entered in the hour
+    uint16_t repickups[SCHED_HOURS];    // ... followed by a wake within SCHED_REPICKUP_WINDOW_SEC
+    uint16_t connects[SCHED_HOURS];     // Wakes with a phone connection (hour of connection)
+    uint16_t sync_windows[SCHED_HOURS]; // Wakes that held the sync window open (hour of sleep)
+    uint16_t sync_hits[SCHED_HOURS];    // ... in which the phone connected
+    uint32_t last_day;                  // Local day of the last decay (0 = no valid time yet)
+    uint32_t last_event_ts;             // Newest MotionWakeEvent folded into the model
+    uint32_t last_sleep_end;            // Local time the last normal sleep began (0 = none)
+    uint16_t days_observed;
+    bool     sync_wake_pending;         // Current timer wake was aimed at a sync window
+};
+RTC_DATA_ATTR static SchedulerRtc rtc_sched;
+
+static bool g_connected_this_wake = false;
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t hourOf(uint32_t local_ts) {
+    return (local_ts % 86400) / 3600;
+}
+
+// Caller holds g_mux
+static void bump(uint16_t* counts, uint8_t hour) {
+    uint32_t v = counts[hour] + SCHED_ONE;
+    counts[hour] = (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+}
+
+// Caller holds g_mux
+static void decayAll(uint32_t days) {
+    float factor = powf(SCHED_DECAY_PER_DAY, (float)days);
+    uint16_t* arrays[] = { rtc_sched.drinks, rtc_sched.wakes, rtc_sched.sleeps, rtc_sched.repickups,
+                           rtc_sched.connects, rtc_sched.sync_windows, rtc_sched.sync_hits };
+    for (uint16_t* counts : arrays) {
+        for (uint8_t h = 0; h < SCHED_HOURS; h++) {
+            counts[h] = (uint16_t)(counts[h] * factor);
+        }
+    }
+}
+
+// Sum of the decay weights over the observed days (one event/day reaches this)
+static float effectiveDays() {
+    uint16_t days = rtc_sched.days_observed;
+    if (days > SCHED_MAX_DECAY_DAYS) days = SCHED_MAX_DECAY_DAYS;
+    return (1.0f - powf(SCHED_DECAY_PER_DAY, (float)days)) / (1.0f - SCHED_DECAY_PER_DAY);
+}
+
+static float perDay(const uint16_t* counts, uint8_t hour) {
+    return counts[hour] / (SCHED_ONE * effectiveDays());
+}
+
+// Neighbouring hours count half - usage doesn't stop at the hour boundary
+static float smoothedPerDay(const uint16_t* counts, uint8_t hour) {
+    return 0.5f * perDay(counts, hour) +
+           0.25f * perDay(counts, (hour + SCHED_HOURS - 1) % SCHED_HOURS) +
+           0.25f * perDay(counts, (hour + 1) % SCHED_HOURS);
+}
+
+static bool ratio(const uint16_t* num, const uint16_t* den, uint8_t hour, float& out) {
+    if (den[hour] < SCHED_MIN_SAMPLES * SCHED_ONE) {
+        return false;
+    }
+    out = (float)num[hour] / den[hour];
+    return true;
+}
+
+// Model is trusted for decisions in the current hour
+static bool modelReady(uint8_t& hour) {
+    if (!g_time_valid || rtc_sched.magic != RTC_MAGIC_SCHEDULER ||
+        rtc_sched.days_observed < SCHED_MIN_DAYS) {
+        return false;
+    }
+    hour = hourOf(getCurrentUnixTime());
+    return true;
+}
+
+// Nothing usually happens in this hour (and the phone doesn't connect in it)
+static bool isIdleHour(uint8_t hour) {
+    float events = smoothedPerDay(rtc_sched.wakes, hour) + smoothedPerDay(rtc_sched.drinks, hour);
+    return events < SCHED_IDLE_EVENTS_PER_DAY &&
+           smoothedPerDay(rtc_sched.connects, hour) < SCHED_SYNC_LIKELY_PER_DAY;
+}
+
+// Rebuild drink counts from LittleFS after a power cycle (storage task)
+static void seedFromDrinkRecordsJob(void* arg) {
+    (void)arg;
+
+    CircularBufferMetadata meta;
+    if (!storageLoadBufferMetadata(meta) || meta.record_count == 0) {
+        return;
+    }
+
+    float counts[SCHED_HOURS] = {};
+    uint32_t ref_day = 0;
+    uint32_t oldest_day = 0;
+    uint16_t seeded = 0;
+    uint16_t n = (meta.record_count < SCHED_SEED_MAX_RECORDS) ? meta.record_count : SCHED_SEED_MAX_RECORDS;
+
+    // Newest first, weighted by age like the daily decay would have
+    for (uint16_t i = 0; i < n; i++) {
+        DrinkRecord record;
+        if (!storageGetDrinkRecord(meta.record_count - 1 - i, record)) {
+            break;
+        }
+        if (record.timestamp < SCHED_MIN_VALID_TIME || (record.flags & 0x04) || record.amount_ml <= 0) {
+            continue;  // No valid time, deleted, or a refill
+        }
+
+        uint32_t day = record.timestamp / 86400;
+        if (ref_day == 0) {
+            uint32_t today = g_time_valid ? getCurrentUnixTime() / 86400 : 0;
+            ref_day = (today > day) ? today : day;
+        }
+        if (day > ref_day) {
+            continue;
+        }
+        uint32_t age = ref_day - day;
+        if (age > SCHED_SEED_MAX_AGE_DAYS) {
+            break;
+        }
+
+        counts[hourOf(record.timestamp)] += SCHED_ONE * powf(SCHED_DECAY_PER_DAY, (float)age);
+        oldest_day = day;
+        seeded++;
+    }
+
+    if (seeded == 0) {
+        return;
+    }
+
+    uint32_t span = ref_day - oldest_day + 1;
+    taskENTER_CRITICAL(&g_mux);
+    for (uint8_t h = 0; h < SCHED_HOURS; h++) {
+        uint32_t v = rtc_sched.drinks[h] + (uint32_t)counts[h];
+        rtc_sched.drinks[h] = (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+    }
+    if (span > rtc_sched.days_observed) {
+        rtc_sched.days_observed = (uint16_t)span;
+    }
+    taskEXIT_CRITICAL(&g_mux);
+
+    Serial.printf("Scheduler: seeded from %u drink records over %lu days\n",
+                  seeded, (unsigned long)span);
+}
+
+void sleepSchedulerInit() {
+    g_connected_this_wake = false;
+
+    if (rtc_sched.magic != RTC_MAGIC_SCHEDULER) {
+        memset(&rtc_sched, 0, sizeof(rtc_sched));
+        rtc_sched.magic = RTC_MAGIC_SCHEDULER;
+        Serial.println("Scheduler: model reset (power cycle) - seeding from drink records");
+
+        if (!appTasksQueueStorageJob(seedFromDrinkRecordsJob, nullptr)) {
+            seedFromDrinkRecordsJob(nullptr);
+        }
+    }
+
+    if (!g_time_valid) {
+        return;
+    }
+
+    // Daily decay (whole days since the last wake with valid time)
+    uint32_t today = getCurrentUnixTime() / 86400;
+    taskENTER_CRITICAL(&g_mux);
+    if (rtc_sched.last_day == 0) {
+        if (rtc_sched.days_observed == 0) {
+            rtc_sched.days_observed = 1;
+        }
+    } else if (today > rtc_sched.last_day) {
+        uint32_t elapsed = today - rtc_sched.last_day;
+        decayAll(elapsed < SCHED_MAX_DECAY_DAYS ? elapsed : SCHED_MAX_DECAY_DAYS);
+        uint32_t days = rtc_sched.days_observed + elapsed;
+        rtc_sched.days_observed = (days > UINT16_MAX) ? UINT16_MAX : (uint16_t)days;
+    }
+    rtc_sched.last_day = today;
+    taskEXIT_CRITICAL(&g_mux);
+}
+
+void sleepSchedulerRecordSleep(bool sync_window_held) {
+    if (rtc_sched.magic != RTC_MAGIC_SCHEDULER) {
+        return;
+    }
+
+    // Oldest first; only events newer than the last call are new
+    static MotionWakeEvent events[MOTION_WAKE_MAX_COUNT];
+    uint8_t count = activityStatsGetMotionEvents(events, MOTION_WAKE_MAX_COUNT);
+    uint8_t hour_now = (sync_window_held && g_time_valid) ? hourOf(getCurrentUnixTime()) : 0;
+
+    taskENTER_CRITICAL(&g_mux);
+    for (uint8_t i = 0; i < count; i++) {
+        const MotionWakeEvent& event = events[i];
+        if (event.timestamp < SCHED_MIN_VALID_TIME || event.timestamp <= rtc_sched.last_event_ts) {
+            continue;
+        }
+        rtc_sched.last_event_ts = event.timestamp;
+
+        if (event.wake_reason == WAKE_REASON_MOTION) {
+            bump(rtc_sched.wakes, hourOf(event.timestamp));
+
+            // Set straight back down after the previous sleep?
+            if (rtc_sched.last_sleep_end != 0 && event.timestamp >= rtc_sched.last_sleep_end &&
+                event.timestamp - rtc_sched.last_sleep_end <= SCHED_REPICKUP_WINDOW_SEC) {
+                bump(rtc_sched.repickups, hourOf(rtc_sched.last_sleep_end));
+            }
+        }
+
+        // Only a normal (motion wake) sleep can be followed by a re-pick-up
+        rtc_sched.last_sleep_end = 0;
+        if ((event.sleep_type & SLEEP_TYPE_MASK) == SLEEP_TYPE_NORMAL) {
+            uint32_t sleep_start = event.timestamp + event.duration_sec;
+            bump(rtc_sched.sleeps, hourOf(sleep_start));
+            rtc_sched.last_sleep_end = sleep_start;
+        }
+    }
+
+    if (sync_window_held && g_time_valid) {
+        bump(rtc_sched.sync_windows, hour_now);
+        if (g_connected_this_wake) {
+            bump(rtc_sched.sync_hits, hour_now);
+        }
+    }
+    taskEXIT_CRITICAL(&g_mux);
+}
+
+void sleepSchedulerRecordDrink(uint32_t timestamp) {
+    if (rtc_sched.magic != RTC_MAGIC_SCHEDULER || timestamp < SCHED_MIN_VALID_TIME) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&g_mux);
+    bump(rtc_sched.drinks, hourOf(timestamp));
+    taskEXIT_CRITICAL(&g_mux);
+}
+
+void sleepSchedulerRecordConnect() {
+    if (g_connected_this_wake || rtc_sched.magic != RTC_MAGIC_SCHEDULER || !g_time_valid) {
+        return;
+    }
+    g_connected_this_wake = true;
+
+    uint8_t hour = hourOf(getCurrentUnixTime());
+    taskENTER_CRITICAL(&g_mux);
+    bump(rtc_sched.connects, hour);
+    taskEXIT_CRITICAL(&g_mux);
+}
+
+uint32_t sleepSchedulerActivityTimeoutMs(uint32_t base_ms) {
+    uint8_t hour;
+    if (base_ms == 0 || !modelReady(hour)) {
+        return base_ms;
+    }
+
+    // Usually set straight back down: stay up through the gap rather than sleep,
+    // wake and redraw again (and keep advertising for the phone meanwhile)
+    float repickup;
+    if (ratio(rtc_sched.repickups, rtc_sched.sleeps, hour, repickup) &&
+        repickup >= SCHED_REPICKUP_LIKELY) {
+        uint32_t longer = base_ms + SCHED_REPICKUP_WINDOW_SEC * 1000UL;
+        if (longer > ACTIVITY_TIMEOUT_MAX_MS) longer = ACTIVITY_TIMEOUT_MAX_MS;
+        return (longer > base_ms) ? longer : base_ms;
+    }
+
+    if (isIdleHour(hour)) {
+        uint32_t shorter = base_ms / 2;
+        if (shorter < ACTIVITY_TIMEOUT_MIN_MS) shorter = ACTIVITY_TIMEOUT_MIN_MS;
+        return (shorter < base_ms) ? shorter : base_ms;
+    }
+
+    return base_ms;
+}
+
+uint32_t sleepSchedulerSyncTimeoutMs(uint32_t base_ms) {
+    uint8_t hour;
+    if (!modelReady(hour)) {
+        return base_ms;
+    }
+
+    // Only cut where held windows keep going unused and the phone doesn't connect
+    // in this hour at all - any connection (e.g. app opened) restores the full window
+    float hits;
+    if (ratio(rtc_sched.sync_hits, rtc_sched.sync_windows, hour, hits) &&
+        hits < SCHED_SYNC_UNLIKELY &&
+        smoothedPerDay(rtc_sched.connects, hour) < SCHED_SYNC_LIKELY_PER_DAY) {
+        uint32_t shorter = base_ms / 4;
+        if (shorter < ACTIVITY_TIMEOUT_SYNC_MIN_MS) shorter = ACTIVITY_TIMEOUT_SYNC_MIN_MS;
+        return (shorter < base_ms) ? shorter : base_ms;
+    }
+
+    return base_ms;
+}
+
+uint32_t sleepSchedulerBackpackThresholdSec(uint32_t base_sec) {
+    uint8_t hour;
+    if (!modelReady(hour)) {
+        return base_sec;
+    }
+
+    // Drinking hours: carried around between sips, don't drop into backpack mode early
+    if (smoothedPerDay(rtc_sched.drinks, hour) >= SCHED_ACTIVE_DRINKS_PER_DAY) {
+        uint32_t longer = base_sec * 3 / 2;
+        if (longer > TIME_SINCE_STABLE_MAX_SEC) longer = TIME_SINCE_STABLE_MAX_SEC;
+        return (longer > base_sec) ? longer : base_sec;
+    }
+
+    if (isIdleHour(hour)) {
+        uint32_t shorter = base_sec / 2;
+        if (shorter < TIME_SINCE_STABLE_MIN_SEC) shorter = TIME_SINCE_STABLE_MIN_SEC;
+        return (shorter < base_sec) ? shorter : base_sec;
+    }
+
+    return base_sec;
+}
+
+bool sleepSchedulerPlanExtendedWake(uint32_t max_sec, bool unsynced_pending, uint32_t& out_sec) {
+    out_sec = max_sec;
+    rtc_sched.sync_wake_pending = false;
+
+    uint8_t hour;
+    if (!unsynced_pending || !modelReady(hour)) {
+        return false;
+    }
+
+    // First upcoming hour (not this one) the phone usually connects in
+    uint32_t to_next_hour = 3600 - (getCurrentUnixTime() % 3600);
+    for (uint8_t k = 0; k < SCHED_HOURS; k++) {
+        uint32_t wait_sec = to_next_hour + k * 3600UL + SCHED_SYNC_WAKE_OFFSET_SEC;
+        if (wait_sec >= max_sec) {
+            break;
+        }
+
+        uint8_t target = (hour + 1 + k) % SCHED_HOURS;
+        if (perDay(rtc_sched.connects, target) >= SCHED_SYNC_LIKELY_PER_DAY) {
+            out_sec = wait_sec;
+            rtc_sched.sync_wake_pending = true;
+            Serial.printf("Scheduler: timer wake aimed at %02d:%02d sync window (%lus)\n",
+                          target, SCHED_SYNC_WAKE_OFFSET_SEC / 60, (unsigned long)wait_sec);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool sleepSchedulerTakeSyncWake() {
+    if (rtc_sched.magic != RTC_MAGIC_SCHEDULER || !rtc_sched.sync_wake_pending) {
+        return false;
+    }
+
+    rtc_sched.sync_wake_pending = false;
+    return true;
+}
+
+void sleepSchedulerPrint() {
+    Serial.println("\n=== SLEEP SCHEDULER ===");
+    if (rtc_sched.magic != RTC_MAGIC_SCHEDULER) {
+        Serial.println("Model not initialized");
+        Serial.println("=======================\n");
+        return;
+    }
+
+    uint8_t now_hour = 0;
+    bool ready = modelReady(now_hour);
+    if (ready) {
+        Serial.printf("Days observed: %u (adapting)\n", rtc_sched.days_observed);
+    } else if (g_time_valid) {
+        Serial.printf("Days observed: %u (adapting after %d days)\n", rtc_sched.days_observed, SCHED_MIN_DAYS);
+    } else {
+        Serial.printf("Days observed: %u (not adapting - time not set)\n", rtc_sched.days_observed);
+    }
+
+    // '-' = too few samples in the hour for the ratio
+    Serial.println("  hour  drinks/d  wakes/d  repick%  conn/d  synchit%");
+    for (uint8_t h = 0; h < SCHED_HOURS; h++) {
+        char repick_str[8] = "    -";
+        char hits_str[8] = "    -";
+        float value;
+        if (ratio(rtc_sched.repickups, rtc_sched.sleeps, h, value)) {
+            snprintf(repick_str, sizeof(repick_str), "%5.0f", value * 100.0f);
+        }
+        if (ratio(rtc_sched.sync_hits, rtc_sched.sync_windows, h, value)) {
+            snprintf(hits_str, sizeof(hits_str), "%5.0f", value * 100.0f);
+        }
+        Serial.printf("  %02d%c   %6.2f   %6.2f   %s   %6.2f   %s\n", h,
+                      (ready && h == now_hour) ? '*' : ' ',
+                      perDay(rtc_sched.drinks, h), perDay(rtc_sched.wakes, h),
+                      repick_str, perDay(rtc_sched.connects, h), hits_str);
+    }
+
+    if (ready) {
+        extern uint32_t g_sleep_timeout_ms;
+        extern uint32_t g_time_since_stable_threshold_sec;
+        Serial.printf("Now (%02d:00): activity %lus, sync window %lus, backpack %lus\n", now_hour,
+                      (unsigned long)(sleepSchedulerActivityTimeoutMs(g_sleep_timeout_ms) / 1000),
+                      (unsigned long)(sleepSchedulerSyncTimeoutMs(ACTIVITY_TIMEOUT_EXTENDED_MS) / 1000),
+                      (unsigned long)sleepSchedulerBackpackThresholdSec(g_time_since_stable_threshold_sec));
+    }
+    Serial.println("=======================\n");
+}
+
+#endif // ENABLE_SLEEP_SCHEDULER
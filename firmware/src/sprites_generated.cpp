@@ -0,0 +1,308 @@
+// sprites_generated.cpp - Pre-rendered main-screen sprites
+// Part of the Aquavate smart water bottle firmware
+//
+// GENERATED by scripts/gen_sprites.py - do not edit.
+
+#include "sprites.h"
+
+static const uint8_t SPRITE_BOTTLE_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0x00,
+    0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00,
+    0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80,
+    0x00, 0x3F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x3F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xFF, 0xF0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x3F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x3F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80,
+    0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00,
+    0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0x00,
+};
+const RasterSprite SPRITE_BOTTLE = { SPRITE_BOTTLE_DATA, 40, 90, 12 };
+
+static const uint8_t SPRITE_FIGURE_OUTLINE_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFE, 0x3C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xE0, 0x1E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0x80, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0xF8, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0xE0, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x07, 0x80, 0x00, 0x03, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x3F, 0xC0, 0x00, 0xFF, 0xF8, 0x00,
+    0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00,
+    0x00, 0x3F, 0x00, 0x1C, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x01, 0xFF, 0xE0, 0x1C, 0x00, 0x00, 0xFF, 0xFF, 0xFE, 0x00, 0x07, 0x80,
+    0x03, 0xFF, 0xF0, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x0F, 0xC1, 0xFC, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0,
+    0x1F, 0x00, 0x3E, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0,
+    0x1E, 0x00, 0x1E, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0,
+    0x3C, 0x00, 0x0F, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x78, 0x00, 0x07, 0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x80,
+    0x70, 0x00, 0x03, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x80,
+    0x70, 0x00, 0x03, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00,
+    0xE0, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFC, 0x00,
+    0xE0, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xE0, 0x00,
+    0xE0, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFC, 0x00, 0x00,
+    0xE0, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFC, 0x00, 0x00,
+    0xE0, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xE0, 0x00,
+    0xE0, 0x00, 0x03, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFC, 0x00,
+    0x70, 0x00, 0x03, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x00,
+    0x70, 0x00, 0x03, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x80,
+    0x78, 0x00, 0x07, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x3C, 0x00, 0x0F, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC0,
+    0x1E, 0x00, 0x1E, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0,
+    0x1F, 0x00, 0x3C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0,
+    0x07, 0xE1, 0xF8, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC0,
+    0x03, 0xFF, 0xF0, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80,
+    0x00, 0xFF, 0xC0, 0x1C, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xE0, 0x0F, 0x80,
+    0x00, 0x1E, 0x00, 0x1C, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00,
+    0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x3F, 0xC0, 0x00, 0x07, 0xF0, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x07, 0x80, 0x00, 0x01, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0xE0, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0xFC, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0x80, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0xF8, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xF0, 0x1E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x3C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+};
+const RasterSprite SPRITE_FIGURE_OUTLINE = { SPRITE_FIGURE_OUTLINE_DATA, 54, 90, 12 };
+
+static const uint8_t SPRITE_FIGURE_FILLED_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0xFF, 0xF8, 0x00,
+    0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00,
+    0x00, 0x3F, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x01, 0xFF, 0xE0, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x03, 0xFF, 0xF0, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x0F, 0xFF, 0xFC, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x1F, 0xFF, 0xFE, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x1F, 0xFF, 0xFE, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x3F, 0xFF, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x7F, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x7F, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x7F, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00,
+    0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x00,
+    0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x00,
+    0xFF, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00,
+    0x7F, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x7F, 0xFF, 0xFF, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x7F, 0xFF, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x3F, 0xFF, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x1F, 0xFF, 0xFE, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x1F, 0xFF, 0xFC, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x07, 0xFF, 0xF8, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0,
+    0x03, 0xFF, 0xF0, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x00, 0xFF, 0xC0, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x00, 0x1E, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x07, 0xF0, 0x00,
+    0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+};
+const RasterSprite SPRITE_FIGURE_FILLED = { SPRITE_FIGURE_FILLED_DATA, 54, 90, 12 };
+
+static const uint8_t SPRITE_GLASS_EMPTY_DATA[] PROGMEM = {
+    0xE0, 0x00, 0x9F, 0x00, 0x80, 0xF8, 0x80, 0x07, 0x80, 0x01, 0x80, 0x01,
+    0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01,
+    0x80, 0x01, 0x80, 0x01, 0x80, 0x07, 0x80, 0xF8, 0x9F, 0x00, 0xE0, 0x00,
+};
+const RasterSprite SPRITE_GLASS_EMPTY = { SPRITE_GLASS_EMPTY_DATA, 18, 16, 2 };
+
+static const uint8_t SPRITE_GLASS_FULL_DATA[] PROGMEM = {
+    0xE0, 0x00, 0xFF, 0x00, 0xFF, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0xFF, 0x00, 0xE0, 0x00,
+};
+const RasterSprite SPRITE_GLASS_FULL = { SPRITE_GLASS_FULL_DATA, 18, 16, 2 };
+
+static const uint8_t SPRITE_TODAY_DATA[] PROGMEM = {
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0xFF, 0xF0, 0xFF, 0xF0,
+    0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x30, 0x0C, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0xF0, 0x03, 0xF0, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+    0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0xF0, 0x03, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0xF0, 0x03, 0xF0, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+    0x03, 0x30, 0x03, 0x30, 0xFF, 0xFC, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x30, 0x00, 0x30, 0x0C, 0xCC, 0x0C, 0xCC, 0x0C, 0xCC, 0x0C, 0xCC,
+    0x03, 0xFC, 0x03, 0xFC, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0x0C, 0x0F, 0x0C, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xC3,
+    0x00, 0xC3, 0x00, 0xC3, 0x0F, 0xFC, 0x0F, 0xFC,
+};
+const RasterSprite SPRITE_TODAY = { SPRITE_TODAY_DATA, 58, 16, 2 };
+
+static const uint8_t SPRITE_LARGE_0_DATA[] PROGMEM = {
+    0x1F, 0xFF, 0xC0, 0x1F, 0xFF, 0xC0, 0x1F, 0xFF, 0xC0, 0xE0, 0x0E, 0x38,
+    0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38,
+    0x1F, 0xFF, 0xC0, 0x1F, 0xFF, 0xC0, 0x1F, 0xFF, 0xC0,
+};
+const RasterSprite SPRITE_LARGE_0 = { SPRITE_LARGE_0_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_1_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x38,
+    0x1C, 0x00, 0x38, 0x1C, 0x00, 0x38, 0xFF, 0xFF, 0xF8, 0xFF, 0xFF, 0xF8,
+    0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+const RasterSprite SPRITE_LARGE_1 = { SPRITE_LARGE_1_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_2_DATA[] PROGMEM = {
+    0x1C, 0x0F, 0xF8, 0x1C, 0x0F, 0xF8, 0x1C, 0x0F, 0xF8, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0x1F, 0x80, 0x38, 0x1F, 0x80, 0x38, 0x1F, 0x80, 0x38,
+};
+const RasterSprite SPRITE_LARGE_2 = { SPRITE_LARGE_2_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_3_DATA[] PROGMEM = {
+    0xE0, 0x01, 0xC0, 0xE0, 0x01, 0xC0, 0xE0, 0x01, 0xC0, 0xE0, 0x00, 0x38,
+    0xE0, 0x00, 0x38, 0xE0, 0x00, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE3, 0xF0, 0x38, 0xE3, 0xF0, 0x38, 0xE3, 0xF0, 0x38,
+    0xFC, 0x0F, 0xC0, 0xFC, 0x0F, 0xC0, 0xFC, 0x0F, 0xC0,
+};
+const RasterSprite SPRITE_LARGE_3 = { SPRITE_LARGE_3_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_4_DATA[] PROGMEM = {
+    0x00, 0x7E, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x7E, 0x00, 0x03, 0x8E, 0x00,
+    0x03, 0x8E, 0x00, 0x03, 0x8E, 0x00, 0x1C, 0x0E, 0x00, 0x1C, 0x0E, 0x00,
+    0x1C, 0x0E, 0x00, 0xFF, 0xFF, 0xF8, 0xFF, 0xFF, 0xF8, 0xFF, 0xFF, 0xF8,
+    0x00, 0x0E, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x0E, 0x00,
+};
+const RasterSprite SPRITE_LARGE_4 = { SPRITE_LARGE_4_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_5_DATA[] PROGMEM = {
+    0xFF, 0x81, 0xC0, 0xFF, 0x81, 0xC0, 0xFF, 0x81, 0xC0, 0xE3, 0x80, 0x38,
+    0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38,
+    0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38, 0xE3, 0x80, 0x38,
+    0xE0, 0x7F, 0xC0, 0xE0, 0x7F, 0xC0, 0xE0, 0x7F, 0xC0,
+};
+const RasterSprite SPRITE_LARGE_5 = { SPRITE_LARGE_5_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_6_DATA[] PROGMEM = {
+    0x03, 0xFF, 0xC0, 0x03, 0xFF, 0xC0, 0x03, 0xFF, 0xC0, 0x1C, 0x70, 0x38,
+    0x1C, 0x70, 0x38, 0x1C, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x0F, 0xC0, 0xE0, 0x0F, 0xC0, 0xE0, 0x0F, 0xC0,
+};
+const RasterSprite SPRITE_LARGE_6 = { SPRITE_LARGE_6_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_7_DATA[] PROGMEM = {
+    0xE0, 0x00, 0x38, 0xE0, 0x00, 0x38, 0xE0, 0x00, 0x38, 0xE0, 0x01, 0xC0,
+    0xE0, 0x01, 0xC0, 0xE0, 0x01, 0xC0, 0xE0, 0x0E, 0x00, 0xE0, 0x0E, 0x00,
+    0xE0, 0x0E, 0x00, 0xE0, 0x70, 0x00, 0xE0, 0x70, 0x00, 0xE0, 0x70, 0x00,
+    0xFF, 0x80, 0x00, 0xFF, 0x80, 0x00, 0xFF, 0x80, 0x00,
+};
+const RasterSprite SPRITE_LARGE_7 = { SPRITE_LARGE_7_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_8_DATA[] PROGMEM = {
+    0x1F, 0x8F, 0xC0, 0x1F, 0x8F, 0xC0, 0x1F, 0x8F, 0xC0, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0x1F, 0x8F, 0xC0, 0x1F, 0x8F, 0xC0, 0x1F, 0x8F, 0xC0,
+};
+const RasterSprite SPRITE_LARGE_8 = { SPRITE_LARGE_8_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_9_DATA[] PROGMEM = {
+    0x1F, 0x80, 0x38, 0x1F, 0x80, 0x38, 0x1F, 0x80, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38, 0xE0, 0x70, 0x38,
+    0xE0, 0x70, 0x38, 0xE0, 0x71, 0xC0, 0xE0, 0x71, 0xC0, 0xE0, 0x71, 0xC0,
+    0x1F, 0xFE, 0x00, 0x1F, 0xFE, 0x00, 0x1F, 0xFE, 0x00,
+};
+const RasterSprite SPRITE_LARGE_9 = { SPRITE_LARGE_9_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_M_DATA[] PROGMEM = {
+    0x03, 0xFF, 0xF8, 0x03, 0xFF, 0xF8, 0x03, 0xFF, 0xF8, 0x03, 0x80, 0x00,
+    0x03, 0x80, 0x00, 0x03, 0x80, 0x00, 0x00, 0x7F, 0xF8, 0x00, 0x7F, 0xF8,
+    0x00, 0x7F, 0xF8, 0x03, 0x80, 0x00, 0x03, 0x80, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x7F, 0xF8, 0x00, 0x7F, 0xF8, 0x00, 0x7F, 0xF8,
+};
+const RasterSprite SPRITE_LARGE_M = { SPRITE_LARGE_M_DATA, 15, 24, 3 };
+
+static const uint8_t SPRITE_LARGE_L_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x38,
+    0xE0, 0x00, 0x38, 0xE0, 0x00, 0x38, 0xFF, 0xFF, 0xF8, 0xFF, 0xFF, 0xF8,
+    0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+const RasterSprite SPRITE_LARGE_L = { SPRITE_LARGE_L_DATA, 15, 24, 3 };
+
+const RasterSprite* spriteLargeGlyph(char c) {
+    switch (c) {
+        case '0': return &SPRITE_LARGE_0;
+        case '1': return &SPRITE_LARGE_1;
+        case '2': return &SPRITE_LARGE_2;
+        case '3': return &SPRITE_LARGE_3;
+        case '4': return &SPRITE_LARGE_4;
+        case '5': return &SPRITE_LARGE_5;
+        case '6': return &SPRITE_LARGE_6;
+        case '7': return &SPRITE_LARGE_7;
+        case '8': return &SPRITE_LARGE_8;
+        case '9': return &SPRITE_LARGE_9;
+        case 'm': return &SPRITE_LARGE_M;
+        case 'l': return &SPRITE_LARGE_L;
+        default: return nullptr;
+    }
+}
@@ -27,6 +27,7 @@ static const char* KEY_EXT_SLEEP_THR = "ext_sleep_thr";
 static const char* KEY_SHAKE_EMPTY_EN = "shake_empty_en";
 static const char* KEY_DAILY_GOAL = "daily_goal_ml";
 static const char* KEY_LOW_BAT_THR = "low_bat_thr";
+static const char* KEY_TRACE_EN = "trace_en";
 
 bool storageInit() {
     if (g_initialized) {
@@ -400,3 +401,25 @@ uint8_t storageLoadLowBatteryThreshold() {
     DEBUG_PRINTF(g_debug_calibration, "Storage: Loaded low_battery_threshold = %d%%\n", percent);
     return percent;
 }
+
+bool storageSaveTraceEnabled(bool enabled) {
+    if (!g_initialized) {
+        Serial.println("Storage: Not initialized");
+        return false;
+    }
+
+    g_preferences.putBool(KEY_TRACE_EN, enabled);
+    DEBUG_PRINTF(g_debug_calibration, "Storage: Saved trace_enabled = %s\n", enabled ? "true" : "false");
+    return true;
+}
+
+bool storageLoadTraceEnabled() {
+    if (!g_initialized) {
+        Serial.println("Storage: Not initialized, using default trace_enabled false");
+        return false; // Default: disabled
+    }
+
+    bool enabled = g_preferences.getBool(KEY_TRACE_EN, false); // Default: disabled
+    DEBUG_PRINTF(g_debug_calibration, "Storage: Loaded trace_enabled = %s\n", enabled ? "true" : "false");
+    return enabled;
+}
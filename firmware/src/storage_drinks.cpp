@@ -11,6 +11,9 @@
 #include <nvs_flash.h>
 #include "storage_drinks.h"
 #include "config.h"
+#if ENABLE_ENERGY_LEDGER
+#include "energy_ledger.h"
+#endif
 
 // External debug flag from main.cpp
 extern bool g_debug_drink_tracking;
@@ -117,6 +120,10 @@ bool storageSaveDrinkRecord(const DrinkRecord& record) {
         return false;
     }
 
+#if ENABLE_ENERGY_LEDGER
+    EnergyOverlayScope energy(ENERGY_OVERLAY_FLASH_WRITE);
+#endif
+
     // Load or initialize metadata
     CircularBufferMetadata meta;
     if (!storageLoadBufferMetadata(meta)) {
@@ -0,0 +1,393 @@
+// trace_recorder.cpp - Binary sensor trace recorder (LittleFS ring file)
+// Part of the Aquavate smart water bottle firmware
+//
+// File layout: TRACE_RING_BLOCKS fixed slots of TRACE_BLOCK_SIZE bytes.
+// Each slot = TraceBlockHeader + TRACE_FRAMES_PER_BLOCK frames. The slot with
+// the highest sequence is the newest; the next slot round the ring is the oldest.
+// The newest block is mirrored in RAM and only written when full, at sleep
+// entry, or before a dump, so a typical 30s wake costs one block write.
+// Full blocks are handed to the storage task (app_tasks) via a second buffer,
+// so the loop never waits on the write; flush/clear/read sync with it first.
+
+#include "config.h"
+
+#if ENABLE_TRACE_RECORDER
+
+#include <LittleFS.h>
+#include "trace_recorder.h"
+#include "storage.h"
+#include "drinks.h"
+#include "app_tasks.h"
+
+// External debug flag from main.cpp
+extern bool g_debug_drink_tracking;
+
+#define TRACE_FILE "/trace.bin"
+#define TRACE_SYNC_TIMEOUT_MS   1000    // Max wait for a deferred block write
+
+struct TraceBlock {
+    TraceBlockHeader header;
+    TraceFrame frames[TRACE_FRAMES_PER_BLOCK];
+};
+
+// Header + frames fill the slot exactly, so a block is written with no padding
+static_assert(sizeof(TraceBlock) == TRACE_BLOCK_SIZE, "TraceBlock must fill TRACE_BLOCK_SIZE");
+
+// RAM mirror of the block currently being filled
+static TraceBlock g_block;
+static uint8_t g_write_slot = 0;
+static bool g_block_dirty = false;
+
+// Full block waiting for / being written by the storage task
+static TraceBlock g_flush_block;
+static uint8_t g_flush_slot = 0;
+
+// Frame count of every flushed slot (0 = empty/invalid); write slot uses g_block
+static uint16_t g_slot_frames[TRACE_RING_BLOCKS];
+
+static bool g_initialized = false;
+static bool g_enabled = false;
+static bool g_session_started = false;
+static uint8_t g_pending_flags = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static size_t getSlotOffset(uint8_t slot) {
+    return (size_t)slot * TRACE_BLOCK_SIZE;
+}
+
+static void startBlock(uint8_t slot, uint32_t sequence) {
+    memset(&g_block, 0, sizeof(g_block));
+    g_block.header.magic = TRACE_BLOCK_MAGIC;
+    g_block.header.sequence = sequence;
+    g_block.header.frame_count = 0;
+    g_block.header.frame_size = sizeof(TraceFrame);
+    g_block.header.version = TRACE_FORMAT_VERSION;
+    g_write_slot = slot;
+    g_slot_frames[slot] = 0;  // Old contents of this slot are being overwritten
+    g_block_dirty = false;
+}
+
+static bool isValidHeader(const TraceBlockHeader& header) {
+    return header.magic == TRACE_BLOCK_MAGIC &&
+           header.version == TRACE_FORMAT_VERSION &&
+           header.frame_size == sizeof(TraceFrame) &&
+           header.frame_count <= TRACE_FRAMES_PER_BLOCK;
+}
+
+static File openTraceFileForWrite() {
+    File file = LittleFS.open(TRACE_FILE, "r+");
+    if (!file) {
+        // File doesn't exist, create it
+        file = LittleFS.open(TRACE_FILE, "w");
+        if (!file) {
+            return file;
+        }
+        file.close();
+        file = LittleFS.open(TRACE_FILE, "r+");
+    }
+    return file;
+}
+
+static bool writeBlock(const TraceBlock& block, uint8_t slot) {
+    File file = openTraceFileForWrite();
+    if (!file) {
+        Serial.println("ERROR: Failed to open trace file for writing");
+        return false;
+    }
+
+    // Slots are always filled in order, so the offset is at most the current EOF
+    size_t offset = getSlotOffset(slot);
+    if (!file.seek(offset)) {
+        Serial.printf("ERROR: Failed to seek trace file to offset %u\n", offset);
+        file.close();
+        return false;
+    }
+
+    // Write the whole slot (unused frames are zero) so later slots keep fixed offsets
+    const uint8_t* data = (const uint8_t*)&block;
+    size_t written = file.write(data, sizeof(TraceBlock));
+    file.close();
+
+    if (written != TRACE_BLOCK_SIZE) {
+        Serial.println("ERROR: Failed to write trace block");
+        return false;
+    }
+
+    DEBUG_PRINTF(g_debug_drink_tracking, "Trace: Block seq=%u written to slot %u (%u frames)\n",
+                 block.header.sequence, slot, block.header.frame_count);
+    return true;
+}
+
+// Storage task job: write the full block handed off by traceRecorderRecord()
+static void writeFlushBlockJob(void* arg) {
+    (void)arg;
+    writeBlock(g_flush_block, g_flush_slot);
+}
+
+// Hand the full block to the storage task and move to the next slot round the
+// ring. g_flush_block can only be reused once the previous hand-off is written:
+// if it isn't (wait = false: storage still busy, wait = true: timed out) the
+// full block stays in RAM and the hand-off is retried on the next frame.
+static bool handOffFullBlock(bool wait) {
+    bool idle = wait ? appTasksStorageSync(TRACE_SYNC_TIMEOUT_MS) : !appTasksStorageBusy();
+    if (!idle) {
+        return false;
+    }
+
+    memcpy(&g_flush_block, &g_block, sizeof(g_block));
+    g_flush_slot = g_write_slot;
+    if (!appTasksQueueStorageJob(writeFlushBlockJob, nullptr)) {
+        writeBlock(g_block, g_write_slot);
+    }
+    g_slot_frames[g_write_slot] = g_block.header.frame_count;
+    startBlock((g_write_slot + 1) % TRACE_RING_BLOCKS, g_block.header.sequence + 1);
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool traceRecorderInit() {
+    g_enabled = storageLoadTraceEnabled();
+    g_session_started = false;
+    g_pending_flags = 0;
+    memset(g_slot_frames, 0, sizeof(g_slot_frames));
+
+    // Scan slot headers to find the newest block
+    int newest_slot = -1;
+    uint32_t newest_sequence = 0;
+
+    File file = LittleFS.open(TRACE_FILE, "r");
+    if (file) {
+        for (uint8_t slot = 0; slot < TRACE_RING_BLOCKS; slot++) {
+            TraceBlockHeader header;
+            if (!file.seek(getSlotOffset(slot)) ||
+                file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+                break;  // End of file - remaining slots never written
+            }
+            if (!isValidHeader(header)) {
+                continue;
+            }
+            g_slot_frames[slot] = header.frame_count;
+            if (newest_slot < 0 || header.sequence > newest_sequence) {
+                newest_slot = slot;
+                newest_sequence = header.sequence;
+            }
+        }
+
+        // Newest block not full: reload it and keep filling the same slot
+        bool resumed = false;
+        if (newest_slot >= 0 && g_slot_frames[newest_slot] < TRACE_FRAMES_PER_BLOCK) {
+            if (file.seek(getSlotOffset(newest_slot)) &&
+                file.read((uint8_t*)&g_block, sizeof(g_block)) == sizeof(g_block)) {
+                g_write_slot = newest_slot;
+                g_block_dirty = false;
+                resumed = true;
+            }
+        }
+        file.close();
+
+        if (!resumed) {
+            if (newest_slot >= 0) {
+                startBlock((newest_slot + 1) % TRACE_RING_BLOCKS, newest_sequence + 1);
+            } else {
+                startBlock(0, 1);
+            }
+        }
+    } else {
+        startBlock(0, 1);
+    }
+
+    g_initialized = true;
+
+    if (g_enabled) {
+        Serial.printf("Trace: Recording ENABLED (%u frames stored)\n", traceRecorderGetFrameCount());
+    }
+    return true;
+}
+
+bool traceRecorderSetEnabled(bool enabled) {
+    if (!g_initialized) {
+        Serial.println("ERROR: Trace recorder not initialized");
+        return false;
+    }
+
+    if (!enabled && g_enabled) {
+        traceRecorderFlush();
+    }
+
+    g_enabled = enabled;
+    return storageSaveTraceEnabled(enabled);
+}
+
+bool traceRecorderIsEnabled() {
+    return g_initialized && g_enabled;
+}
+
+void traceRecorderNoteDrinkCheck(bool drink_recorded) {
+    g_pending_flags |= TRACE_FLAG_DRINK_CHECKED;
+    if (drink_recorded) {
+        g_pending_flags |= TRACE_FLAG_DRINK_RECORDED;
+    }
+}
+
+void traceRecorderRecord(uint32_t timestamp_ms, int32_t adc, GestureType gesture, uint8_t flags) {
+    if (!g_initialized || !g_enabled) {
+        g_pending_flags = 0;
+        return;
+    }
+
+    // Still holding a full block from a deferred hand-off - this frame is dropped
+    // (its flags carry over to the next one)
+    if (g_block.header.frame_count >= TRACE_FRAMES_PER_BLOCK && !handOffFullBlock(false)) {
+        g_pending_flags |= flags;
+        return;
+    }
+
+    TraceFrame& frame = g_block.frames[g_block.header.frame_count];
+
+    float x, y, z;
+    gesturesGetAccel(x, y, z);
+
+    DailyState state;
+    drinksGetState(state);
+
+    frame.timestamp_ms = timestamp_ms;
+    frame.adc = adc;
+    frame.baseline_adc = state.last_recorded_adc;
+    frame.accel_x = (int16_t)(x * 256.0f);
+    frame.accel_y = (int16_t)(y * 256.0f);
+    frame.accel_z = (int16_t)(z * 256.0f);
+    frame.gesture = (uint8_t)gesture;
+    frame.flags = flags | g_pending_flags;
+    if (gesturesIsStable()) {
+        frame.flags |= TRACE_FLAG_STABLE;
+    }
+    if (!g_session_started) {
+        frame.flags |= TRACE_FLAG_SESSION_START;
+        g_session_started = true;
+    }
+    g_pending_flags = 0;
+
+    g_block.header.frame_count++;
+    g_block_dirty = true;
+
+    // Block full: hand it to the storage task (previous hand-off normally long done)
+    if (g_block.header.frame_count >= TRACE_FRAMES_PER_BLOCK) {
+        handOffFullBlock(true);
+    }
+}
+
+bool traceRecorderFlush() {
+    if (!g_initialized) {
+        return true;
+    }
+
+    // A block write still in flight would race this one on the same file
+    if (!appTasksStorageSync(TRACE_SYNC_TIMEOUT_MS)) {
+        return false;
+    }
+    if (!g_block_dirty) {
+        return true;
+    }
+
+    if (!writeBlock(g_block, g_write_slot)) {
+        return false;
+    }
+    g_block_dirty = false;
+    return true;
+}
+
+bool traceRecorderClear() {
+    if (!g_initialized) {
+        Serial.println("ERROR: Trace recorder not initialized");
+        return false;
+    }
+
+    if (!appTasksStorageSync(TRACE_SYNC_TIMEOUT_MS)) {
+        return false;
+    }
+    if (LittleFS.exists(TRACE_FILE) && !LittleFS.remove(TRACE_FILE)) {
+        Serial.println("ERROR: Failed to remove trace file");
+        return false;
+    }
+
+    memset(g_slot_frames, 0, sizeof(g_slot_frames));
+    startBlock(0, 1);
+    g_session_started = false;
+    return true;
+}
+
+uint32_t traceRecorderGetFrameCount() {
+    if (!g_initialized) {
+        return 0;
+    }
+
+    uint32_t total = g_block.header.frame_count;
+    for (uint8_t slot = 0; slot < TRACE_RING_BLOCKS; slot++) {
+        if (slot != g_write_slot) {
+            total += g_slot_frames[slot];
+        }
+    }
+    return total;
+}
+
+uint16_t traceRecorderReadFrames(uint32_t first_frame, TraceFrame* out, uint16_t max_frames) {
+    if (!g_initialized || out == nullptr || max_frames == 0) {
+        return 0;
+    }
+
+    if (!appTasksStorageSync(TRACE_SYNC_TIMEOUT_MS)) {
+        return 0;
+    }
+
+    File file;
+    uint16_t copied = 0;
+    uint32_t skip = first_frame;
+
+    // Walk the ring oldest -> newest; the write slot (RAM) is always last
+    for (uint8_t i = 1; i <= TRACE_RING_BLOCKS && copied < max_frames; i++) {
+        uint8_t slot = (g_write_slot + i) % TRACE_RING_BLOCKS;
+        bool in_ram = (slot == g_write_slot);
+        uint16_t slot_frames = in_ram ? g_block.header.frame_count : g_slot_frames[slot];
+
+        if (skip >= slot_frames) {
+            skip -= slot_frames;
+            continue;
+        }
+
+        uint16_t start = (uint16_t)skip;
+        uint16_t count = min((uint16_t)(slot_frames - start), (uint16_t)(max_frames - copied));
+        skip = 0;
+
+        if (in_ram) {
+            memcpy(&out[copied], &g_block.frames[start], count * sizeof(TraceFrame));
+        } else {
+            if (!file) {
+                file = LittleFS.open(TRACE_FILE, "r");
+                if (!file) {
+                    Serial.println("ERROR: Failed to open trace file for reading");
+                    break;
+                }
+            }
+            size_t offset = getSlotOffset(slot) + sizeof(TraceBlockHeader) + start * sizeof(TraceFrame);
+            size_t bytes = count * sizeof(TraceFrame);
+            if (!file.seek(offset) || file.read((uint8_t*)&out[copied], bytes) != bytes) {
+                Serial.println("ERROR: Failed to read trace frames");
+                break;
+            }
+        }
+        copied += count;
+    }
+
+    if (file) {
+        file.close();
+    }
+    return copied;
+}
+
+#endif // ENABLE_TRACE_RECORDER
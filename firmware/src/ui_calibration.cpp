@@ -12,14 +12,20 @@
 #if defined(BOARD_ADAFRUIT_FEATHER)
 
 // Static variables
-static ThinkInk_213_Mono_GDEY0213B74* g_display = nullptr;
+static AquavateDisplay* g_display = nullptr;
 static bool g_initialized = false;
 
-void uiCalibrationInit(ThinkInk_213_Mono_GDEY0213B74& display) {
+void uiCalibrationInit(AquavateDisplay& display) {
     g_display = &display;
     g_initialized = true;
 }
 
+// Start a new screen once the display task has finished with the frame buffer
+static void clearScreen() {
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);
+    g_display->clearBuffer();
+}
+
 // Helper function to center text
 static void printCentered(const char* text, int y, int textSize) {
     if (!g_display) return;
@@ -49,7 +55,7 @@ void uiCalibrationShowStart() {
 
     Serial.println("UI: Showing calibration start screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Title
@@ -59,7 +65,7 @@ void uiCalibrationShowStart() {
     printLeft("empty bottle", 10, 60, 2);
     printLeft("completely", 10, 80, 2);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowStarted() {
@@ -67,14 +73,14 @@ void uiCalibrationShowStarted() {
 
     Serial.println("UI: Showing calibration started screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Large "Calibration / Started" text
     printCentered("calibration", 35, 3);
     printCentered("started", 70, 3);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowEmptyPrompt() {
@@ -82,7 +88,7 @@ void uiCalibrationShowEmptyPrompt() {
 
     Serial.println("UI: Showing empty bottle prompt");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Draw empty bottle graphic with "?" (40x90px bottle)
@@ -90,7 +96,7 @@ void uiCalibrationShowEmptyPrompt() {
     // Center vertically: (122 - 90) / 2 = 16
     drawBottleGraphic(105, 16, 0.0f, true);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowFullPrompt() {
@@ -98,7 +104,7 @@ void uiCalibrationShowFullPrompt() {
 
     Serial.println("UI: Showing full bottle prompt");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Draw full bottle graphic with "?" (40x90px bottle)
@@ -106,7 +112,7 @@ void uiCalibrationShowFullPrompt() {
     // Center vertically: (122 - 90) / 2 = 16
     drawBottleGraphic(105, 16, 1.0f, true);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowMeasuringEmpty() {
@@ -114,7 +120,7 @@ void uiCalibrationShowMeasuringEmpty() {
 
     Serial.println("UI: Showing measuring empty screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Title
@@ -124,7 +130,7 @@ void uiCalibrationShowMeasuringEmpty() {
     // Instructions
     printLeft("hold still", 10, 95, 1);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowEmptyConfirm(int32_t adc) {
@@ -142,7 +148,7 @@ void uiCalibrationShowFillBottle() {
 
     Serial.println("UI: Showing fill bottle screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Title
@@ -153,7 +159,7 @@ void uiCalibrationShowFillBottle() {
     printLeft("then place", 10, 80, 2);
     printLeft("upright", 10, 100, 2);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowMeasuringFull() {
@@ -161,7 +167,7 @@ void uiCalibrationShowMeasuringFull() {
 
     Serial.println("UI: Showing measuring full screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Title
@@ -171,7 +177,7 @@ void uiCalibrationShowMeasuringFull() {
     // Instructions
     printLeft("hold still", 10, 95, 1);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowFullConfirm(int32_t adc) {
@@ -190,14 +196,14 @@ void uiCalibrationShowComplete(float scale_factor) {
 
     Serial.println("UI: Showing calibration complete screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Large "calibration / complete" text (matches started screen)
     printCentered("calibration", 35, 3);
     printCentered("complete", 70, 3);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowError(const char* message) {
@@ -207,14 +213,14 @@ void uiCalibrationShowError(const char* message) {
     Serial.print("UI: Showing error screen: ");
     Serial.println(message);
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Large "calibration / error" text (matches started screen)
     printCentered("calibration", 35, 3);
     printCentered("error", 70, 3);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationShowAborted() {
@@ -222,14 +228,14 @@ void uiCalibrationShowAborted() {
 
     Serial.println("UI: Showing calibration aborted screen");
 
-    g_display->clearBuffer();
+    clearScreen();
     g_display->setTextColor(EPD_BLACK);
 
     // Large "calibration / aborted" text (matches started screen)
     printCentered("calibration", 35, 3);
     printCentered("aborted", 70, 3);
 
-    g_display->display(); // Full refresh
+    displayPushBuffer(*g_display); // Full refresh
 }
 
 void uiCalibrationUpdateForState(CalibrationState state, int32_t adc_value, float scale_factor) {
@@ -305,7 +311,7 @@ void uiCalibrationUpdateForState(CalibrationState state, int32_t adc_value, floa
 #if defined(BOARD_ADAFRUIT_FEATHER)
 
 // Helper function to center text (duplicate for non-calibration use)
-static void printCenteredBottleEmptied(ThinkInk_213_Mono_GDEY0213B74* display, const char* text, int y, int textSize) {
+static void printCenteredBottleEmptied(AquavateDisplay* display, const char* text, int y, int textSize) {
     if (!display) return;
 
     display->setTextSize(textSize);
@@ -319,9 +325,10 @@ static void printCenteredBottleEmptied(ThinkInk_213_Mono_GDEY0213B74* display, c
     display->print(text);
 }
 
-void uiShowBottleEmptied(ThinkInk_213_Mono_GDEY0213B74& display) {
+void uiShowBottleEmptied(AquavateDisplay& display) {
     Serial.println("UI: Showing bottle emptied screen");
 
+    displayWaitIdle(DISPLAY_IDLE_TIMEOUT_MS);
     display.clearBuffer();
     display.setTextColor(EPD_BLACK);
 
@@ -329,7 +336,7 @@ void uiShowBottleEmptied(ThinkInk_213_Mono_GDEY0213B74& display) {
     printCenteredBottleEmptied(&display, "bottle", 35, 3);
     printCenteredBottleEmptied(&display, "emptied", 70, 3);
 
-    display.display(); // Full refresh
+    displayPushBuffer(display); // Full refresh
 }
 
 #endif // BOARD_ADAFRUIT_FEATHER
@@ -0,0 +1,48 @@
+// ui_sequence.cpp - Non-blocking timed screen holds
+// Part of the Aquavate smart water bottle firmware
+
+#include "ui_sequence.h"
+
+static bool g_active = false;
+static uint32_t g_start_ms = 0;
+static uint32_t g_hold_ms = 0;
+static UiSequenceStep g_on_done = nullptr;
+
+void uiSequenceHold(uint32_t hold_ms, UiSequenceStep on_done) {
+    g_start_ms = millis();
+    g_hold_ms = hold_ms;
+    g_on_done = on_done;
+    g_active = true;
+}
+
+static void runStep() {
+    // Clear first - the step may start the next hold
+    UiSequenceStep step = g_on_done;
+    g_active = false;
+    g_on_done = nullptr;
+    if (step != nullptr) {
+        step();
+    }
+}
+
+void uiSequenceUpdate() {
+    if (!g_active || millis() - g_start_ms < g_hold_ms) {
+        return;
+    }
+    runStep();
+}
+
+bool uiSequenceActive() {
+    return g_active;
+}
+
+void uiSequenceCancel() {
+    g_active = false;
+    g_on_done = nullptr;
+}
+
+void uiSequenceFinish() {
+    if (g_active) {
+        runStep();
+    }
+}
@@ -0,0 +1,138 @@
+// wake_stub.cpp - Deep-sleep wake stub for routine backpack-mode timer wakes
+// Part of the Aquavate smart water bottle firmware
+//
+// Everything the stub touches must live in RTC memory: code is RTC_IRAM_ATTR,
+// state is RTC_DATA_ATTR, and only ROM functions may be called. All arithmetic
+// that needs the slow-clock calibration (64-bit division) is done in
+// wakeStubArm() while the app is still running.
+
+#include "wake_stub.h"
+
+#if ENABLE_WAKE_STUB && CONFIG_IDF_TARGET_ESP32
+
+#include <esp_sleep.h>
+#include <esp_attr.h>
+#include <soc/rtc.h>
+#include <soc/rtc_cntl_reg.h>
+#include <soc/uart_reg.h>
+#include <rom/ets_sys.h>
+
+#define WAKE_STUB_NO_ROLLOVER   0xFFFFFFFF
+
+// Low battery lockout flag (RTC variable from main.cpp)
+extern bool rtc_low_battery_lockout;
+
+RTC_DATA_ATTR static bool rtc_wake_stub_armed = false;
+RTC_DATA_ATTR static uint64_t rtc_wake_stub_sleep_ticks = 0;     // Timer interval in RTC slow-clock ticks
+RTC_DATA_ATTR static uint32_t rtc_wake_stub_interval_sec = 0;
+RTC_DATA_ATTR static uint32_t rtc_wake_stub_secs_to_rollover = WAKE_STUB_NO_ROLLOVER;
+RTC_DATA_ATTR static uint16_t rtc_wake_stub_ticks_left = 0;      // Stub-handled wakes before a full health check
+RTC_DATA_ATTR static uint16_t rtc_wake_stub_handled = 0;         // Wakes handled since last full boot
+
+// Program the RTC sleep timer relative to the current RTC time
+static void RTC_IRAM_ATTR wakeStubSetTimer(uint64_t ticks) {
+    SET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_UPDATE);
+    while (GET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_VALID) == 0) {
+        ets_delay_us(1);
+    }
+    SET_PERI_REG_MASK(RTC_CNTL_INT_CLR_REG, RTC_CNTL_TIME_VALID_INT_CLR);
+
+    uint64_t now = READ_PERI_REG(RTC_CNTL_TIME0_REG);
+    now |= ((uint64_t)READ_PERI_REG(RTC_CNTL_TIME1_REG)) << 32;
+
+    uint64_t target = now + ticks;
+    WRITE_PERI_REG(RTC_CNTL_SLP_TIMER0_REG, (uint32_t)(target & 0xFFFFFFFF));
+    WRITE_PERI_REG(RTC_CNTL_SLP_TIMER1_REG, (uint32_t)(target >> 32));
+}
+
+// Runs on every deep-sleep wake, before the app image is loaded.
+// Returning continues the normal boot.
+void RTC_IRAM_ATTR esp_wake_deep_sleep(void) {
+    esp_default_wake_deep_sleep();
+
+    if (!rtc_wake_stub_armed) {
+        return;
+    }
+
+    // Tap wake (EXT0) or anything other than the timer: full boot
+    uint32_t cause = REG_GET_FIELD(RTC_CNTL_WAKEUP_STATE_REG, RTC_CNTL_WAKEUP_CAUSE);
+    if (!(cause & RTC_TIMER_TRIG_EN)) {
+        return;
+    }
+
+    if (rtc_low_battery_lockout) {
+        return;
+    }
+
+    // Rollover due by the next wake - boot now so the daily reset is handled
+    if (rtc_wake_stub_secs_to_rollover != WAKE_STUB_NO_ROLLOVER) {
+        if (rtc_wake_stub_secs_to_rollover <= rtc_wake_stub_interval_sec) {
+            return;
+        }
+        rtc_wake_stub_secs_to_rollover -= rtc_wake_stub_interval_sec;
+    }
+
+    // Full health check due
+    if (rtc_wake_stub_ticks_left == 0) {
+        return;
+    }
+    rtc_wake_stub_ticks_left--;
+    rtc_wake_stub_handled++;
+
+    // Back to sleep with the same wake sources (timer + EXT0 tap are still configured)
+    wakeStubSetTimer(rtc_wake_stub_sleep_ticks);
+
+    // Let the ROM UART drain before power-down
+    while (REG_GET_FIELD(UART_STATUS_REG(0), UART_ST_UTX_OUT)) {
+    }
+
+    REG_WRITE(RTC_ENTRY_ADDR_REG, (uint32_t)&esp_wake_deep_sleep);
+    CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+    SET_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+    while (true) {
+        // Sleep starts within a few cycles
+    }
+}
+
+void wakeStubArm(uint32_t interval_sec, uint32_t seconds_until_rollover) {
+    // Slow clock period in microseconds, Q13.19 fixed point (same value esp_sleep uses)
+    uint32_t cal = REG_READ(RTC_SLOW_CLK_CAL_REG);
+    if (cal == 0 || interval_sec == 0) {
+        rtc_wake_stub_armed = false;
+        return;
+    }
+
+    uint64_t interval_us = (uint64_t)interval_sec * 1000000ULL;
+    rtc_wake_stub_sleep_ticks = (interval_us << RTC_CLK_CAL_FRACT) / cal;
+    rtc_wake_stub_interval_sec = interval_sec;
+    rtc_wake_stub_secs_to_rollover = (seconds_until_rollover > 0)
+                                     ? seconds_until_rollover : WAKE_STUB_NO_ROLLOVER;
+
+    // e.g. 8h full-boot interval / 2h timer = 3 stub wakes, then the 4th boots
+    uint32_t wakes_per_full_boot = BACKPACK_FULL_BOOT_INTERVAL_SEC / interval_sec;
+    rtc_wake_stub_ticks_left = (wakes_per_full_boot > 1) ? (uint16_t)(wakes_per_full_boot - 1) : 0;
+
+    rtc_wake_stub_armed = true;
+    Serial.printf("Wake stub: armed (%u stub wakes before health check, rollover in %us)\n",
+                  rtc_wake_stub_ticks_left, seconds_until_rollover);
+}
+
+uint16_t wakeStubDisarm() {
+    uint16_t handled = rtc_wake_stub_armed ? rtc_wake_stub_handled : 0;
+    rtc_wake_stub_armed = false;
+    rtc_wake_stub_handled = 0;
+    return handled;
+}
+
+#else
+
+void wakeStubArm(uint32_t interval_sec, uint32_t seconds_until_rollover) {
+    (void)interval_sec;
+    (void)seconds_until_rollover;
+}
+
+uint16_t wakeStubDisarm() {
+    return 0;
+}
+
+#endif // ENABLE_WAKE_STUB && CONFIG_IDF_TARGET_ESP32
@@ -5,6 +5,7 @@
 
 #include "weight.h"
 #include "config.h"
+#include "app_tasks.h"
 #include <math.h>
 
 // Static variables
@@ -25,7 +26,10 @@ WeightConfig weightGetDefaultConfig() {
     return config;
 }
 
+// Direct NAU7802 reads pause the sensor task (app_tasks.h) so they don't take its conversions
+
 int32_t weightReadRaw() {
+    SensorPauseScope pause;
     if (!g_initialized || !g_nau || !g_nau->available()) {
         return 0;
     }
@@ -33,6 +37,7 @@ int32_t weightReadRaw() {
 }
 
 bool weightIsReady() {
+    SensorPauseScope pause;
     return g_initialized && g_nau && g_nau->available();
 }
 
@@ -139,7 +144,8 @@ WeightMeasurement weightMeasureStable(const WeightConfig& config) {
     unsigned long start_time = millis();
     unsigned long duration_ms = config.duration_seconds * 1000;
 
-    // Collect samples for specified duration
+    // Collect samples for specified duration (every conversion, none lost to the sensor task)
+    SensorPauseScope pause;
     while (millis() - start_time < duration_ms) {
         if (g_nau->available()) {
             int32_t reading = g_nau->read();
@@ -0,0 +1,171 @@
+/**
+ * Aquavate - Native Placement Wake Check HAL
+ * Virtual clock, Serial sink and a register-level ADXL343 model covering what
+ * the placement wake uses (ADXL343 datasheet, "Link bit" and "ACT_INACT_CTL").
+ */
+
+#include "wake_hal.h"
+#include "config.h"
+#include <math.h>
+
+// ==================== Firmware globals (normally in main.cpp) ====================
+
+bool g_debug_enabled = false;
+bool g_debug_accelerometer = false;
+
+ReplaySerial Serial;
+
+// ==================== Simulated ADXL343 ====================
+
+#define SIM_SAMPLE_MS       10      // BW_RATE power-on default: 100 Hz
+
+#define REG_THRESH_ACT      0x24
+#define REG_THRESH_INACT    0x25
+#define REG_TIME_INACT      0x26
+#define REG_ACT_INACT_CTL   0x27
+#define REG_POWER_CTL       0x2D
+#define REG_INT_ENABLE      0x2E
+#define REG_INT_MAP         0x2F
+#define REG_INT_SOURCE      0x30
+
+#define INT_ACTIVITY        0x10
+#define INT_INACTIVITY      0x08
+#define POWER_LINK          0x20
+#define POWER_MEASURE       0x08
+
+enum LinkState {
+    LINK_SEARCH_INACTIVITY,
+    LINK_SEARCH_ACTIVITY
+};
+
+static uint8_t g_regs[64];
+static LinkState g_link_state = LINK_SEARCH_INACTIVITY;
+static uint32_t g_inact_ms = 0;
+static float g_act_ref[3];
+static float g_inact_ref[3];
+static bool g_refs_valid = false;
+static MotionProfile g_profile;
+
+static uint32_t g_millis = 0;
+static uint32_t g_next_sample_ms = SIM_SAMPLE_MS;
+
+static void sampleAxes(float out[3]) {
+    Accel a = g_profile(g_millis);
+    out[0] = a.x;
+    out[1] = a.y;
+    out[2] = a.z;
+}
+
+// Axis masks are X/Y/Z = bits 2/1/0 of each ACT_INACT_CTL nibble
+static bool anyAbove(const float a[3], const float ref[3], uint8_t axes, bool ac, float thresh_g) {
+    for (int i = 0; i < 3; i++) {
+        if ((axes & (0x04 >> i)) && fabsf(ac ? a[i] - ref[i] : a[i]) > thresh_g) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void runDetectors() {
+    if (!(g_regs[REG_POWER_CTL] & POWER_MEASURE)) {
+        return;
+    }
+
+    float a[3];
+    sampleAxes(a);
+    if (!g_refs_valid) {
+        memcpy(g_act_ref, a, sizeof(a));
+        memcpy(g_inact_ref, a, sizeof(a));
+        g_refs_valid = true;
+    }
+
+    uint8_t ctl = g_regs[REG_ACT_INACT_CTL];
+    uint8_t enable = g_regs[REG_INT_ENABLE];
+    bool link = (g_regs[REG_POWER_CTL] & POWER_LINK) != 0 &&
+                (enable & (INT_ACTIVITY | INT_INACTIVITY)) == (INT_ACTIVITY | INT_INACTIVITY);
+
+    if ((enable & INT_INACTIVITY) && (!link || g_link_state == LINK_SEARCH_INACTIVITY)) {
+        bool ac = (ctl & 0x08) != 0;
+        if (anyAbove(a, g_inact_ref, ctl & 0x07, ac, g_regs[REG_THRESH_INACT] * 0.0625f)) {
+            g_inact_ms = 0;
+            memcpy(g_inact_ref, a, sizeof(a));  // AC-coupled reference follows the motion
+        } else {
+            g_inact_ms += SIM_SAMPLE_MS;
+        }
+        if (g_inact_ms >= g_regs[REG_TIME_INACT] * 1000u) {
+            g_regs[REG_INT_SOURCE] |= INT_INACTIVITY;
+            g_inact_ms = 0;
+            if (link) {
+                g_link_state = LINK_SEARCH_ACTIVITY;
+                memcpy(g_act_ref, a, sizeof(a));
+            }
+        }
+    }
+
+    if ((enable & INT_ACTIVITY) && (!link || g_link_state == LINK_SEARCH_ACTIVITY)) {
+        bool ac = (ctl & 0x80) != 0;
+        if (anyAbove(a, g_act_ref, (ctl >> 4) & 0x07, ac, g_regs[REG_THRESH_ACT] * 0.0625f)) {
+            g_regs[REG_INT_SOURCE] |= INT_ACTIVITY;
+            if (link) {
+                g_link_state = LINK_SEARCH_INACTIVITY;
+                g_inact_ms = 0;
+                memcpy(g_inact_ref, a, sizeof(a));
+            }
+        }
+    }
+}
+
+void wakeSimReset(MotionProfile profile) {
+    memset(g_regs, 0, sizeof(g_regs));
+    g_regs[0x2C] = 0x0A;  // BW_RATE
+    g_link_state = LINK_SEARCH_INACTIVITY;
+    g_inact_ms = 0;
+    g_refs_valid = false;
+    g_profile = profile;
+    g_millis = 0;
+    g_next_sample_ms = SIM_SAMPLE_MS;
+}
+
+bool wakeSimInt1() {
+    return (g_regs[REG_INT_SOURCE] & g_regs[REG_INT_ENABLE] & ~g_regs[REG_INT_MAP]) != 0;
+}
+
+void writeAccelReg(uint8_t reg, uint8_t value) {
+    if (reg == REG_POWER_CTL && !(g_regs[reg] & POWER_MEASURE) && (value & POWER_MEASURE)) {
+        // Entering measurement restarts the detectors (link mode: inactivity first)
+        g_link_state = LINK_SEARCH_INACTIVITY;
+        g_inact_ms = 0;
+        g_refs_valid = false;
+    }
+    if (reg != REG_INT_SOURCE) {
+        g_regs[reg & 0x3F] = value;
+    }
+}
+
+uint8_t readAccelReg(uint8_t reg) {
+    uint8_t value = g_regs[reg & 0x3F];
+    if (reg == REG_INT_SOURCE) {
+        g_regs[reg] &= ~(INT_ACTIVITY | INT_INACTIVITY);  // Cleared by the read
+    }
+    return value;
+}
+
+// ==================== Virtual clock ====================
+
+uint32_t millis() {
+    return g_millis;
+}
+
+uint32_t micros() {
+    return g_millis * 1000;
+}
+
+void delay(uint32_t ms) {
+    uint32_t end = g_millis + ms;
+    while (g_next_sample_ms <= end) {
+        g_millis = g_next_sample_ms;
+        runDetectors();
+        g_next_sample_ms += SIM_SAMPLE_MS;
+    }
+    g_millis = end;
+}
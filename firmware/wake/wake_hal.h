@@ -0,0 +1,28 @@
+/**
+ * Aquavate - Native Placement Wake Check HAL
+ * Simulated ADXL343 (activity/inactivity detectors, link mode, INT1/INT2
+ * routing) behind the firmware's writeAccelReg()/readAccelReg(), driven by a
+ * virtual clock: every delay() runs the detectors at the 100 Hz output rate.
+ */
+
+#ifndef WAKE_HAL_H
+#define WAKE_HAL_H
+
+#include <Arduino.h>
+#include <functional>
+
+// Acceleration in g, as a function of virtual time (ms)
+struct Accel {
+    float x;
+    float y;
+    float z;
+};
+typedef std::function<Accel(uint32_t ms)> MotionProfile;
+
+// Power-on reset of the simulated chip and the virtual clock
+void wakeSimReset(MotionProfile profile);
+
+// INT1 level (the EXT0 wake pin)
+bool wakeSimInt1();
+
+#endif // WAKE_HAL_H
@@ -0,0 +1,152 @@
+/**
+ * Aquavate - Native Placement Wake Check
+ *
+ * Runs the real placement_wake.cpp arming sequence against a simulated ADXL343
+ * (wake/wake_hal.cpp) and then "sleeps" through a motion profile, watching the
+ * INT1 wake pin. Each case states whether - and when - the bottle must wake:
+ * a bottle left standing still must stay asleep, and one that is picked up and
+ * set back down must wake PLACEMENT_INACT_TIME after it is put down.
+ *
+ * Build & run (from firmware/):
+ *   pio run -e native_wake
+ *   .pio/build/native_wake/program [--verbose]
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <string>
+#include "wake_hal.h"
+#include "config.h"
+#include "placement_wake.h"
+
+#define SLEEP_STEP_MS       10
+#define WAKE_LATENCY_MS     100     // Allowed beyond PLACEMENT_INACT_TIME after set-down
+#define NO_WAKE             UINT32_MAX
+
+struct WakeCase {
+    const char* name;
+    MotionProfile profile;
+    uint32_t sleep_ms;          // How long to stay in (simulated) deep sleep
+    bool expect_armed;          // Initial inactivity taken before sleep
+    uint32_t set_down_ms;       // Wake expected PLACEMENT_INACT_TIME after this (NO_WAKE = stay asleep)
+};
+
+// Small deterministic sensor noise, well under the inactivity threshold
+static float noise(uint32_t ms, uint32_t seed) {
+    return 0.02f * sinf((float)(ms + seed * 37) * 0.013f);
+}
+
+static Accel upright(uint32_t ms) {
+    return { noise(ms, 1), 1.0f + noise(ms, 2), noise(ms, 3) };
+}
+
+static Accel onSide(uint32_t ms) {
+    return { 1.0f + noise(ms, 1), noise(ms, 2), noise(ms, 3) };
+}
+
+// In hand: swaying, X/Z well outside the upright window
+static Accel carried(uint32_t ms) {
+    float phase = (float)ms * 0.004f;
+    return { 0.5f * sinf(phase), 0.8f, 0.4f * cosf(phase) };
+}
+
+// Tipped to pour - Y swings past horizontal (> ACTIVITY_WAKE_THRESHOLD from upright)
+static Accel pouring(uint32_t ms) {
+    return { 0.7f + noise(ms, 1), -0.7f + noise(ms, 2), noise(ms, 3) };
+}
+
+static bool runCase(const WakeCase& c) {
+    wakeSimReset(c.profile);
+    bool armed = placementWakeArm();
+    uint32_t sleep_start = millis();
+
+    uint32_t wake_ms = NO_WAKE;
+    while (millis() - sleep_start < c.sleep_ms) {
+        if (wakeSimInt1()) {
+            wake_ms = millis();
+            break;
+        }
+        delay(SLEEP_STEP_MS);
+    }
+
+    bool ok = armed == c.expect_armed;
+    std::string expected = "stay asleep";
+    if (c.set_down_ms == NO_WAKE) {
+        ok = ok && wake_ms == NO_WAKE;
+    } else {
+        uint32_t earliest = c.set_down_ms + PLACEMENT_INACT_TIME * 1000;
+        ok = ok && wake_ms != NO_WAKE && wake_ms + SLEEP_STEP_MS >= earliest &&
+             wake_ms <= earliest + WAKE_LATENCY_MS;
+        char buf[48];
+        snprintf(buf, sizeof(buf), "wake at %.1fs", earliest / 1000.0f);
+        expected = buf;
+    }
+
+    char woke[32];
+    if (wake_ms == NO_WAKE) {
+        snprintf(woke, sizeof(woke), "asleep");
+    } else {
+        snprintf(woke, sizeof(woke), "woke at %.2fs", wake_ms / 1000.0f);
+    }
+    printf("%-28s armed=%-3s %-16s (expected %s) - %s\n", c.name, armed ? "yes" : "no", woke,
+           expected.c_str(), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") {
+            Serial.enabled = true;
+            g_debug_enabled = true;
+            g_debug_accelerometer = true;
+        } else {
+            fprintf(stderr, "usage: %s [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const uint32_t HOUR_MS = 3600UL * 1000;
+    const WakeCase cases[] = {
+        // Went to sleep standing still and nobody touches it
+        { "still upright", upright, HOUR_MS, true, NO_WAKE },
+
+        // Lying on its side: never upright, never wakes
+        { "still on side", onSide, HOUR_MS, false, NO_WAKE },
+
+        // Standing for 10 min, picked up and poured, held, set back down
+        { "pickup, pour, set down",
+          [](uint32_t ms) {
+              if (ms < 600000) return upright(ms);
+              if (ms < 605000) return pouring(ms);
+              if (ms < 615000) return carried(ms);
+              return upright(ms);
+          },
+          HOUR_MS, true, 615000 },
+
+        // Picked up and carried about without a pour-sized jolt: no wake
+        { "gentle handling",
+          [](uint32_t ms) {
+              if (ms >= 600000 && ms < 620000) return carried(ms);
+              return upright(ms);
+          },
+          HOUR_MS, true, NO_WAKE },
+
+        // Still being carried when sleep starts, set down at 10 s
+        { "carried into sleep",
+          [](uint32_t ms) { return ms < 10000 ? carried(ms) : upright(ms); },
+          HOUR_MS, false, 10000 },
+    };
+
+    int failures = 0;
+    for (const WakeCase& c : cases) {
+        if (!runCase(c)) {
+            failures++;
+        }
+    }
+
+    if (failures) {
+        printf("\n%d FAILURE(S)\n", failures);
+    }
+    return failures ? 1 : 0;
+}